@@ -1050,6 +1050,73 @@ void polyz_unpack(poly * restrict r, const uint8_t *a) {
 }
 #endif
 
+/*************************************************
+* Name:        polyz_packed_chknorm
+*
+* Description: Check infinity norm of a bit-packed polynomial z directly
+*              on the packed bytes, without unpacking it.
+*              Reads up to 14 bytes past the end of the packed polynomial.
+*
+* Arguments:   - const uint8_t *a: byte array with bit-packed polynomial
+*              - int32_t B: norm bound
+*
+* Returns 0 if norm is strictly smaller than B and 1 otherwise.
+**************************************************/
+#if GAMMA1 == (1 << 17)
+int polyz_packed_chknorm(const uint8_t *a, int32_t B) {
+  unsigned int i;
+  __m256i f, bad;
+  const __m256i shufbidx = _mm256_set_epi8(-1, 9, 8, 7,-1, 7, 6, 5,-1, 5, 4, 3,-1, 3, 2, 1,
+                                           -1, 8, 7, 6,-1, 6, 5, 4,-1, 4, 3, 2,-1, 2, 1, 0);
+  const __m256i srlvdidx = _mm256_set_epi32(6,4,2,0,6,4,2,0);
+  const __m256i mask = _mm256_set1_epi32(0x3FFFF);
+  const __m256i lo = _mm256_set1_epi32(GAMMA1 - B + 1);
+  const __m256i hi = _mm256_set1_epi32(GAMMA1 + B - 1);
+  DBENCH_START();
+
+  bad = _mm256_setzero_si256();
+  for(i = 0; i < N/8; i++) {
+    f = _mm256_loadu_si256((__m256i *)&a[18*i]);
+    f = _mm256_permute4x64_epi64(f,0x94);
+    f = _mm256_shuffle_epi8(f,shufbidx);
+    f = _mm256_srlv_epi32(f,srlvdidx);
+    f = _mm256_and_si256(f,mask);
+    bad = _mm256_or_si256(bad,_mm256_cmpgt_epi32(lo,f));
+    bad = _mm256_or_si256(bad,_mm256_cmpgt_epi32(f,hi));
+  }
+
+  DBENCH_STOP(*tpack);
+  return !_mm256_testz_si256(bad,bad);
+}
+
+#elif GAMMA1 == (1 << 19)
+int polyz_packed_chknorm(const uint8_t *a, int32_t B) {
+  unsigned int i;
+  __m256i f, bad;
+  const __m256i shufbidx = _mm256_set_epi8(-1,11,10, 9,-1, 9, 8, 7,-1, 6, 5, 4,-1, 4, 3, 2,
+                                           -1, 9, 8, 7,-1, 7, 6, 5,-1, 4, 3, 2,-1, 2, 1, 0);
+  const __m256i srlvdidx = _mm256_set1_epi64x((uint64_t)4 << 32);
+  const __m256i mask = _mm256_set1_epi32(0xFFFFF);
+  const __m256i lo = _mm256_set1_epi32(GAMMA1 - B + 1);
+  const __m256i hi = _mm256_set1_epi32(GAMMA1 + B - 1);
+  DBENCH_START();
+
+  bad = _mm256_setzero_si256();
+  for(i = 0; i < N/8; i++) {
+    f = _mm256_loadu_si256((__m256i *)&a[20*i]);
+    f = _mm256_permute4x64_epi64(f,0x94);
+    f = _mm256_shuffle_epi8(f,shufbidx);
+    f = _mm256_srlv_epi32(f,srlvdidx);
+    f = _mm256_and_si256(f,mask);
+    bad = _mm256_or_si256(bad,_mm256_cmpgt_epi32(lo,f));
+    bad = _mm256_or_si256(bad,_mm256_cmpgt_epi32(f,hi));
+  }
+
+  DBENCH_STOP(*tpack);
+  return !_mm256_testz_si256(bad,bad);
+}
+#endif
+
 /*************************************************
 * Name:        polyw1_pack
 *
@@ -105,6 +105,8 @@ void polyt0_unpack(poly *r, const uint8_t a[POLYT0_PACKEDBYTES]);
 void polyz_pack(uint8_t r[POLYZ_PACKEDBYTES], const poly *a);
 #define polyz_unpack DILITHIUM_NAMESPACE(polyz_unpack)
 void polyz_unpack(poly *r, const uint8_t *a);
+#define polyz_packed_chknorm DILITHIUM_NAMESPACE(polyz_packed_chknorm)
+int polyz_packed_chknorm(const uint8_t *a, int32_t B);
 
 #define polyw1_pack DILITHIUM_NAMESPACE(polyw1_pack)
 void polyw1_pack(uint8_t *r, const poly *a);
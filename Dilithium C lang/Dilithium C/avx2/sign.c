@@ -52,117 +52,28 @@ static inline void polyvec_matrix_expand_row(polyvecl **row, polyvecl buf[2], co
 }
 
 /*************************************************
-* Name:        crypto_sign_keypair
-*
-* Description: Generates public and private key.
-*
-* Arguments:   - uint8_t *pk: pointer to output public key (allocated
-*                             array of CRYPTO_PUBLICKEYBYTES bytes)
-*              - uint8_t *sk: pointer to output private key (allocated
-*                             array of CRYPTO_SECRETKEYBYTES bytes)
-*
-* Returns 0 (success)
-**************************************************/
-int crypto_sign_keypair(uint8_t *pk, uint8_t *sk) {
-  unsigned int i;
-  uint8_t seedbuf[2*SEEDBYTES + CRHBYTES];
-  const uint8_t *rho, *rhoprime, *key;
-  polyvecl rowbuf[2];
-  polyvecl s1, *row = rowbuf;
-  polyveck s2;
-  poly t1, t0;
-
-  /* Get randomness for rho, rhoprime and key */
-  randombytes(seedbuf, SEEDBYTES);
-  seedbuf[SEEDBYTES+0] = K;
-  seedbuf[SEEDBYTES+1] = L;
-  shake256(seedbuf, 2*SEEDBYTES + CRHBYTES, seedbuf, SEEDBYTES+2);
-  rho = seedbuf;
-  rhoprime = rho + SEEDBYTES;
-  key = rhoprime + CRHBYTES;
-
-  /* Store rho, key */
-  memcpy(pk, rho, SEEDBYTES);
-  memcpy(sk, rho, SEEDBYTES);
-  memcpy(sk + SEEDBYTES, key, SEEDBYTES);
-
-  /* Sample short vectors s1 and s2 */
-#if K == 4 && L == 4
-  poly_uniform_eta_4x(&s1.vec[0], &s1.vec[1], &s1.vec[2], &s1.vec[3], rhoprime, 0, 1, 2, 3);
-  poly_uniform_eta_4x(&s2.vec[0], &s2.vec[1], &s2.vec[2], &s2.vec[3], rhoprime, 4, 5, 6, 7);
-#elif K == 6 && L == 5
-  poly_uniform_eta_4x(&s1.vec[0], &s1.vec[1], &s1.vec[2], &s1.vec[3], rhoprime, 0, 1, 2, 3);
-  poly_uniform_eta_4x(&s1.vec[4], &s2.vec[0], &s2.vec[1], &s2.vec[2], rhoprime, 4, 5, 6, 7);
-  poly_uniform_eta_4x(&s2.vec[3], &s2.vec[4], &s2.vec[5], &t0, rhoprime, 8, 9, 10, 11);
-#elif K == 8 && L == 7
-  poly_uniform_eta_4x(&s1.vec[0], &s1.vec[1], &s1.vec[2], &s1.vec[3], rhoprime, 0, 1, 2, 3);
-  poly_uniform_eta_4x(&s1.vec[4], &s1.vec[5], &s1.vec[6], &s2.vec[0], rhoprime, 4, 5, 6, 7);
-  poly_uniform_eta_4x(&s2.vec[1], &s2.vec[2], &s2.vec[3], &s2.vec[4], rhoprime, 8, 9, 10, 11);
-  poly_uniform_eta_4x(&s2.vec[5], &s2.vec[6], &s2.vec[7], &t0, rhoprime, 12, 13, 14, 15);
-#else
-#error
-#endif
-
-  /* Pack secret vectors */
-  for(i = 0; i < L; i++)
-    polyeta_pack(sk + 2*SEEDBYTES + TRBYTES + i*POLYETA_PACKEDBYTES, &s1.vec[i]);
-  for(i = 0; i < K; i++)
-    polyeta_pack(sk + 2*SEEDBYTES + TRBYTES + (L + i)*POLYETA_PACKEDBYTES, &s2.vec[i]);
-
-  /* Transform s1 */
-  polyvecl_ntt(&s1);
-
-  for(i = 0; i < K; i++) {
-    /* Expand matrix row */
-    polyvec_matrix_expand_row(&row, rowbuf, rho, i);
-
-    /* Compute inner-product */
-    polyvecl_pointwise_acc_montgomery(&t1, row, &s1);
-    poly_invntt_tomont(&t1);
-
-    /* Add error polynomial */
-    poly_add(&t1, &t1, &s2.vec[i]);
-
-    /* Round t and pack t1, t0 */
-    poly_caddq(&t1);
-    poly_power2round(&t1, &t0, &t1);
-    polyt1_pack(pk + SEEDBYTES + i*POLYT1_PACKEDBYTES, &t1);
-    polyt0_pack(sk + 2*SEEDBYTES + TRBYTES + (L+K)*POLYETA_PACKEDBYTES + i*POLYT0_PACKEDBYTES, &t0);
-  }
-
-  /* Compute H(rho, t1) and store in secret key */
-  shake256(sk + 2*SEEDBYTES, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
-
-  return 0;
-}
-
-/*************************************************
-* Name:        crypto_sign_signature_internal
+* Name:        sign_expanded
 *
-* Description: Computes signature. Internal API.
+* Description: Rejection-sampling loop of the signing algorithm, on a key
+*              whose matrix and secret vectors are already expanded.
 *
 * Arguments:   - uint8_t *sig: pointer to output signature (of length CRYPTO_BYTES)
-*              - size_t *siglen: pointer to output length of signature
-*              - uint8_t *m: pointer to message to be signed
-*              - size_t mlen: length of message
-*              - uint8_t *pre: pointer to prefix string
-*              - size_t prelen: length of prefix string
-*              - uint8_t *rnd: pointer to random seed
-*              - uint8_t *sk: pointer to bit-packed secret key
-*
-* Returns 0 (success)
+*              - const uint8_t *mu: pointer to message representative
+*              - const uint8_t *rhoprime: pointer to CRH(key, rnd, mu)
+*              - const polyvecl mat[K]: expanded matrix A
+*              - const polyvecl *s1: s1 in NTT domain
+*              - const polyveck *s2: s2 in NTT domain
+*              - const polyveck *t0: t0 in NTT domain
 **************************************************/
-int crypto_sign_signature_internal(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen,
-                                   const uint8_t *pre, size_t prelen, const uint8_t rnd[RNDBYTES], const uint8_t *sk)
+static void sign_expanded(uint8_t *sig, const uint8_t mu[CRHBYTES], const uint8_t rhoprime[CRHBYTES],
+                          const polyvecl mat[K], const polyvecl *s1, const polyveck *s2, const polyveck *t0)
 {
   unsigned int i, n, pos;
-  uint8_t seedbuf[2*SEEDBYTES + TRBYTES + 2*CRHBYTES];
-  uint8_t *rho, *tr, *key, *mu, *rhoprime;
   uint8_t hintbuf[N];
   uint8_t *hint = sig + CTILDEBYTES + L*POLYZ_PACKEDBYTES;
   uint64_t nonce = 0;
-  polyvecl mat[K], s1, z;
-  polyveck t0, s2, w1;
+  polyvecl z;
+  polyveck w1;
   poly c, tmp;
   union {
     polyvecl y;
@@ -170,35 +81,6 @@ int crypto_sign_signature_internal(uint8_t *sig, size_t *siglen, const uint8_t *
   } tmpv;
   keccak_state state;
 
-  rho = seedbuf;
-  tr = rho + SEEDBYTES;
-  key = tr + TRBYTES;
-  mu = key + SEEDBYTES;
-  rhoprime = mu + CRHBYTES;
-  unpack_sk(rho, tr, key, &t0, &s1, &s2, sk);
-
-  /* Compute mu = CRH(tr, pre, msg) */
-  shake256_init(&state);
-  shake256_absorb(&state, tr, TRBYTES);
-  shake256_absorb(&state, pre, prelen);
-  shake256_absorb(&state, m, mlen);
-  shake256_finalize(&state);
-  shake256_squeeze(mu, CRHBYTES, &state);
-
-  /* Compute rhoprime = CRH(key, rnd, mu) */
-  shake256_init(&state);
-  shake256_absorb(&state, key, SEEDBYTES);
-  shake256_absorb(&state, rnd, RNDBYTES);
-  shake256_absorb(&state, mu, CRHBYTES);
-  shake256_finalize(&state);
-  shake256_squeeze(rhoprime, CRHBYTES, &state);
-
-  /* Expand matrix and transform vectors */
-  polyvec_matrix_expand(mat, rho);
-  polyvecl_ntt(&s1);
-  polyveck_ntt(&s2);
-  polyveck_ntt(&t0);
-
 rej:
   /* Sample intermediate vector y */
 #if L == 4
@@ -241,7 +123,7 @@ rej:
 
   /* Compute z, reject if it reveals secret */
   for(i = 0; i < L; i++) {
-    poly_pointwise_montgomery(&tmp, &c, &s1.vec[i]);
+    poly_pointwise_montgomery(&tmp, &c, &s1->vec[i]);
     poly_invntt_tomont(&tmp);
     poly_add(&z.vec[i], &z.vec[i], &tmp);
     poly_reduce(&z.vec[i]);
@@ -256,7 +138,7 @@ rej:
   for(i = 0; i < K; i++) {
     /* Check that subtracting cs2 does not change high bits of w and low bits
      * do not reveal secret information */
-    poly_pointwise_montgomery(&tmp, &c, &s2.vec[i]);
+    poly_pointwise_montgomery(&tmp, &c, &s2->vec[i]);
     poly_invntt_tomont(&tmp);
     poly_sub(&tmpv.w0.vec[i], &tmpv.w0.vec[i], &tmp);
     poly_reduce(&tmpv.w0.vec[i]);
@@ -264,7 +146,7 @@ rej:
       goto rej;
 
     /* Compute hints */
-    poly_pointwise_montgomery(&tmp, &c, &t0.vec[i]);
+    poly_pointwise_montgomery(&tmp, &c, &t0->vec[i]);
     poly_invntt_tomont(&tmp);
     poly_reduce(&tmp);
     if(poly_chknorm(&tmp, GAMMA2))
@@ -283,134 +165,54 @@ rej:
   /* Pack z into signature */
   for(i = 0; i < L; i++)
     polyz_pack(sig + CTILDEBYTES + i*POLYZ_PACKEDBYTES, &z.vec[i]);
-
-  *siglen = CRYPTO_BYTES;
-  return 0;
-}
-
-/*************************************************
-* Name:        crypto_sign_signature
-*
-* Description: Computes signature.
-*
-* Arguments:   - uint8_t *sig: pointer to output signature (of length CRYPTO_BYTES)
-*              - size_t *siglen: pointer to output length of signature
-*              - uint8_t *m: pointer to message to be signed
-*              - size_t mlen: length of message
-*              - uint8_t *ctx: pointer to context string
-*              - size_t ctxlen: length of context string
-*              - uint8_t *sk: pointer to bit-packed secret key
-*
-* Returns 0 (success) or -1 (context string too long)
-**************************************************/
-int crypto_sign_signature(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen,
-                          const uint8_t *ctx, size_t ctxlen, const uint8_t *sk)
-{
-  uint8_t pre[257];
-  uint8_t rnd[RNDBYTES];
-
-  if(ctxlen > 255)
-    return -1;
-
-  /* Prepare pre = (0, ctxlen, ctx) */
-  pre[0] = 0;
-  pre[1] = ctxlen;
-  memcpy(&pre[2], ctx, ctxlen);
-
-#ifdef DILITHIUM_RANDOMIZED_SIGNING
-  randombytes(rnd, RNDBYTES);
-#else
-  memset(rnd, 0, RNDBYTES);
-#endif
-
-  crypto_sign_signature_internal(sig,siglen,m,mlen,pre,2+ctxlen,rnd,sk);
-  return 0;
-}
-
-/*************************************************
-* Name:        crypto_sign
-*
-* Description: Compute signed message.
-*
-* Arguments:   - uint8_t *sm: pointer to output signed message (allocated
-*                             array with CRYPTO_BYTES + mlen bytes),
-*                             can be equal to m
-*              - size_t *smlen: pointer to output length of signed
-*                               message
-*              - const uint8_t *m: pointer to message to be signed
-*              - size_t mlen: length of message
-*              - const uint8_t *ctx: pointer to context string
-*              - size_t ctxlen: length of context string
-*              - const uint8_t *sk: pointer to bit-packed secret key
-*
-* Returns 0 (success)
-**************************************************/
-int crypto_sign(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t mlen, const uint8_t *ctx, size_t ctxlen,
-                const uint8_t *sk)
-{
-  size_t i;
-  int ret;
-
-  for(i = 0; i < mlen; ++i)
-    sm[CRYPTO_BYTES + mlen - 1 - i] = m[mlen - 1 - i];
-  ret = crypto_sign_signature(sm, smlen, sm + CRYPTO_BYTES, mlen, ctx, ctxlen, sk);
-  *smlen += mlen;
-  return ret;
 }
 
 /*************************************************
-* Name:        crypto_sign_verify_internal
+* Name:        verify_expanded
 *
-* Description: Verifies signature. Internal API.
+* Description: Verifies a signature that passed the prefilter. Matrix rows
+*              are expanded from the public key one at a time, or taken
+*              from mat if the caller still has the expanded matrix.
 *
-* Arguments:   - uint8_t *m: pointer to input signature
-*              - size_t siglen: length of signature
-*              - const uint8_t *m: pointer to message
-*              - size_t mlen: length of message
-*              - const uint8_t *pre: pointer to prefix string
-*              - size_t prelen: length of prefix string
+* Arguments:   - const uint8_t *sig: pointer to input signature
+*              - const uint8_t *mu: pointer to message representative
 *              - const uint8_t *pk: pointer to bit-packed public key
+*              - const polyvecl *mat: expanded matrix A of pk, or NULL
 *
 * Returns 0 if signature could be verified correctly and -1 otherwise
 **************************************************/
-int crypto_sign_verify_internal(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen,
-                                const uint8_t *pre, size_t prelen, const uint8_t *pk) {
+static int verify_expanded(const uint8_t *sig, const uint8_t mu[CRHBYTES], const uint8_t *pk,
+                           const polyvecl *mat)
+{
   unsigned int i, j, pos = 0;
   /* polyw1_pack writes additional 14 bytes */
   ALIGNED_UINT8(K*POLYW1_PACKEDBYTES+14) buf;
-  uint8_t mu[CRHBYTES];
   const uint8_t *hint = sig + CTILDEBYTES + L*POLYZ_PACKEDBYTES;
   polyvecl rowbuf[2];
-  polyvecl *row = rowbuf;
+  polyvecl *rowp = rowbuf;
+  const polyvecl *row;
   polyvecl z;
   poly c, w1, h;
   keccak_state state;
 
-  if(siglen != CRYPTO_BYTES)
-    return -1;
-
-  /* Compute CRH(H(rho, t1), pre, msg) */
-  shake256(mu, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
-  shake256_init(&state);
-  shake256_absorb(&state, mu, CRHBYTES);
-  shake256_absorb(&state, pre, prelen);
-  shake256_absorb(&state, m, mlen);
-  shake256_finalize(&state);
-  shake256_squeeze(mu, CRHBYTES, &state);
-
   /* Expand challenge */
   poly_challenge(&c, sig);
   poly_ntt(&c);
 
-  /* Unpack z; shortness follows from unpacking */
+  /* Unpack z; shortness was checked by the prefilter */
   for(i = 0; i < L; i++) {
     polyz_unpack(&z.vec[i], sig + CTILDEBYTES + i*POLYZ_PACKEDBYTES);
     poly_ntt(&z.vec[i]);
   }
 
   for(i = 0; i < K; i++) {
-    /* Expand matrix row */
-    polyvec_matrix_expand_row(&row, rowbuf, pk, i);
+    /* Expand matrix row, unless the matrix is given */
+    if(mat) {
+      row = &mat[i];
+    } else {
+      polyvec_matrix_expand_row(&rowp, rowbuf, pk, i);
+      row = rowp;
+    }
 
     /* Compute i-th row of Az - c2^Dt1 */
     polyvecl_pointwise_acc_montgomery(&w1, row, &z);
@@ -459,32 +261,816 @@ int crypto_sign_verify_internal(const uint8_t *sig, size_t siglen, const uint8_t
 }
 
 /*************************************************
-* Name:        crypto_sign_verify
+* Name:        crypto_sign_keypair
 *
-* Description: Verifies signature.
+* Description: Generates public and private key.
 *
-* Arguments:   - uint8_t *m: pointer to input signature
-*              - size_t siglen: length of signature
-*              - const uint8_t *m: pointer to message
-*              - size_t mlen: length of message
-*              - const uint8_t *ctx: pointer to context string
-*              - size_t ctxlen: length of context string
-*              - const uint8_t *pk: pointer to bit-packed public key
+* Arguments:   - uint8_t *pk: pointer to output public key (allocated
+*                             array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk: pointer to output private key (allocated
+*                             array of CRYPTO_SECRETKEYBYTES bytes)
 *
-* Returns 0 if signature could be verified correctly and -1 otherwise
+* Returns 0 (success)
 **************************************************/
-int crypto_sign_verify(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen,
-                       const uint8_t *ctx, size_t ctxlen, const uint8_t *pk)
-{
-  uint8_t pre[257];
-
-  if(ctxlen > 255)
-    return -1;
+int crypto_sign_keypair(uint8_t *pk, uint8_t *sk) {
+  unsigned int i;
+  uint8_t seedbuf[2*SEEDBYTES + CRHBYTES];
+  const uint8_t *rho, *rhoprime, *key;
+  polyvecl rowbuf[2];
+  polyvecl s1, *row = rowbuf;
+  polyveck s2;
+  poly t1, t0;
+
+  /* Get randomness for rho, rhoprime and key */
+  randombytes(seedbuf, SEEDBYTES);
+  seedbuf[SEEDBYTES+0] = K;
+  seedbuf[SEEDBYTES+1] = L;
+  shake256(seedbuf, 2*SEEDBYTES + CRHBYTES, seedbuf, SEEDBYTES+2);
+  rho = seedbuf;
+  rhoprime = rho + SEEDBYTES;
+  key = rhoprime + CRHBYTES;
+
+  /* Store rho, key */
+  memcpy(pk, rho, SEEDBYTES);
+  memcpy(sk, rho, SEEDBYTES);
+  memcpy(sk + SEEDBYTES, key, SEEDBYTES);
+
+  /* Sample short vectors s1 and s2 */
+#if K == 4 && L == 4
+  poly_uniform_eta_4x(&s1.vec[0], &s1.vec[1], &s1.vec[2], &s1.vec[3], rhoprime, 0, 1, 2, 3);
+  poly_uniform_eta_4x(&s2.vec[0], &s2.vec[1], &s2.vec[2], &s2.vec[3], rhoprime, 4, 5, 6, 7);
+#elif K == 6 && L == 5
+  poly_uniform_eta_4x(&s1.vec[0], &s1.vec[1], &s1.vec[2], &s1.vec[3], rhoprime, 0, 1, 2, 3);
+  poly_uniform_eta_4x(&s1.vec[4], &s2.vec[0], &s2.vec[1], &s2.vec[2], rhoprime, 4, 5, 6, 7);
+  poly_uniform_eta_4x(&s2.vec[3], &s2.vec[4], &s2.vec[5], &t0, rhoprime, 8, 9, 10, 11);
+#elif K == 8 && L == 7
+  poly_uniform_eta_4x(&s1.vec[0], &s1.vec[1], &s1.vec[2], &s1.vec[3], rhoprime, 0, 1, 2, 3);
+  poly_uniform_eta_4x(&s1.vec[4], &s1.vec[5], &s1.vec[6], &s2.vec[0], rhoprime, 4, 5, 6, 7);
+  poly_uniform_eta_4x(&s2.vec[1], &s2.vec[2], &s2.vec[3], &s2.vec[4], rhoprime, 8, 9, 10, 11);
+  poly_uniform_eta_4x(&s2.vec[5], &s2.vec[6], &s2.vec[7], &t0, rhoprime, 12, 13, 14, 15);
+#else
+#error
+#endif
+
+  /* Pack secret vectors */
+  for(i = 0; i < L; i++)
+    polyeta_pack(sk + 2*SEEDBYTES + TRBYTES + i*POLYETA_PACKEDBYTES, &s1.vec[i]);
+  for(i = 0; i < K; i++)
+    polyeta_pack(sk + 2*SEEDBYTES + TRBYTES + (L + i)*POLYETA_PACKEDBYTES, &s2.vec[i]);
+
+  /* Transform s1 */
+  polyvecl_ntt(&s1);
+
+  for(i = 0; i < K; i++) {
+    /* Expand matrix row */
+    polyvec_matrix_expand_row(&row, rowbuf, rho, i);
+
+    /* Compute inner-product */
+    polyvecl_pointwise_acc_montgomery(&t1, row, &s1);
+    poly_invntt_tomont(&t1);
+
+    /* Add error polynomial */
+    poly_add(&t1, &t1, &s2.vec[i]);
+
+    /* Round t and pack t1, t0 */
+    poly_caddq(&t1);
+    poly_power2round(&t1, &t0, &t1);
+    polyt1_pack(pk + SEEDBYTES + i*POLYT1_PACKEDBYTES, &t1);
+    polyt0_pack(sk + 2*SEEDBYTES + TRBYTES + (L+K)*POLYETA_PACKEDBYTES + i*POLYT0_PACKEDBYTES, &t0);
+  }
+
+  /* Compute H(rho, t1) and store in secret key */
+  shake256(sk + 2*SEEDBYTES, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
+
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_keypair_pk
+*
+* Description: Generates only the public key. Given the SEEDBYTES that
+*              crypto_sign_keypair draws from randombytes, returns the same
+*              public key, but skips everything that exists only for the
+*              secret key: t0 and s1/s2 packing and tr = H(pk).
+*
+* Arguments:   - uint8_t *pk: pointer to output public key (allocated
+*                             array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - const uint8_t seed[]: keygen randomness (of length SEEDBYTES)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_sign_keypair_pk(uint8_t *pk, const uint8_t seed[SEEDBYTES]) {
+  unsigned int i;
+  uint8_t seedbuf[2*SEEDBYTES + CRHBYTES];
+  const uint8_t *rho, *rhoprime;
+  polyvecl rowbuf[2];
+  polyvecl s1, *row = rowbuf;
+  polyveck s2;
+  poly t1, t0;
+
+  /* Expand seed to rho and rhoprime */
+  memcpy(seedbuf, seed, SEEDBYTES);
+  seedbuf[SEEDBYTES+0] = K;
+  seedbuf[SEEDBYTES+1] = L;
+  shake256(seedbuf, 2*SEEDBYTES + CRHBYTES, seedbuf, SEEDBYTES+2);
+  rho = seedbuf;
+  rhoprime = rho + SEEDBYTES;
+
+  /* Store rho */
+  memcpy(pk, rho, SEEDBYTES);
+
+  /* Sample short vectors s1 and s2 */
+#if K == 4 && L == 4
+  poly_uniform_eta_4x(&s1.vec[0], &s1.vec[1], &s1.vec[2], &s1.vec[3], rhoprime, 0, 1, 2, 3);
+  poly_uniform_eta_4x(&s2.vec[0], &s2.vec[1], &s2.vec[2], &s2.vec[3], rhoprime, 4, 5, 6, 7);
+#elif K == 6 && L == 5
+  poly_uniform_eta_4x(&s1.vec[0], &s1.vec[1], &s1.vec[2], &s1.vec[3], rhoprime, 0, 1, 2, 3);
+  poly_uniform_eta_4x(&s1.vec[4], &s2.vec[0], &s2.vec[1], &s2.vec[2], rhoprime, 4, 5, 6, 7);
+  poly_uniform_eta_4x(&s2.vec[3], &s2.vec[4], &s2.vec[5], &t0, rhoprime, 8, 9, 10, 11);
+#elif K == 8 && L == 7
+  poly_uniform_eta_4x(&s1.vec[0], &s1.vec[1], &s1.vec[2], &s1.vec[3], rhoprime, 0, 1, 2, 3);
+  poly_uniform_eta_4x(&s1.vec[4], &s1.vec[5], &s1.vec[6], &s2.vec[0], rhoprime, 4, 5, 6, 7);
+  poly_uniform_eta_4x(&s2.vec[1], &s2.vec[2], &s2.vec[3], &s2.vec[4], rhoprime, 8, 9, 10, 11);
+  poly_uniform_eta_4x(&s2.vec[5], &s2.vec[6], &s2.vec[7], &t0, rhoprime, 12, 13, 14, 15);
+#else
+#error
+#endif
+
+  /* Transform s1 */
+  polyvecl_ntt(&s1);
+
+  for(i = 0; i < K; i++) {
+    /* Expand matrix row */
+    polyvec_matrix_expand_row(&row, rowbuf, rho, i);
+
+    /* Compute inner-product */
+    polyvecl_pointwise_acc_montgomery(&t1, row, &s1);
+    poly_invntt_tomont(&t1);
+
+    /* Add error polynomial */
+    poly_add(&t1, &t1, &s2.vec[i]);
+
+    /* Round t and pack t1 */
+    poly_caddq(&t1);
+    poly_power2round(&t1, &t0, &t1);
+    polyt1_pack(pk + SEEDBYTES + i*POLYT1_PACKEDBYTES, &t1);
+  }
+
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_keypair_pct
+*
+* Description: Generates public and private key from the SEEDBYTES that
+*              crypto_sign_keypair draws from randombytes, then runs a
+*              pairwise consistency test: signs a fixed message and verifies
+*              the signature. Key generation keeps the whole matrix instead
+*              of one row at a time, and the test reuses it together with
+*              the NTT-domain s1, s2 and t0, so it costs one signing loop and
+*              one matrix-vector product on top of key generation. Signing
+*              is deterministic (rnd = 0) and draws no randomness.
+*
+* Arguments:   - uint8_t *pk: pointer to output public key (allocated
+*                             array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk: pointer to output private key (allocated
+*                             array of CRYPTO_SECRETKEYBYTES bytes)
+*              - const uint8_t seed[]: keygen randomness (of length SEEDBYTES)
+*
+* Returns 0 (success) or -1 if the test fails; pk and sk are zeroed then
+**************************************************/
+int crypto_sign_keypair_pct(uint8_t *pk, uint8_t *sk, const uint8_t seed[SEEDBYTES]) {
+  static const uint8_t msg[] = "pairwise consistency test";
+  unsigned int i;
+  uint8_t seedbuf[2*SEEDBYTES + CRHBYTES];
+  uint8_t mu[CRHBYTES], rhoprime[CRHBYTES];
+  uint8_t rnd[RNDBYTES] = {0};
+  uint8_t sig[CRYPTO_BYTES];
+  const uint8_t *rho, *rhoprime_key, *key;
+  polyvecl mat[K], s1;
+  polyveck s2, t0;
+  poly t1;
+  keccak_state state;
+
+  /* Expand seed to rho, rhoprime and key */
+  memcpy(seedbuf, seed, SEEDBYTES);
+  seedbuf[SEEDBYTES+0] = K;
+  seedbuf[SEEDBYTES+1] = L;
+  shake256(seedbuf, 2*SEEDBYTES + CRHBYTES, seedbuf, SEEDBYTES+2);
+  rho = seedbuf;
+  rhoprime_key = rho + SEEDBYTES;
+  key = rhoprime_key + CRHBYTES;
+
+  /* Store rho, key */
+  memcpy(pk, rho, SEEDBYTES);
+  memcpy(sk, rho, SEEDBYTES);
+  memcpy(sk + SEEDBYTES, key, SEEDBYTES);
+
+  /* Sample short vectors s1 and s2 */
+#if K == 4 && L == 4
+  poly_uniform_eta_4x(&s1.vec[0], &s1.vec[1], &s1.vec[2], &s1.vec[3], rhoprime_key, 0, 1, 2, 3);
+  poly_uniform_eta_4x(&s2.vec[0], &s2.vec[1], &s2.vec[2], &s2.vec[3], rhoprime_key, 4, 5, 6, 7);
+#elif K == 6 && L == 5
+  poly_uniform_eta_4x(&s1.vec[0], &s1.vec[1], &s1.vec[2], &s1.vec[3], rhoprime_key, 0, 1, 2, 3);
+  poly_uniform_eta_4x(&s1.vec[4], &s2.vec[0], &s2.vec[1], &s2.vec[2], rhoprime_key, 4, 5, 6, 7);
+  poly_uniform_eta_4x(&s2.vec[3], &s2.vec[4], &s2.vec[5], &t1, rhoprime_key, 8, 9, 10, 11);
+#elif K == 8 && L == 7
+  poly_uniform_eta_4x(&s1.vec[0], &s1.vec[1], &s1.vec[2], &s1.vec[3], rhoprime_key, 0, 1, 2, 3);
+  poly_uniform_eta_4x(&s1.vec[4], &s1.vec[5], &s1.vec[6], &s2.vec[0], rhoprime_key, 4, 5, 6, 7);
+  poly_uniform_eta_4x(&s2.vec[1], &s2.vec[2], &s2.vec[3], &s2.vec[4], rhoprime_key, 8, 9, 10, 11);
+  poly_uniform_eta_4x(&s2.vec[5], &s2.vec[6], &s2.vec[7], &t1, rhoprime_key, 12, 13, 14, 15);
+#else
+#error
+#endif
+
+  /* Pack secret vectors */
+  for(i = 0; i < L; i++)
+    polyeta_pack(sk + 2*SEEDBYTES + TRBYTES + i*POLYETA_PACKEDBYTES, &s1.vec[i]);
+  for(i = 0; i < K; i++)
+    polyeta_pack(sk + 2*SEEDBYTES + TRBYTES + (L + i)*POLYETA_PACKEDBYTES, &s2.vec[i]);
+
+  /* Transform s1; the matrix is kept for the test */
+  polyvecl_ntt(&s1);
+  polyvec_matrix_expand(mat, rho);
+
+  for(i = 0; i < K; i++) {
+    /* Compute inner-product */
+    polyvecl_pointwise_acc_montgomery(&t1, &mat[i], &s1);
+    poly_invntt_tomont(&t1);
+
+    /* Add error polynomial */
+    poly_add(&t1, &t1, &s2.vec[i]);
+
+    /* Round t and pack t1, t0 */
+    poly_caddq(&t1);
+    poly_power2round(&t1, &t0.vec[i], &t1);
+    polyt1_pack(pk + SEEDBYTES + i*POLYT1_PACKEDBYTES, &t1);
+    polyt0_pack(sk + 2*SEEDBYTES + TRBYTES + (L+K)*POLYETA_PACKEDBYTES + i*POLYT0_PACKEDBYTES, &t0.vec[i]);
+  }
+
+  /* Compute H(rho, t1) and store in secret key */
+  shake256(sk + 2*SEEDBYTES, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
+
+  /* Sign the test message with the key still in NTT domain */
+  crypto_sign_compute_mu(mu, sk + 2*SEEDBYTES, msg, sizeof(msg) - 1, NULL, 0);
+  shake256_init(&state);
+  shake256_absorb(&state, key, SEEDBYTES);
+  shake256_absorb(&state, rnd, RNDBYTES);
+  shake256_absorb(&state, mu, CRHBYTES);
+  shake256_finalize(&state);
+  shake256_squeeze(rhoprime, CRHBYTES, &state);
+
+  polyveck_ntt(&s2);
+  polyveck_ntt(&t0);
+  sign_expanded(sig, mu, rhoprime, mat, &s1, &s2, &t0);
+
+  /* Verify it against the kept matrix */
+  if(verify_expanded(sig, mu, pk, mat)) {
+    memset(pk, 0, CRYPTO_PUBLICKEYBYTES);
+    memset(sk, 0, CRYPTO_SECRETKEYBYTES);
+    return -1;
+  }
+
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_compute_mu
+*
+* Description: Computes the message representative mu = CRH(tr, pre, msg)
+*              with pre = (0, ctxlen, ctx). The result can be passed to
+*              crypto_sign_signature_mu and crypto_sign_verify_mu, so a
+*              message has to be hashed only once per public key.
+*
+* Arguments:   - uint8_t *mu: pointer to output message representative
+*                             (of length CRHBYTES)
+*              - const uint8_t *tr: pointer to H(pk) (of length TRBYTES),
+*                                   also stored in the secret key
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int crypto_sign_compute_mu(uint8_t mu[CRHBYTES], const uint8_t tr[TRBYTES], const uint8_t *m, size_t mlen,
+                           const uint8_t *ctx, size_t ctxlen)
+{
+  uint8_t pre[2];
+  keccak_state state;
+
+  if(ctxlen > 255)
+    return -1;
+
+  pre[0] = 0;
+  pre[1] = ctxlen;
+  shake256_init(&state);
+  shake256_absorb(&state, tr, TRBYTES);
+  shake256_absorb(&state, pre, 2);
+  shake256_absorb(&state, ctx, ctxlen);
+  shake256_absorb(&state, m, mlen);
+  shake256_finalize(&state);
+  shake256_squeeze(mu, CRHBYTES, &state);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_mu_internal
+*
+* Description: Computes signature from the message representative
+*              mu = CRH(tr, pre, msg). Internal API.
+*
+* Arguments:   - uint8_t *sig: pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - uint8_t *mu: pointer to message representative
+*              - uint8_t *rnd: pointer to random seed
+*              - uint8_t *sk: pointer to bit-packed secret key
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_sign_signature_mu_internal(uint8_t *sig, size_t *siglen, const uint8_t mu[CRHBYTES],
+                                      const uint8_t rnd[RNDBYTES], const uint8_t *sk)
+{
+  uint8_t seedbuf[2*SEEDBYTES + TRBYTES + CRHBYTES];
+  uint8_t *rho, *tr, *key, *rhoprime;
+  polyvecl mat[K], s1;
+  polyveck t0, s2;
+  keccak_state state;
+
+  rho = seedbuf;
+  tr = rho + SEEDBYTES;
+  key = tr + TRBYTES;
+  rhoprime = key + SEEDBYTES;
+  unpack_sk(rho, tr, key, &t0, &s1, &s2, sk);
+
+  /* Compute rhoprime = CRH(key, rnd, mu) */
+  shake256_init(&state);
+  shake256_absorb(&state, key, SEEDBYTES);
+  shake256_absorb(&state, rnd, RNDBYTES);
+  shake256_absorb(&state, mu, CRHBYTES);
+  shake256_finalize(&state);
+  shake256_squeeze(rhoprime, CRHBYTES, &state);
+
+  /* Expand matrix and transform vectors */
+  polyvec_matrix_expand(mat, rho);
+  polyvecl_ntt(&s1);
+  polyveck_ntt(&s2);
+  polyveck_ntt(&t0);
+
+  sign_expanded(sig, mu, rhoprime, mat, &s1, &s2, &t0);
+  *siglen = CRYPTO_BYTES;
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_internal
+*
+* Description: Computes signature. Internal API.
+*
+* Arguments:   - uint8_t *sig: pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - uint8_t *m: pointer to message to be signed
+*              - size_t mlen: length of message
+*              - uint8_t *pre: pointer to prefix string
+*              - size_t prelen: length of prefix string
+*              - uint8_t *rnd: pointer to random seed
+*              - uint8_t *sk: pointer to bit-packed secret key
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_sign_signature_internal(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen,
+                                   const uint8_t *pre, size_t prelen, const uint8_t rnd[RNDBYTES], const uint8_t *sk)
+{
+  uint8_t mu[CRHBYTES];
+  keccak_state state;
+
+  /* Compute mu = CRH(tr, pre, msg) */
+  shake256_init(&state);
+  shake256_absorb(&state, sk + 2*SEEDBYTES, TRBYTES);
+  shake256_absorb(&state, pre, prelen);
+  shake256_absorb(&state, m, mlen);
+  shake256_finalize(&state);
+  shake256_squeeze(mu, CRHBYTES, &state);
+
+  return crypto_sign_signature_mu_internal(sig, siglen, mu, rnd, sk);
+}
+
+/*************************************************
+* Name:        crypto_sign_signature
+*
+* Description: Computes signature.
+*
+* Arguments:   - uint8_t *sig: pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - uint8_t *m: pointer to message to be signed
+*              - size_t mlen: length of message
+*              - uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - uint8_t *sk: pointer to bit-packed secret key
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int crypto_sign_signature(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen,
+                          const uint8_t *ctx, size_t ctxlen, const uint8_t *sk)
+{
+  uint8_t pre[257];
+  uint8_t rnd[RNDBYTES];
+
+  if(ctxlen > 255)
+    return -1;
+
+  /* Prepare pre = (0, ctxlen, ctx) */
+  pre[0] = 0;
+  pre[1] = ctxlen;
+  memcpy(&pre[2], ctx, ctxlen);
+
+#ifdef DILITHIUM_RANDOMIZED_SIGNING
+  randombytes(rnd, RNDBYTES);
+#else
+  memset(rnd, 0, RNDBYTES);
+#endif
+
+  crypto_sign_signature_internal(sig,siglen,m,mlen,pre,2+ctxlen,rnd,sk);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_mu
+*
+* Description: Computes signature from a precomputed message
+*              representative mu = CRH(tr, pre, msg), see
+*              crypto_sign_compute_mu.
+*
+* Arguments:   - uint8_t *sig: pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - const uint8_t *mu: pointer to message representative
+*              - const uint8_t *sk: pointer to bit-packed secret key
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_sign_signature_mu(uint8_t *sig, size_t *siglen, const uint8_t mu[CRHBYTES], const uint8_t *sk)
+{
+  uint8_t rnd[RNDBYTES];
+
+#ifdef DILITHIUM_RANDOMIZED_SIGNING
+  randombytes(rnd, RNDBYTES);
+#else
+  memset(rnd, 0, RNDBYTES);
+#endif
+
+  return crypto_sign_signature_mu_internal(sig, siglen, mu, rnd, sk);
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_init
+*
+* Description: Starts an incremental signature computation. The message
+*              is passed in pieces to crypto_sign_signature_update and
+*              the signature is produced by crypto_sign_signature_final.
+*
+* Arguments:   - keccak_state *state: pointer to output hashing state
+*              - uint8_t *ctx:        pointer to context string
+*              - size_t ctxlen:       length of context string
+*              - uint8_t *sk:         pointer to bit-packed secret key
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int crypto_sign_signature_init(keccak_state *state,
+                               const uint8_t *ctx,
+                               size_t ctxlen,
+                               const uint8_t *sk)
+{
+  uint8_t pre[2];
+
+  if(ctxlen > 255)
+    return -1;
+
+  /* Absorb tr and pre = (0, ctxlen, ctx) */
+  pre[0] = 0;
+  pre[1] = ctxlen;
+  shake256_init(state);
+  shake256_absorb(state, sk + 2*SEEDBYTES, TRBYTES);
+  shake256_absorb(state, pre, 2);
+  shake256_absorb(state, ctx, ctxlen);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_update
+*
+* Description: Absorbs the next piece of the message to be signed.
+*
+* Arguments:   - keccak_state *state: pointer to hashing state
+*              - uint8_t *m:          pointer to message piece
+*              - size_t mlen:         length of message piece
+**************************************************/
+void crypto_sign_signature_update(keccak_state *state,
+                                  const uint8_t *m,
+                                  size_t mlen)
+{
+  shake256_absorb(state, m, mlen);
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_final
+*
+* Description: Finishes an incremental signature computation.
+*
+* Arguments:   - keccak_state *state: pointer to hashing state
+*              - uint8_t *sig:        pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen:      pointer to output length of signature
+*              - uint8_t *sk:         pointer to bit-packed secret key
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_sign_signature_final(keccak_state *state,
+                                uint8_t *sig,
+                                size_t *siglen,
+                                const uint8_t *sk)
+{
+  uint8_t mu[CRHBYTES];
+
+  shake256_finalize(state);
+  shake256_squeeze(mu, CRHBYTES, state);
+
+  return crypto_sign_signature_mu(sig, siglen, mu, sk);
+}
+
+/*************************************************
+* Name:        crypto_sign
+*
+* Description: Compute signed message.
+*
+* Arguments:   - uint8_t *sm: pointer to output signed message (allocated
+*                             array with CRYPTO_BYTES + mlen bytes),
+*                             can be equal to m
+*              - size_t *smlen: pointer to output length of signed
+*                               message
+*              - const uint8_t *m: pointer to message to be signed
+*              - size_t mlen: length of message
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *sk: pointer to bit-packed secret key
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_sign(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t mlen, const uint8_t *ctx, size_t ctxlen,
+                const uint8_t *sk)
+{
+  size_t i;
+  int ret;
+
+  for(i = 0; i < mlen; ++i)
+    sm[CRYPTO_BYTES + mlen - 1 - i] = m[mlen - 1 - i];
+  ret = crypto_sign_signature(sm, smlen, sm + CRYPTO_BYTES, mlen, ctx, ctxlen, sk);
+  *smlen += mlen;
+  return ret;
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_prefilter
+*
+* Description: Cheap structural screening of a signature before any
+*              unpacking or matrix expansion. Checks the length, the
+*              encoding of the hint vector and the range of z directly
+*              on the packed bytes. A signature that passes may still be
+*              invalid; one that fails is always rejected by verify.
+*
+* Arguments:   - const uint8_t *sig: pointer to input signature
+*              - size_t siglen: length of signature
+*              - crypto_sign_prefilter_stats *stats: optional pointer to
+*                rejection counters, incremented per reason; may be NULL
+*
+* Returns 0 if the signature passes and -1 otherwise
+**************************************************/
+int crypto_sign_verify_prefilter(const uint8_t *sig, size_t siglen,
+                                 crypto_sign_prefilter_stats *stats)
+{
+  unsigned int i;
+
+  if(siglen != CRYPTO_BYTES) {
+    if(stats)
+      stats->length++;
+    return -1;
+  }
+
+  if(check_sig_hint(sig)) {
+    if(stats)
+      stats->hint++;
+    return -1;
+  }
+
+  for(i = 0; i < L; ++i) {
+    if(polyz_packed_chknorm(sig + CTILDEBYTES + i*POLYZ_PACKEDBYTES, GAMMA1 - BETA)) {
+      if(stats)
+        stats->z++;
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+/*************************************************
+* Name:        verify_internal
+*
+* Description: Runs the prefilter, then computes mu = CRH(H(rho, t1), pre,
+*              msg) and verifies the signature against it. Malformed
+*              signatures are rejected before the public key and the
+*              message are hashed.
+*
+* Arguments:   as crypto_sign_verify_internal, plus
+*              - crypto_sign_prefilter_stats *stats: optional pointer to
+*                prefilter rejection counters; may be NULL
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+static int verify_internal(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen,
+                           const uint8_t *pre, size_t prelen, const uint8_t *pk,
+                           crypto_sign_prefilter_stats *stats)
+{
+  uint8_t mu[CRHBYTES];
+  keccak_state state;
+
+  if(crypto_sign_verify_prefilter(sig, siglen, stats))
+    return -1;
+
+  /* Compute CRH(H(rho, t1), pre, msg) */
+  shake256(mu, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
+  shake256_init(&state);
+  shake256_absorb(&state, mu, TRBYTES);
+  shake256_absorb(&state, pre, prelen);
+  shake256_absorb(&state, m, mlen);
+  shake256_finalize(&state);
+  shake256_squeeze(mu, CRHBYTES, &state);
+
+  return verify_expanded(sig, mu, pk, NULL);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_mu
+*
+* Description: Verifies signature against a precomputed message
+*              representative mu = CRH(tr, pre, msg), see
+*              crypto_sign_compute_mu.
+*
+* Arguments:   - uint8_t *sig: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *mu: pointer to message representative
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int crypto_sign_verify_mu(const uint8_t *sig, size_t siglen, const uint8_t mu[CRHBYTES], const uint8_t *pk) {
+  if(crypto_sign_verify_prefilter(sig, siglen, NULL))
+    return -1;
+
+  return verify_expanded(sig, mu, pk, NULL);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_internal
+*
+* Description: Verifies signature. Internal API.
+*
+* Arguments:   - uint8_t *m: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *pre: pointer to prefix string
+*              - size_t prelen: length of prefix string
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int crypto_sign_verify_internal(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen,
+                                const uint8_t *pre, size_t prelen, const uint8_t *pk) {
+  return verify_internal(sig, siglen, m, mlen, pre, prelen, pk, NULL);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify
+*
+* Description: Verifies signature.
+*
+* Arguments:   - uint8_t *m: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int crypto_sign_verify(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen,
+                       const uint8_t *ctx, size_t ctxlen, const uint8_t *pk)
+{
+  return crypto_sign_verify_stats(sig, siglen, m, mlen, ctx, ctxlen, pk, NULL);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_stats
+*
+* Description: Verifies signature like crypto_sign_verify and counts
+*              prefilter rejections by reason.
+*
+* Arguments:   as crypto_sign_verify, plus
+*              - crypto_sign_prefilter_stats *stats: optional pointer to
+*                rejection counters, incremented per reason; may be NULL
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int crypto_sign_verify_stats(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen,
+                             const uint8_t *ctx, size_t ctxlen, const uint8_t *pk,
+                             crypto_sign_prefilter_stats *stats)
+{
+  uint8_t pre[257];
+
+  if(ctxlen > 255)
+    return -1;
 
   pre[0] = 0;
   pre[1] = ctxlen;
   memcpy(&pre[2], ctx, ctxlen);
-  return crypto_sign_verify_internal(sig,siglen,m,mlen,pre,2+ctxlen,pk);
+  return verify_internal(sig,siglen,m,mlen,pre,2+ctxlen,pk,stats);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_init
+*
+* Description: Starts an incremental signature verification. The message
+*              is passed in pieces to crypto_sign_verify_update and the
+*              signature is checked by crypto_sign_verify_final.
+*
+* Arguments:   - keccak_state *state: pointer to output hashing state
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int crypto_sign_verify_init(keccak_state *state,
+                            const uint8_t *ctx,
+                            size_t ctxlen,
+                            const uint8_t *pk)
+{
+  uint8_t tr[TRBYTES];
+  uint8_t pre[2];
+
+  if(ctxlen > 255)
+    return -1;
+
+  /* Absorb H(rho, t1) and pre = (0, ctxlen, ctx) */
+  shake256(tr, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
+  pre[0] = 0;
+  pre[1] = ctxlen;
+  shake256_init(state);
+  shake256_absorb(state, tr, TRBYTES);
+  shake256_absorb(state, pre, 2);
+  shake256_absorb(state, ctx, ctxlen);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_update
+*
+* Description: Absorbs the next piece of the signed message.
+*
+* Arguments:   - keccak_state *state: pointer to hashing state
+*              - const uint8_t *m: pointer to message piece
+*              - size_t mlen: length of message piece
+**************************************************/
+void crypto_sign_verify_update(keccak_state *state,
+                               const uint8_t *m,
+                               size_t mlen)
+{
+  shake256_absorb(state, m, mlen);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_final
+*
+* Description: Finishes an incremental signature verification.
+*
+* Arguments:   - keccak_state *state: pointer to hashing state
+*              - const uint8_t *sig: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int crypto_sign_verify_final(keccak_state *state,
+                             const uint8_t *sig,
+                             size_t siglen,
+                             const uint8_t *pk)
+{
+  uint8_t mu[CRHBYTES];
+
+  shake256_finalize(state);
+  shake256_squeeze(mu, CRHBYTES, state);
+
+  return crypto_sign_verify_mu(sig, siglen, mu, pk);
 }
 
 /*************************************************
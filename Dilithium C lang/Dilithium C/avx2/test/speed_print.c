@@ -1 +0,0 @@
-../../ref/test/speed_print.c
\ No newline at end of file
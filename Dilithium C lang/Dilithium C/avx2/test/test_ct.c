@@ -0,0 +1 @@
+../../ref/test/test_ct.c
\ No newline at end of file
@@ -41,6 +41,7 @@ int main(void) {
   uint8_t ctx[CTXLEN] = {0};
   uint8_t seed[CRHBYTES];
   uint8_t buf[CRYPTO_SECRETKEYBYTES];
+  keccak_state rngsave;
   size_t siglen;
   poly c, tmp;
   polyvecl s, y, mat[K];
@@ -57,7 +58,15 @@ int main(void) {
       printf("%02x", m[j]);
     printf("\n");
 
+    rngsave = rngstate;
+    randombytes(seed, SEEDBYTES);
+    crypto_sign_keypair_pk(buf, seed);
+    rngstate = rngsave;
     crypto_sign_keypair(pk, sk);
+    if(memcmp(buf, pk, CRYPTO_PUBLICKEYBYTES)) {
+      fprintf(stderr,"Public-key-only keygen mismatch!\n");
+      return -1;
+    }
     shake256(buf, 32, pk, CRYPTO_PUBLICKEYBYTES);
     printf("pk = ");
     for(j = 0; j < 32; ++j)
@@ -76,8 +85,10 @@ int main(void) {
       printf("%02x", buf[j]);
     printf("\n");
 
-    if(crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk))
+    if(crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk)) {
       fprintf(stderr,"Signature verification failed!\n");
+      return -1;
+    }
 
     randombytes(seed, sizeof(seed));
     printf("seed = ");
@@ -0,0 +1,19 @@
+#ifndef ALIGN_H
+#define ALIGN_H
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#define ALIGNED_UINT8(N)        \
+    union {                     \
+        uint8_t coeffs[N];      \
+        __m512i vec[(N+63)/64]; \
+    }
+
+#define ALIGNED_INT32(N)        \
+    union {                     \
+        int32_t coeffs[N];      \
+        __m512i vec[(N+15)/16]; \
+    }
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+//#define DILITHIUM_MODE 2
+#define DILITHIUM_RANDOMIZED_SIGNING
+#define DILITHIUM_LAZY_MATRIX
+//#define USE_RDPMC
+//#define DBENCH
+
+#ifndef DILITHIUM_MODE
+#define DILITHIUM_MODE 2
+#endif
+
+#if DILITHIUM_MODE == 2
+#define CRYPTO_ALGNAME "Dilithium2"
+#define DILITHIUM_NAMESPACETOP pqcrystals_dilithium2_avx512
+#define DILITHIUM_NAMESPACE(s) pqcrystals_dilithium2_avx512_##s
+#elif DILITHIUM_MODE == 3
+#define CRYPTO_ALGNAME "Dilithium3"
+#define DILITHIUM_NAMESPACETOP pqcrystals_dilithium3_avx512
+#define DILITHIUM_NAMESPACE(s) pqcrystals_dilithium3_avx512_##s
+#elif DILITHIUM_MODE == 5
+#define CRYPTO_ALGNAME "Dilithium5"
+#define DILITHIUM_NAMESPACETOP pqcrystals_dilithium5_avx512
+#define DILITHIUM_NAMESPACE(s) pqcrystals_dilithium5_avx512_##s
+#endif
+
+#endif
@@ -0,0 +1,2 @@
+/* The FIPS-202 implementation is shared by all schemes; see q4_lib/fips202 */
+#include "../../../q4_lib/fips202/fips202x8.h"
@@ -0,0 +1,43 @@
+#ifndef MONTMUL_H
+#define MONTMUL_H
+
+#include <immintrin.h>
+#include "params.h"
+#include "reduce.h"
+
+/*************************************************
+* Name:        montmul_avx512
+*
+* Description: Sixteen lanes of montgomery_reduce((int64_t)a*b). Computes
+*              exactly the same representative as the scalar code.
+*
+* Arguments:   - __m512i a: first factors
+*              - __m512i b: second factors
+*
+* Returns a*b*2^{-32} mod Q with absolute value < Q.
+**************************************************/
+static inline __m512i montmul_avx512(__m512i a, __m512i b) {
+  const __m512i q = _mm512_set1_epi32(Q);
+  const __m512i qinv = _mm512_set1_epi32(QINV);
+  __m512i a1, b1, lo0, lo1, t0, t1;
+
+  /* Even lanes */
+  lo0 = _mm512_mul_epi32(a, b);
+  t0 = _mm512_mul_epi32(lo0, qinv);
+  t0 = _mm512_mul_epi32(t0, q);
+  lo0 = _mm512_sub_epi64(lo0, t0);
+
+  /* Odd lanes */
+  a1 = _mm512_srli_epi64(a, 32);
+  b1 = _mm512_srli_epi64(b, 32);
+  lo1 = _mm512_mul_epi32(a1, b1);
+  t1 = _mm512_mul_epi32(lo1, qinv);
+  t1 = _mm512_mul_epi32(t1, q);
+  lo1 = _mm512_sub_epi64(lo1, t1);
+
+  /* Low halves of the differences are zero; keep the high halves */
+  lo0 = _mm512_srli_epi64(lo0, 32);
+  return _mm512_mask_blend_epi32(0xAAAA, lo0, lo1);
+}
+
+#endif
@@ -0,0 +1,237 @@
+#include <stdint.h>
+#include <immintrin.h>
+#include "params.h"
+#include "ntt.h"
+#include "reduce.h"
+#include "montmul.h"
+
+static const int32_t zetas[N] = {
+         0,    25847, -2608894,  -518909,   237124,  -777960,  -876248,   466468,
+   1826347,  2353451,  -359251, -2091905,  3119733, -2884855,  3111497,  2680103,
+   2725464,  1024112, -1079900,  3585928,  -549488, -1119584,  2619752, -2108549,
+  -2118186, -3859737, -1399561, -3277672,  1757237,   -19422,  4010497,   280005,
+   2706023,    95776,  3077325,  3530437, -1661693, -3592148, -2537516,  3915439,
+  -3861115, -3043716,  3574422, -2867647,  3539968,  -300467,  2348700,  -539299,
+  -1699267, -1643818,  3505694, -3821735,  3507263, -2140649, -1600420,  3699596,
+    811944,   531354,   954230,  3881043,  3900724, -2556880,  2071892, -2797779,
+  -3930395, -1528703, -3677745, -3041255, -1452451,  3475950,  2176455, -1585221,
+  -1257611,  1939314, -4083598, -1000202, -3190144, -3157330, -3632928,   126922,
+   3412210,  -983419,  2147896,  2715295, -2967645, -3693493,  -411027, -2477047,
+   -671102, -1228525,   -22981, -1308169,  -381987,  1349076,  1852771, -1430430,
+  -3343383,   264944,   508951,  3097992,    44288, -1100098,   904516,  3958618,
+  -3724342,    -8578,  1653064, -3249728,  2389356,  -210977,   759969, -1316856,
+    189548, -3553272,  3159746, -1851402, -2409325,  -177440,  1315589,  1341330,
+   1285669, -1584928,  -812732, -1439742, -3019102, -3881060, -3628969,  3839961,
+   2091667,  3407706,  2316500,  3817976, -3342478,  2244091, -2446433, -3562462,
+    266997,  2434439, -1235728,  3513181, -3520352, -3759364, -1197226, -3193378,
+    900702,  1859098,   909542,   819034,   495491, -1613174,   -43260,  -522500,
+   -655327, -3122442,  2031748,  3207046, -3556995,  -525098,  -768622, -3595838,
+    342297,   286988, -2437823,  4108315,  3437287, -3342277,  1735879,   203044,
+   2842341,  2691481, -2590150,  1265009,  4055324,  1247620,  2486353,  1595974,
+  -3767016,  1250494,  2635921, -3548272, -2994039,  1869119,  1903435, -1050970,
+  -1333058,  1237275, -3318210, -1430225,  -451100,  1312455,  3306115, -1962642,
+  -1279661,  1917081, -2546312, -1374803,  1500165,   777191,  2235880,  3406031,
+   -542412, -2831860, -1671176, -1846953, -2584293, -3724270,   594136, -3776993,
+  -2013608,  2432395,  2454455,  -164721,  1957272,  3369112,   185531, -1207385,
+  -3183426,   162844,  1616392,  3014001,   810149,  1652634, -3694233, -1799107,
+  -3038916,  3523897,  3866901,   269760,  2213111,  -975884,  1717735,   472078,
+   -426683,  1723600, -1803090,  1910376, -1667432, -1104333,  -260646, -3833893,
+  -2939036, -2235985,  -420899, -2286327,   183443,  -976891,  1612842, -3545687,
+   -554416,  3919660,   -48306, -1362209,  3937738,  1400424,  -846154,  1976782
+};
+
+/* zetas_inv[i] = -zetas[N-1-i], the twiddles of invntt_tomont in the
+ * order in which they are consumed */
+static const int32_t zetas_inv[N] = {
+  -1976782,   846154, -1400424, -3937738,  1362209,    48306, -3919660,   554416,
+   3545687, -1612842,   976891,  -183443,  2286327,   420899,  2235985,  2939036,
+   3833893,   260646,  1104333,  1667432, -1910376,  1803090, -1723600,   426683,
+   -472078, -1717735,   975884, -2213111,  -269760, -3866901, -3523897,  3038916,
+   1799107,  3694233, -1652634,  -810149, -3014001, -1616392,  -162844,  3183426,
+   1207385,  -185531, -3369112, -1957272,   164721, -2454455, -2432395,  2013608,
+   3776993,  -594136,  3724270,  2584293,  1846953,  1671176,  2831860,   542412,
+  -3406031, -2235880,  -777191, -1500165,  1374803,  2546312, -1917081,  1279661,
+   1962642, -3306115, -1312455,   451100,  1430225,  3318210, -1237275,  1333058,
+   1050970, -1903435, -1869119,  2994039,  3548272, -2635921, -1250494,  3767016,
+  -1595974, -2486353, -1247620, -4055324, -1265009,  2590150, -2691481, -2842341,
+   -203044, -1735879,  3342277, -3437287, -4108315,  2437823,  -286988,  -342297,
+   3595838,   768622,   525098,  3556995, -3207046, -2031748,  3122442,   655327,
+    522500,    43260,  1613174,  -495491,  -819034,  -909542, -1859098,  -900702,
+   3193378,  1197226,  3759364,  3520352, -3513181,  1235728, -2434439,  -266997,
+   3562462,  2446433, -2244091,  3342478, -3817976, -2316500, -3407706, -2091667,
+  -3839961,  3628969,  3881060,  3019102,  1439742,   812732,  1584928, -1285669,
+  -1341330, -1315589,   177440,  2409325,  1851402, -3159746,  3553272,  -189548,
+   1316856,  -759969,   210977, -2389356,  3249728, -1653064,     8578,  3724342,
+  -3958618,  -904516,  1100098,   -44288, -3097992,  -508951,  -264944,  3343383,
+   1430430, -1852771, -1349076,   381987,  1308169,    22981,  1228525,   671102,
+   2477047,   411027,  3693493,  2967645, -2715295, -2147896,   983419, -3412210,
+   -126922,  3632928,  3157330,  3190144,  1000202,  4083598, -1939314,  1257611,
+   1585221, -2176455, -3475950,  1452451,  3041255,  3677745,  1528703,  3930395,
+   2797779, -2071892,  2556880, -3900724, -3881043,  -954230,  -531354,  -811944,
+  -3699596,  1600420,  2140649, -3507263,  3821735, -3505694,  1643818,  1699267,
+    539299, -2348700,   300467, -3539968,  2867647, -3574422,  3043716,  3861115,
+  -3915439,  2537516,  3592148,  1661693, -3530437, -3077325,   -95776, -2706023,
+   -280005, -4010497,    19422, -1757237,  3277672,  1399561,  3859737,  2118186,
+   2108549, -2619752,  1119584,   549488, -3585928,  1079900, -1024112, -2725464,
+  -2680103, -3111497,  2884855, -3119733,  2091905,   359251, -2353451, -1826347,
+   -466468,   876248,   777960,  -237124,   518909,  2608894,   -25847,        0
+};
+
+/*************************************************
+* Name:        layer_perm
+*
+* Description: Index vectors for the butterfly layers with len < 16. For
+*              two registers holding 32 consecutive coefficients, idx[0]
+*              and idx[1] select the lower and upper butterfly inputs,
+*              idx[2] and idx[3] scatter the outputs back.
+*
+* Arguments:   - __m512i idx[4]: output index vectors
+*              - unsigned int lg: log2 of butterfly distance len
+**************************************************/
+static inline void layer_perm(__m512i idx[4], unsigned int lg) {
+  const __m512i lane = _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8,
+                                        7, 6, 5, 4, 3, 2, 1, 0);
+  const __m512i lenm1 = _mm512_set1_epi32((1 << lg) - 1);
+  const __m512i len = _mm512_set1_epi32(1 << lg);
+  const __m512i sixteen = _mm512_set1_epi32(16);
+  __m512i g, w, p;
+  __mmask16 lo;
+
+  /* Lane i of the inputs is coefficient p = g*2*len + w, g = i/len, w = i%len */
+  g = _mm512_srli_epi32(lane, lg);
+  w = _mm512_and_si512(lane, lenm1);
+  p = _mm512_or_si512(_mm512_slli_epi32(g, lg + 1), w);
+  idx[0] = p;
+  idx[1] = _mm512_add_epi32(p, len);
+
+  /* Coefficient p = g*2*len + w sits in lane g*len + w%len of the inputs */
+  g = _mm512_srli_epi32(lane, lg + 1);
+  w = _mm512_and_si512(lane, _mm512_set1_epi32((2 << lg) - 1));
+  lo = _mm512_cmplt_epi32_mask(w, len);
+  p = _mm512_add_epi32(_mm512_slli_epi32(g, lg), _mm512_and_si512(w, lenm1));
+  p = _mm512_mask_add_epi32(p, ~lo, p, sixteen);
+  idx[2] = p;
+  /* Second register holds g + 16/(2*len) */
+  idx[3] = _mm512_add_epi32(p, _mm512_set1_epi32(8));
+}
+
+/*************************************************
+* Name:        ntt
+*
+* Description: Forward NTT, in-place. No modular reduction is performed after
+*              additions or subtractions. Output vector is in bitreversed order.
+*              Produces the same output as the reference implementation.
+*
+* Arguments:   - int32_t a[N]: input/output coefficient array, processed
+*                16 coefficients per __m512i
+**************************************************/
+void ntt(int32_t a[N]) {
+  unsigned int len, lg, start, j, k;
+  __m512i f0, f1, g0, g1, t, zeta, idx[4];
+
+  /* Layers with len >= 16: one zeta per register */
+  k = 0;
+  for(len = 128; len >= 16; len >>= 1) {
+    for(start = 0; start < N; start = j + len) {
+      zeta = _mm512_set1_epi32(zetas[++k]);
+      for(j = start; j < start + len; j += 16) {
+        f0 = _mm512_loadu_si512((const __m512i *)&a[j]);
+        f1 = _mm512_loadu_si512((const __m512i *)&a[j + len]);
+        t = montmul_avx512(zeta, f1);
+        f1 = _mm512_sub_epi32(f0, t);
+        f0 = _mm512_add_epi32(f0, t);
+        _mm512_storeu_si512((__m512i *)&a[j], f0);
+        _mm512_storeu_si512((__m512i *)&a[j + len], f1);
+      }
+    }
+  }
+
+  /* Layers with len < 16: gather butterfly pairs of 32 coefficients */
+  for(lg = 4; lg-- > 0;) {
+    len = 1U << lg;
+    layer_perm(idx, lg);
+    for(j = 0; j < N; j += 32) {
+      /* Zetas of the 16/len groups in these 32 coefficients */
+      zeta = _mm512_maskz_loadu_epi32((1U << (16 >> lg)) - 1, &zetas[N/(2*len) + j/(2*len)]);
+      zeta = _mm512_permutexvar_epi32(_mm512_srli_epi32(idx[0], lg + 1), zeta);
+
+      f0 = _mm512_loadu_si512((const __m512i *)&a[j]);
+      f1 = _mm512_loadu_si512((const __m512i *)&a[j + 16]);
+      g0 = _mm512_permutex2var_epi32(f0, idx[0], f1);
+      g1 = _mm512_permutex2var_epi32(f0, idx[1], f1);
+      t = montmul_avx512(zeta, g1);
+      g1 = _mm512_sub_epi32(g0, t);
+      g0 = _mm512_add_epi32(g0, t);
+      f0 = _mm512_permutex2var_epi32(g0, idx[2], g1);
+      f1 = _mm512_permutex2var_epi32(g0, idx[3], g1);
+      _mm512_storeu_si512((__m512i *)&a[j], f0);
+      _mm512_storeu_si512((__m512i *)&a[j + 16], f1);
+    }
+  }
+}
+
+/*************************************************
+* Name:        invntt_tomont
+*
+* Description: Inverse NTT and multiplication by Montgomery factor 2^32.
+*              In-place. No modular reductions after additions or
+*              subtractions; input coefficients need to be smaller than
+*              Q in absolute value. Output coefficient are smaller than Q in
+*              absolute value. Produces the same output as the reference
+*              implementation.
+*
+* Arguments:   - int32_t a[N]: input/output coefficient array, processed
+*                16 coefficients per __m512i
+**************************************************/
+void invntt_tomont(int32_t a[N]) {
+  unsigned int len, lg, start, j, k;
+  __m512i f0, f1, g0, g1, t, zeta, idx[4];
+  const __m512i f = _mm512_set1_epi32(41978); // mont^2/256
+
+  /* Layers with len < 16 */
+  for(lg = 0; lg < 4; ++lg) {
+    len = 1U << lg;
+    layer_perm(idx, lg);
+    for(j = 0; j < N; j += 32) {
+      zeta = _mm512_maskz_loadu_epi32((1U << (16 >> lg)) - 1, &zetas_inv[N - N/len + j/(2*len)]);
+      zeta = _mm512_permutexvar_epi32(_mm512_srli_epi32(idx[0], lg + 1), zeta);
+
+      f0 = _mm512_loadu_si512((const __m512i *)&a[j]);
+      f1 = _mm512_loadu_si512((const __m512i *)&a[j + 16]);
+      g0 = _mm512_permutex2var_epi32(f0, idx[0], f1);
+      g1 = _mm512_permutex2var_epi32(f0, idx[1], f1);
+      t = g0;
+      g0 = _mm512_add_epi32(t, g1);
+      g1 = _mm512_sub_epi32(t, g1);
+      g1 = montmul_avx512(zeta, g1);
+      f0 = _mm512_permutex2var_epi32(g0, idx[2], g1);
+      f1 = _mm512_permutex2var_epi32(g0, idx[3], g1);
+      _mm512_storeu_si512((__m512i *)&a[j], f0);
+      _mm512_storeu_si512((__m512i *)&a[j + 16], f1);
+    }
+  }
+
+  /* Layers with len >= 16 */
+  k = N/16;
+  for(len = 16; len < N; len <<= 1) {
+    for(start = 0; start < N; start = j + len) {
+      zeta = _mm512_set1_epi32(zetas_inv[N - k--]);
+      for(j = start; j < start + len; j += 16) {
+        f0 = _mm512_loadu_si512((const __m512i *)&a[j]);
+        f1 = _mm512_loadu_si512((const __m512i *)&a[j + len]);
+        t = f0;
+        f0 = _mm512_add_epi32(t, f1);
+        f1 = _mm512_sub_epi32(t, f1);
+        f1 = montmul_avx512(zeta, f1);
+        _mm512_storeu_si512((__m512i *)&a[j], f0);
+        _mm512_storeu_si512((__m512i *)&a[j + len], f1);
+      }
+    }
+  }
+
+  for(j = 0; j < N; j += 16) {
+    f0 = _mm512_loadu_si512((const __m512i *)&a[j]);
+    f0 = montmul_avx512(f, f0);
+    _mm512_storeu_si512((__m512i *)&a[j], f0);
+  }
+}
@@ -0,0 +1 @@
+../ref/ntt.h
\ No newline at end of file
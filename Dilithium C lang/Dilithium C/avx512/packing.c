@@ -0,0 +1 @@
+../ref/packing.c
\ No newline at end of file
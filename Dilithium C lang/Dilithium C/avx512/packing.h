@@ -0,0 +1 @@
+../ref/packing.h
\ No newline at end of file
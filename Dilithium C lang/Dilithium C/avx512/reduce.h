@@ -0,0 +1 @@
+../ref/reduce.h
\ No newline at end of file
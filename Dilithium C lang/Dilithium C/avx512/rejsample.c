@@ -0,0 +1,145 @@
+#include <stdint.h>
+#include <immintrin.h>
+#include "params.h"
+#include "rejsample.h"
+#include "symmetric.h"
+
+/*************************************************
+* Name:        rej_uniform_avx512
+*
+* Description: Sample uniformly random coefficients in [0, Q-1] by
+*              performing rejection sampling on array of random bytes.
+*              Handles 16 candidates (48 bytes) per iteration and falls
+*              back to the scalar loop for the tail, so the output is
+*              identical to the reference rej_uniform.
+*
+* Arguments:   - int32_t *a: pointer to output array (allocated)
+*              - unsigned int len: number of coefficients to be sampled
+*              - const uint8_t *buf: array of random bytes
+*              - unsigned int buflen: length of array of random bytes
+*
+* Returns number of sampled coefficients. Can be smaller than len if not enough
+* random bytes were given.
+**************************************************/
+unsigned int rej_uniform_avx512(int32_t *a,
+                                unsigned int len,
+                                const uint8_t *buf,
+                                unsigned int buflen)
+{
+  unsigned int ctr, pos;
+  uint32_t t;
+  __m512i d;
+  __mmask16 good;
+  const __m512i bound = _mm512_set1_epi32(Q);
+  const __m512i mask  = _mm512_set1_epi32(0x7FFFFF);
+  /* Move the 12 bytes of four candidates into each 128-bit lane */
+  const __m512i idx = _mm512_set_epi32(11, 11, 10, 9, 8, 8, 7, 6,
+                                       5, 5, 4, 3, 2, 2, 1, 0);
+  /* and spread each 3-byte candidate over a 32-bit word */
+  const __m512i shuf = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1,
+                                                            6, 7, 8, -1, 9, 10, 11, -1));
+
+  ctr = pos = 0;
+  while(ctr + 16 <= len && pos + 48 <= buflen) {
+    d = _mm512_maskz_loadu_epi8(0xFFFFFFFFFFFFULL, &buf[pos]);
+    d = _mm512_permutexvar_epi32(idx, d);
+    d = _mm512_shuffle_epi8(d, shuf);
+    d = _mm512_and_si512(d, mask);
+    pos += 48;
+
+    good = _mm512_cmplt_epi32_mask(d, bound);
+    _mm512_mask_compressstoreu_epi32(&a[ctr], good, d);
+    ctr += _mm_popcnt_u32(good);
+  }
+
+  while(ctr < len && pos + 3 <= buflen) {
+    t  = buf[pos++];
+    t |= (uint32_t)buf[pos++] << 8;
+    t |= (uint32_t)buf[pos++] << 16;
+    t &= 0x7FFFFF;
+
+    if(t < Q)
+      a[ctr++] = t;
+  }
+
+  return ctr;
+}
+
+/*************************************************
+* Name:        rej_eta_avx512
+*
+* Description: Sample uniformly random coefficients in [-ETA, ETA] by
+*              performing rejection sampling on array of random bytes.
+*              Handles 16 nibbles (8 bytes) per iteration and produces the
+*              same output as the reference rej_eta.
+*
+* Arguments:   - int32_t *a: pointer to output array (allocated)
+*              - unsigned int len: number of coefficients to be sampled
+*              - const uint8_t *buf: array of random bytes
+*              - unsigned int buflen: length of array of random bytes
+*
+* Returns number of sampled coefficients. Can be smaller than len if not enough
+* random bytes were given.
+**************************************************/
+unsigned int rej_eta_avx512(int32_t *a,
+                            unsigned int len,
+                            const uint8_t *buf,
+                            unsigned int buflen)
+{
+  unsigned int ctr, pos;
+  uint32_t t0, t1;
+  __m128i b, lo, hi;
+  __m512i d;
+  __mmask16 good;
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+  const __m512i eta = _mm512_set1_epi32(ETA);
+#if ETA == 2
+  const __m512i bound = _mm512_set1_epi32(15);
+  const __m512i v205 = _mm512_set1_epi32(205);
+  const __m512i v5 = _mm512_set1_epi32(5);
+  __m512i f;
+#elif ETA == 4
+  const __m512i bound = _mm512_set1_epi32(9);
+#endif
+
+  ctr = pos = 0;
+  while(ctr + 16 <= len && pos + 8 <= buflen) {
+    b = _mm_loadl_epi64((const __m128i *)&buf[pos]);
+    lo = _mm_and_si128(b, nibble);
+    hi = _mm_and_si128(_mm_srli_epi16(b, 4), nibble);
+    d = _mm512_cvtepu8_epi32(_mm_unpacklo_epi8(lo, hi));
+    pos += 8;
+
+    good = _mm512_cmplt_epu32_mask(d, bound);
+#if ETA == 2
+    f = _mm512_srli_epi32(_mm512_mullo_epi32(d, v205), 10);
+    d = _mm512_sub_epi32(d, _mm512_mullo_epi32(f, v5));
+#endif
+    d = _mm512_sub_epi32(eta, d);
+    _mm512_mask_compressstoreu_epi32(&a[ctr], good, d);
+    ctr += _mm_popcnt_u32(good);
+  }
+
+  while(ctr < len && pos < buflen) {
+    t0 = buf[pos] & 0x0F;
+    t1 = buf[pos++] >> 4;
+
+#if ETA == 2
+    if(t0 < 15) {
+      t0 = t0 - (205*t0 >> 10)*5;
+      a[ctr++] = 2 - t0;
+    }
+    if(t1 < 15 && ctr < len) {
+      t1 = t1 - (205*t1 >> 10)*5;
+      a[ctr++] = 2 - t1;
+    }
+#elif ETA == 4
+    if(t0 < 9)
+      a[ctr++] = 4 - t0;
+    if(t1 < 9 && ctr < len)
+      a[ctr++] = 4 - t1;
+#endif
+  }
+
+  return ctr;
+}
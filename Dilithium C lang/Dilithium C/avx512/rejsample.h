@@ -0,0 +1,30 @@
+#ifndef REJSAMPLE_H
+#define REJSAMPLE_H
+
+#include <stdint.h>
+#include "params.h"
+#include "symmetric.h"
+
+#define REJ_UNIFORM_NBLOCKS ((768+STREAM128_BLOCKBYTES-1)/STREAM128_BLOCKBYTES)
+#define REJ_UNIFORM_BUFLEN (REJ_UNIFORM_NBLOCKS*STREAM128_BLOCKBYTES)
+
+#if ETA == 2
+#define REJ_UNIFORM_ETA_NBLOCKS ((136+STREAM256_BLOCKBYTES-1)/STREAM256_BLOCKBYTES)
+#elif ETA == 4
+#define REJ_UNIFORM_ETA_NBLOCKS ((227+STREAM256_BLOCKBYTES-1)/STREAM256_BLOCKBYTES)
+#endif
+#define REJ_UNIFORM_ETA_BUFLEN (REJ_UNIFORM_ETA_NBLOCKS*STREAM256_BLOCKBYTES)
+
+#define rej_uniform_avx512 DILITHIUM_NAMESPACE(rej_uniform_avx512)
+unsigned int rej_uniform_avx512(int32_t *a,
+                                unsigned int len,
+                                const uint8_t *buf,
+                                unsigned int buflen);
+
+#define rej_eta_avx512 DILITHIUM_NAMESPACE(rej_eta_avx512)
+unsigned int rej_eta_avx512(int32_t *a,
+                            unsigned int len,
+                            const uint8_t *buf,
+                            unsigned int buflen);
+
+#endif
@@ -0,0 +1 @@
+../ref/rounding.c
\ No newline at end of file
@@ -0,0 +1 @@
+../ref/rounding.h
\ No newline at end of file
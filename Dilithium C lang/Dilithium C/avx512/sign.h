@@ -0,0 +1 @@
+../ref/sign.h
\ No newline at end of file
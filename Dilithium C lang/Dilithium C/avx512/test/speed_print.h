@@ -0,0 +1 @@
+../../ref/test/speed_print.h
\ No newline at end of file
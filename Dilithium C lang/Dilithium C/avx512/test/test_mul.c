@@ -0,0 +1 @@
+../../ref/test/test_mul.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../ref/test/test_speed.c
\ No newline at end of file
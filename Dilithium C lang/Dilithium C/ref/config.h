@@ -3,6 +3,7 @@
 
 //#define DILITHIUM_MODE 2
 #define DILITHIUM_RANDOMIZED_SIGNING
+#define DILITHIUM_LAZY_MATRIX
 //#define USE_RDPMC
 //#define DBENCH
 
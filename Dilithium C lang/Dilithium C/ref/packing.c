@@ -235,3 +235,39 @@ int unpack_sig(uint8_t c[CTILDEBYTES],
 
   return 0;
 }
+
+/*************************************************
+* Name:        check_sig_hint
+*
+* Description: Check the encoding of the hint vector h in a packed
+*              signature without decoding it. Applies the same rules as
+*              unpack_sig().
+*
+* Arguments:   - const uint8_t sig[]: byte array containing
+*                bit-packed signature
+*
+* Returns 1 in case of malformed hint encoding; otherwise 0.
+**************************************************/
+int check_sig_hint(const uint8_t sig[CRYPTO_BYTES]) {
+  unsigned int i, j, k;
+
+  sig += CTILDEBYTES + L*POLYZ_PACKEDBYTES;
+
+  k = 0;
+  for(i = 0; i < K; ++i) {
+    if(sig[OMEGA + i] < k || sig[OMEGA + i] > OMEGA)
+      return 1;
+
+    for(j = k + 1; j < sig[OMEGA + i]; ++j)
+      if(sig[j] <= sig[j-1])
+        return 1;
+
+    k = sig[OMEGA + i];
+  }
+
+  for(j = k; j < OMEGA; ++j)
+    if(sig[j])
+      return 1;
+
+  return 0;
+}
@@ -35,4 +35,7 @@ void unpack_sk(uint8_t rho[SEEDBYTES],
 #define unpack_sig DILITHIUM_NAMESPACE(unpack_sig)
 int unpack_sig(uint8_t c[CTILDEBYTES], polyvecl *z, polyveck *h, const uint8_t sig[CRYPTO_BYTES]);
 
+#define check_sig_hint DILITHIUM_NAMESPACE(check_sig_hint)
+int check_sig_hint(const uint8_t sig[CRYPTO_BYTES]);
+
 #endif
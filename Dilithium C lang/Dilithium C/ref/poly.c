@@ -875,6 +875,45 @@ void polyz_unpack(poly *r, const uint8_t *a) {
   DBENCH_STOP(*tpack);
 }
 
+/*************************************************
+* Name:        polyz_packed_chknorm
+*
+* Description: Check infinity norm of a bit-packed polynomial z directly
+*              on the packed bytes, without unpacking it.
+*
+* Arguments:   - const uint8_t *a: byte array with bit-packed polynomial
+*              - int32_t B: norm bound
+*
+* Returns 0 if norm is strictly smaller than B and 1 otherwise.
+**************************************************/
+int polyz_packed_chknorm(const uint8_t *a, int32_t B) {
+  unsigned int i, off;
+  uint32_t t;
+  DBENCH_START();
+
+  for(i = 0; i < N; ++i) {
+#if GAMMA1 == (1 << 17)
+    off = 18*i;
+#elif GAMMA1 == (1 << 19)
+    off = 20*i;
+#endif
+    t  = a[off/8];
+    t |= (uint32_t)a[off/8+1] << 8;
+    t |= (uint32_t)a[off/8+2] << 16;
+    t >>= off%8;
+    t &= 2*GAMMA1 - 1;
+
+    /* Coefficient is GAMMA1 - t, short iff GAMMA1 - B < t < GAMMA1 + B */
+    if(t - (GAMMA1 - B + 1) >= (uint32_t)(2*B - 1)) {
+      DBENCH_STOP(*tpack);
+      return 1;
+    }
+  }
+
+  DBENCH_STOP(*tpack);
+  return 0;
+}
+
 /*************************************************
 * Name:        polyw1_pack
 *
@@ -28,6 +28,37 @@ void polyvec_matrix_pointwise_montgomery(polyveck *t, const polyvecl mat[K], con
     polyvecl_pointwise_acc_montgomery(&t->vec[i], &mat[i], v);
 }
 
+/*************************************************
+* Name:        polyvec_matrix_expand_pointwise_montgomery
+*
+* Description: Compute t = A*v without materializing A. Each entry a_{i,j}
+*              is sampled into a single scratch polynomial and immediately
+*              multiplied into row i, so only one polynomial of A is live
+*              at a time. Gives the same result as polyvec_matrix_expand()
+*              followed by polyvec_matrix_pointwise_montgomery().
+*
+* Arguments:   - polyveck *t: pointer to output vector
+*              - const uint8_t rho[]: byte array containing seed rho
+*              - const polyvecl *v: pointer to input vector in NTT domain
+**************************************************/
+void polyvec_matrix_expand_pointwise_montgomery(polyveck *t,
+                                                const uint8_t rho[SEEDBYTES],
+                                                const polyvecl *v)
+{
+  unsigned int i, j;
+  poly a;
+
+  for(i = 0; i < K; ++i) {
+    poly_uniform(&a, rho, (i << 8) + 0);
+    poly_pointwise_montgomery(&t->vec[i], &a, &v->vec[0]);
+    for(j = 1; j < L; ++j) {
+      poly_uniform(&a, rho, (i << 8) + j);
+      poly_pointwise_montgomery(&a, &a, &v->vec[j]);
+      poly_add(&t->vec[i], &t->vec[i], &a);
+    }
+  }
+}
+
 /**************************************************************/
 /************ Vectors of polynomials of length L **************/
 /**************************************************************/
@@ -90,4 +90,7 @@ void polyvec_matrix_expand(polyvecl mat[K], const uint8_t rho[SEEDBYTES]);
 #define polyvec_matrix_pointwise_montgomery DILITHIUM_NAMESPACE(polyvec_matrix_pointwise_montgomery)
 void polyvec_matrix_pointwise_montgomery(polyveck *t, const polyvecl mat[K], const polyvecl *v);
 
+#define polyvec_matrix_expand_pointwise_montgomery DILITHIUM_NAMESPACE(polyvec_matrix_expand_pointwise_montgomery)
+void polyvec_matrix_expand_pointwise_montgomery(polyveck *t, const uint8_t rho[SEEDBYTES], const polyvecl *v);
+
 #endif
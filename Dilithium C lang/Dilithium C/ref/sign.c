@@ -1,4 +1,5 @@
 #include <stdint.h>
+#include <string.h>
 #include "params.h"
 #include "sign.h"
 #include "packing.h"
@@ -8,6 +9,145 @@
 #include "symmetric.h"
 #include "fips202.h"
 
+/*************************************************
+* Name:        sign_expanded
+*
+* Description: Rejection-sampling loop of the signing algorithm, on a key
+*              whose matrix and secret vectors are already expanded.
+*
+* Arguments:   - uint8_t *sig:          pointer to output signature (of length CRYPTO_BYTES)
+*              - const uint8_t *mu:       pointer to message representative
+*              - const uint8_t *rhoprime: pointer to CRH(key, rnd, mu)
+*              - const polyvecl mat[K]:   expanded matrix A
+*              - const polyvecl *s1:      s1 in NTT domain
+*              - const polyveck *s2:      s2 in NTT domain
+*              - const polyveck *t0:      t0 in NTT domain
+**************************************************/
+static void sign_expanded(uint8_t *sig,
+                          const uint8_t mu[CRHBYTES],
+                          const uint8_t rhoprime[CRHBYTES],
+                          const polyvecl mat[K],
+                          const polyvecl *s1,
+                          const polyveck *s2,
+                          const polyveck *t0)
+{
+  unsigned int n;
+  uint16_t nonce = 0;
+  polyvecl y, z;
+  polyveck w1, w0, h;
+  poly cp;
+  keccak_state state;
+
+rej:
+  /* Sample intermediate vector y */
+  polyvecl_uniform_gamma1(&y, rhoprime, nonce++);
+
+  /* Matrix-vector multiplication */
+  z = y;
+  polyvecl_ntt(&z);
+  polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
+  polyveck_reduce(&w1);
+  polyveck_invntt_tomont(&w1);
+
+  /* Decompose w and call the random oracle */
+  polyveck_caddq(&w1);
+  polyveck_decompose(&w1, &w0, &w1);
+  polyveck_pack_w1(sig, &w1);
+
+  shake256_init(&state);
+  shake256_absorb(&state, mu, CRHBYTES);
+  shake256_absorb(&state, sig, K*POLYW1_PACKEDBYTES);
+  shake256_finalize(&state);
+  shake256_squeeze(sig, CTILDEBYTES, &state);
+  poly_challenge(&cp, sig);
+  poly_ntt(&cp);
+
+  /* Compute z, reject if it reveals secret */
+  polyvecl_pointwise_poly_montgomery(&z, &cp, s1);
+  polyvecl_invntt_tomont(&z);
+  polyvecl_add(&z, &z, &y);
+  polyvecl_reduce(&z);
+  if(polyvecl_chknorm(&z, GAMMA1 - BETA))
+    goto rej;
+
+  /* Check that subtracting cs2 does not change high bits of w and low bits
+   * do not reveal secret information */
+  polyveck_pointwise_poly_montgomery(&h, &cp, s2);
+  polyveck_invntt_tomont(&h);
+  polyveck_sub(&w0, &w0, &h);
+  polyveck_reduce(&w0);
+  if(polyveck_chknorm(&w0, GAMMA2 - BETA))
+    goto rej;
+
+  /* Compute hints for w1 */
+  polyveck_pointwise_poly_montgomery(&h, &cp, t0);
+  polyveck_invntt_tomont(&h);
+  polyveck_reduce(&h);
+  if(polyveck_chknorm(&h, GAMMA2))
+    goto rej;
+
+  polyveck_add(&w0, &w0, &h);
+  n = polyveck_make_hint(&h, &w0, &w1);
+  if(n > OMEGA)
+    goto rej;
+
+  /* Write signature */
+  pack_sig(sig, sig, &z, &h);
+}
+
+/*************************************************
+* Name:        verify_challenge
+*
+* Description: Second half of verification: recomputes w1 from Az, the
+*              challenge and t1, and checks it against the challenge hash.
+*
+* Arguments:   - const uint8_t *c:   challenge hash of the signature
+*              - poly *cp:           challenge polynomial of c, in normal
+*                                    domain; transformed in place
+*              - polyveck *w1:       Az in NTT domain; overwritten
+*              - polyveck *t1:       t1*2^d in NTT domain; overwritten
+*              - const polyveck *h:  hint vector of the signature
+*              - const uint8_t *mu:  message representative
+*
+* Returns 0 if the challenge matches and -1 otherwise
+**************************************************/
+static int verify_challenge(const uint8_t c[CTILDEBYTES],
+                            poly *cp,
+                            polyveck *w1,
+                            polyveck *t1,
+                            const polyveck *h,
+                            const uint8_t mu[CRHBYTES])
+{
+  unsigned int i;
+  uint8_t buf[K*POLYW1_PACKEDBYTES];
+  uint8_t c2[CTILDEBYTES];
+  keccak_state state;
+
+  poly_ntt(cp);
+  polyveck_pointwise_poly_montgomery(t1, cp, t1);
+
+  polyveck_sub(w1, w1, t1);
+  polyveck_reduce(w1);
+  polyveck_invntt_tomont(w1);
+
+  /* Reconstruct w1 */
+  polyveck_caddq(w1);
+  polyveck_use_hint(w1, w1, h);
+  polyveck_pack_w1(buf, w1);
+
+  /* Call random oracle and verify challenge */
+  shake256_init(&state);
+  shake256_absorb(&state, mu, CRHBYTES);
+  shake256_absorb(&state, buf, K*POLYW1_PACKEDBYTES);
+  shake256_finalize(&state);
+  shake256_squeeze(c2, CTILDEBYTES, &state);
+  for(i = 0; i < CTILDEBYTES; ++i)
+    if(c[i] != c2[i])
+      return -1;
+
+  return 0;
+}
+
 /*************************************************
 * Name:        crypto_sign_keypair
 *
@@ -24,7 +164,9 @@ int crypto_sign_keypair(uint8_t *pk, uint8_t *sk) {
   uint8_t seedbuf[2*SEEDBYTES + CRHBYTES];
   uint8_t tr[TRBYTES];
   const uint8_t *rho, *rhoprime, *key;
+#ifndef DILITHIUM_LAZY_MATRIX
   polyvecl mat[K];
+#endif
   polyvecl s1, s1hat;
   polyveck s2, t1, t0;
 
@@ -37,16 +179,143 @@ int crypto_sign_keypair(uint8_t *pk, uint8_t *sk) {
   rhoprime = rho + SEEDBYTES;
   key = rhoprime + CRHBYTES;
 
-  /* Expand matrix */
+  /* Sample short vectors s1 and s2 */
+  polyvecl_uniform_eta(&s1, rhoprime, 0);
+  polyveck_uniform_eta(&s2, rhoprime, L);
+
+  /* Matrix-vector multiplication */
+  s1hat = s1;
+  polyvecl_ntt(&s1hat);
+#ifdef DILITHIUM_LAZY_MATRIX
+  polyvec_matrix_expand_pointwise_montgomery(&t1, rho, &s1hat);
+#else
   polyvec_matrix_expand(mat, rho);
+  polyvec_matrix_pointwise_montgomery(&t1, mat, &s1hat);
+#endif
+  polyveck_reduce(&t1);
+  polyveck_invntt_tomont(&t1);
+
+  /* Add error vector s2 */
+  polyveck_add(&t1, &t1, &s2);
+
+  /* Extract t1 and write public key */
+  polyveck_caddq(&t1);
+  polyveck_power2round(&t1, &t0, &t1);
+  pack_pk(pk, rho, &t1);
+
+  /* Compute H(rho, t1) and write secret key */
+  shake256(tr, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
+  pack_sk(sk, rho, tr, key, &t0, &s1, &s2);
+
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_keypair_pk
+*
+* Description: Generates only the public key. Given the SEEDBYTES that
+*              crypto_sign_keypair draws from randombytes, returns the same
+*              public key, but skips everything that exists only for the
+*              secret key: t0 and s1/s2 packing and tr = H(pk).
+*
+* Arguments:   - uint8_t *pk: pointer to output public key (allocated
+*                             array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - const uint8_t seed[]: keygen randomness (of length SEEDBYTES)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_sign_keypair_pk(uint8_t *pk, const uint8_t seed[SEEDBYTES]) {
+  uint8_t seedbuf[2*SEEDBYTES + CRHBYTES];
+  const uint8_t *rho, *rhoprime;
+#ifndef DILITHIUM_LAZY_MATRIX
+  polyvecl mat[K];
+#endif
+  polyvecl s1;
+  polyveck s2, t1, t0;
+
+  /* Expand seed to rho and rhoprime */
+  memcpy(seedbuf, seed, SEEDBYTES);
+  seedbuf[SEEDBYTES+0] = K;
+  seedbuf[SEEDBYTES+1] = L;
+  shake256(seedbuf, 2*SEEDBYTES + CRHBYTES, seedbuf, SEEDBYTES+2);
+  rho = seedbuf;
+  rhoprime = rho + SEEDBYTES;
 
   /* Sample short vectors s1 and s2 */
   polyvecl_uniform_eta(&s1, rhoprime, 0);
   polyveck_uniform_eta(&s2, rhoprime, L);
 
-  /* Matrix-vector multiplication */
+  /* Matrix-vector multiplication; s1 itself is not needed afterwards */
+  polyvecl_ntt(&s1);
+#ifdef DILITHIUM_LAZY_MATRIX
+  polyvec_matrix_expand_pointwise_montgomery(&t1, rho, &s1);
+#else
+  polyvec_matrix_expand(mat, rho);
+  polyvec_matrix_pointwise_montgomery(&t1, mat, &s1);
+#endif
+  polyveck_reduce(&t1);
+  polyveck_invntt_tomont(&t1);
+
+  /* Add error vector s2 */
+  polyveck_add(&t1, &t1, &s2);
+
+  /* Extract t1 and write public key */
+  polyveck_caddq(&t1);
+  polyveck_power2round(&t1, &t0, &t1);
+  pack_pk(pk, rho, &t1);
+
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_keypair_pct
+*
+* Description: Generates public and private key from the SEEDBYTES that
+*              crypto_sign_keypair draws from randombytes, then runs a
+*              pairwise consistency test: signs a fixed message and verifies
+*              the signature. The test reuses the expanded matrix and the
+*              NTT-domain s1, s2, t0 and t1 of key generation, so it costs
+*              one signing loop and one matrix-vector product on top of it.
+*              Signing is deterministic (rnd = 0) and draws no randomness.
+*
+* Arguments:   - uint8_t *pk: pointer to output public key (allocated
+*                             array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk: pointer to output private key (allocated
+*                             array of CRYPTO_SECRETKEYBYTES bytes)
+*              - const uint8_t seed[]: keygen randomness (of length SEEDBYTES)
+*
+* Returns 0 (success) or -1 if the test fails; pk and sk are zeroed then
+**************************************************/
+int crypto_sign_keypair_pct(uint8_t *pk, uint8_t *sk, const uint8_t seed[SEEDBYTES]) {
+  static const uint8_t msg[] = "pairwise consistency test";
+  uint8_t seedbuf[2*SEEDBYTES + CRHBYTES];
+  uint8_t tr[TRBYTES];
+  uint8_t mu[CRHBYTES], rhoprime[CRHBYTES];
+  uint8_t rnd[RNDBYTES] = {0};
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t c[CTILDEBYTES];
+  const uint8_t *rho, *key;
+  polyvecl mat[K], s1, s1hat, z;
+  polyveck s2, t1, t0, w1, h;
+  poly cp;
+  keccak_state state;
+
+  /* Expand seed to rho, rhoprime and key */
+  memcpy(seedbuf, seed, SEEDBYTES);
+  seedbuf[SEEDBYTES+0] = K;
+  seedbuf[SEEDBYTES+1] = L;
+  shake256(seedbuf, 2*SEEDBYTES + CRHBYTES, seedbuf, SEEDBYTES+2);
+  rho = seedbuf;
+  key = rho + SEEDBYTES + CRHBYTES;
+
+  /* Sample short vectors s1 and s2 */
+  polyvecl_uniform_eta(&s1, rho + SEEDBYTES, 0);
+  polyveck_uniform_eta(&s2, rho + SEEDBYTES, L);
+
+  /* Matrix-vector multiplication; the matrix is kept for the test */
   s1hat = s1;
   polyvecl_ntt(&s1hat);
+  polyvec_matrix_expand(mat, rho);
   polyvec_matrix_pointwise_montgomery(&t1, mat, &s1hat);
   polyveck_reduce(&t1);
   polyveck_invntt_tomont(&t1);
@@ -63,58 +332,114 @@ int crypto_sign_keypair(uint8_t *pk, uint8_t *sk) {
   shake256(tr, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
   pack_sk(sk, rho, tr, key, &t0, &s1, &s2);
 
+  /* Sign the test message with the key still in NTT domain */
+  crypto_sign_compute_mu(mu, tr, msg, sizeof(msg) - 1, NULL, 0);
+  shake256_init(&state);
+  shake256_absorb(&state, key, SEEDBYTES);
+  shake256_absorb(&state, rnd, RNDBYTES);
+  shake256_absorb(&state, mu, CRHBYTES);
+  shake256_finalize(&state);
+  shake256_squeeze(rhoprime, CRHBYTES, &state);
+
+  polyveck_ntt(&s2);
+  polyveck_ntt(&t0);
+  sign_expanded(sig, mu, rhoprime, mat, &s1hat, &s2, &t0);
+
+  /* Verify it from the packed signature against the kept matrix and t1 */
+  if(unpack_sig(c, &z, &h, sig) || polyvecl_chknorm(&z, GAMMA1 - BETA))
+    goto fail;
+  poly_challenge(&cp, c);
+  polyvecl_ntt(&z);
+  polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
+  polyveck_shiftl(&t1);
+  polyveck_ntt(&t1);
+  if(verify_challenge(c, &cp, &w1, &t1, &h, mu))
+    goto fail;
+
   return 0;
+
+fail:
+  memset(pk, 0, CRYPTO_PUBLICKEYBYTES);
+  memset(sk, 0, CRYPTO_SECRETKEYBYTES);
+  return -1;
 }
 
 /*************************************************
-* Name:        crypto_sign_signature_internal
+* Name:        crypto_sign_compute_mu
 *
-* Description: Computes signature. Internal API.
+* Description: Computes the message representative mu = CRH(tr, pre, msg)
+*              with pre = (0, ctxlen, ctx). The result can be passed to
+*              crypto_sign_signature_mu and crypto_sign_verify_mu, so a
+*              message has to be hashed only once per public key.
+*
+* Arguments:   - uint8_t *mu: pointer to output message representative
+*                             (of length CRHBYTES)
+*              - const uint8_t *tr: pointer to H(pk) (of length TRBYTES),
+*                                   also stored in the secret key
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int crypto_sign_compute_mu(uint8_t mu[CRHBYTES],
+                           const uint8_t tr[TRBYTES],
+                           const uint8_t *m,
+                           size_t mlen,
+                           const uint8_t *ctx,
+                           size_t ctxlen)
+{
+  uint8_t pre[2];
+  keccak_state state;
+
+  if(ctxlen > 255)
+    return -1;
+
+  pre[0] = 0;
+  pre[1] = ctxlen;
+  shake256_init(&state);
+  shake256_absorb(&state, tr, TRBYTES);
+  shake256_absorb(&state, pre, 2);
+  shake256_absorb(&state, ctx, ctxlen);
+  shake256_absorb(&state, m, mlen);
+  shake256_finalize(&state);
+  shake256_squeeze(mu, CRHBYTES, &state);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_mu_internal
+*
+* Description: Computes signature from the message representative
+*              mu = CRH(tr, pre, msg). Internal API.
 *
 * Arguments:   - uint8_t *sig:   pointer to output signature (of length CRYPTO_BYTES)
 *              - size_t *siglen: pointer to output length of signature
-*              - uint8_t *m:     pointer to message to be signed
-*              - size_t mlen:    length of message
-*              - uint8_t *pre:   pointer to prefix string
-*              - size_t prelen:  length of prefix string
+*              - uint8_t *mu:    pointer to message representative
 *              - uint8_t *rnd:   pointer to random seed
 *              - uint8_t *sk:    pointer to bit-packed secret key
 *
 * Returns 0 (success)
 **************************************************/
-int crypto_sign_signature_internal(uint8_t *sig,
-                                   size_t *siglen,
-                                   const uint8_t *m,
-                                   size_t mlen,
-                                   const uint8_t *pre,
-                                   size_t prelen,
-                                   const uint8_t rnd[RNDBYTES],
-                                   const uint8_t *sk)
+int crypto_sign_signature_mu_internal(uint8_t *sig,
+                                      size_t *siglen,
+                                      const uint8_t mu[CRHBYTES],
+                                      const uint8_t rnd[RNDBYTES],
+                                      const uint8_t *sk)
 {
-  unsigned int n;
-  uint8_t seedbuf[2*SEEDBYTES + TRBYTES + 2*CRHBYTES];
-  uint8_t *rho, *tr, *key, *mu, *rhoprime;
-  uint16_t nonce = 0;
-  polyvecl mat[K], s1, y, z;
-  polyveck t0, s2, w1, w0, h;
-  poly cp;
+  uint8_t seedbuf[2*SEEDBYTES + TRBYTES + CRHBYTES];
+  uint8_t *rho, *tr, *key, *rhoprime;
+  polyvecl mat[K], s1;
+  polyveck t0, s2;
   keccak_state state;
 
   rho = seedbuf;
   tr = rho + SEEDBYTES;
   key = tr + TRBYTES;
-  mu = key + SEEDBYTES;
-  rhoprime = mu + CRHBYTES;
+  rhoprime = key + SEEDBYTES;
   unpack_sk(rho, tr, key, &t0, &s1, &s2, sk);
 
-  /* Compute mu = CRH(tr, pre, msg) */
-  shake256_init(&state);
-  shake256_absorb(&state, tr, TRBYTES);
-  shake256_absorb(&state, pre, prelen);
-  shake256_absorb(&state, m, mlen);
-  shake256_finalize(&state);
-  shake256_squeeze(mu, CRHBYTES, &state);
-
   /* Compute rhoprime = CRH(key, rnd, mu) */
   shake256_init(&state);
   shake256_absorb(&state, key, SEEDBYTES);
@@ -129,63 +454,48 @@ int crypto_sign_signature_internal(uint8_t *sig,
   polyveck_ntt(&s2);
   polyveck_ntt(&t0);
 
-rej:
-  /* Sample intermediate vector y */
-  polyvecl_uniform_gamma1(&y, rhoprime, nonce++);
-
-  /* Matrix-vector multiplication */
-  z = y;
-  polyvecl_ntt(&z);
-  polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
-  polyveck_reduce(&w1);
-  polyveck_invntt_tomont(&w1);
-
-  /* Decompose w and call the random oracle */
-  polyveck_caddq(&w1);
-  polyveck_decompose(&w1, &w0, &w1);
-  polyveck_pack_w1(sig, &w1);
-
-  shake256_init(&state);
-  shake256_absorb(&state, mu, CRHBYTES);
-  shake256_absorb(&state, sig, K*POLYW1_PACKEDBYTES);
-  shake256_finalize(&state);
-  shake256_squeeze(sig, CTILDEBYTES, &state);
-  poly_challenge(&cp, sig);
-  poly_ntt(&cp);
-
-  /* Compute z, reject if it reveals secret */
-  polyvecl_pointwise_poly_montgomery(&z, &cp, &s1);
-  polyvecl_invntt_tomont(&z);
-  polyvecl_add(&z, &z, &y);
-  polyvecl_reduce(&z);
-  if(polyvecl_chknorm(&z, GAMMA1 - BETA))
-    goto rej;
-
-  /* Check that subtracting cs2 does not change high bits of w and low bits
-   * do not reveal secret information */
-  polyveck_pointwise_poly_montgomery(&h, &cp, &s2);
-  polyveck_invntt_tomont(&h);
-  polyveck_sub(&w0, &w0, &h);
-  polyveck_reduce(&w0);
-  if(polyveck_chknorm(&w0, GAMMA2 - BETA))
-    goto rej;
+  sign_expanded(sig, mu, rhoprime, mat, &s1, &s2, &t0);
+  *siglen = CRYPTO_BYTES;
+  return 0;
+}
 
-  /* Compute hints for w1 */
-  polyveck_pointwise_poly_montgomery(&h, &cp, &t0);
-  polyveck_invntt_tomont(&h);
-  polyveck_reduce(&h);
-  if(polyveck_chknorm(&h, GAMMA2))
-    goto rej;
+/*************************************************
+* Name:        crypto_sign_signature_internal
+*
+* Description: Computes signature. Internal API.
+*
+* Arguments:   - uint8_t *sig:   pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - uint8_t *m:     pointer to message to be signed
+*              - size_t mlen:    length of message
+*              - uint8_t *pre:   pointer to prefix string
+*              - size_t prelen:  length of prefix string
+*              - uint8_t *rnd:   pointer to random seed
+*              - uint8_t *sk:    pointer to bit-packed secret key
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_sign_signature_internal(uint8_t *sig,
+                                   size_t *siglen,
+                                   const uint8_t *m,
+                                   size_t mlen,
+                                   const uint8_t *pre,
+                                   size_t prelen,
+                                   const uint8_t rnd[RNDBYTES],
+                                   const uint8_t *sk)
+{
+  uint8_t mu[CRHBYTES];
+  keccak_state state;
 
-  polyveck_add(&w0, &w0, &h);
-  n = polyveck_make_hint(&h, &w0, &w1);
-  if(n > OMEGA)
-    goto rej;
+  /* Compute mu = CRH(tr, pre, msg) */
+  shake256_init(&state);
+  shake256_absorb(&state, sk + 2*SEEDBYTES, TRBYTES);
+  shake256_absorb(&state, pre, prelen);
+  shake256_absorb(&state, m, mlen);
+  shake256_finalize(&state);
+  shake256_squeeze(mu, CRHBYTES, &state);
 
-  /* Write signature */
-  pack_sig(sig, sig, &z, &h);
-  *siglen = CRYPTO_BYTES;
-  return 0;
+  return crypto_sign_signature_mu_internal(sig, siglen, mu, rnd, sk);
 }
 
 /*************************************************
@@ -235,6 +545,115 @@ int crypto_sign_signature(uint8_t *sig,
   return 0;
 }
 
+/*************************************************
+* Name:        crypto_sign_signature_mu
+*
+* Description: Computes signature from a precomputed message
+*              representative mu = CRH(tr, pre, msg), see
+*              crypto_sign_compute_mu.
+*
+* Arguments:   - uint8_t *sig: pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen: pointer to output length of signature
+*              - const uint8_t *mu: pointer to message representative
+*              - const uint8_t *sk: pointer to bit-packed secret key
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_sign_signature_mu(uint8_t *sig,
+                             size_t *siglen,
+                             const uint8_t mu[CRHBYTES],
+                             const uint8_t *sk)
+{
+  uint8_t rnd[RNDBYTES];
+#ifndef DILITHIUM_RANDOMIZED_SIGNING
+  unsigned int i;
+#endif
+
+#ifdef DILITHIUM_RANDOMIZED_SIGNING
+  randombytes(rnd, RNDBYTES);
+#else
+  for(i = 0; i < RNDBYTES; i++)
+    rnd[i] = 0;
+#endif
+
+  return crypto_sign_signature_mu_internal(sig, siglen, mu, rnd, sk);
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_init
+*
+* Description: Starts an incremental signature computation. The message
+*              is passed in pieces to crypto_sign_signature_update and
+*              the signature is produced by crypto_sign_signature_final.
+*
+* Arguments:   - keccak_state *state: pointer to output hashing state
+*              - uint8_t *ctx:        pointer to context string
+*              - size_t ctxlen:       length of context string
+*              - uint8_t *sk:         pointer to bit-packed secret key
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int crypto_sign_signature_init(keccak_state *state,
+                               const uint8_t *ctx,
+                               size_t ctxlen,
+                               const uint8_t *sk)
+{
+  uint8_t pre[2];
+
+  if(ctxlen > 255)
+    return -1;
+
+  /* Absorb tr and pre = (0, ctxlen, ctx) */
+  pre[0] = 0;
+  pre[1] = ctxlen;
+  shake256_init(state);
+  shake256_absorb(state, sk + 2*SEEDBYTES, TRBYTES);
+  shake256_absorb(state, pre, 2);
+  shake256_absorb(state, ctx, ctxlen);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_update
+*
+* Description: Absorbs the next piece of the message to be signed.
+*
+* Arguments:   - keccak_state *state: pointer to hashing state
+*              - uint8_t *m:          pointer to message piece
+*              - size_t mlen:         length of message piece
+**************************************************/
+void crypto_sign_signature_update(keccak_state *state,
+                                  const uint8_t *m,
+                                  size_t mlen)
+{
+  shake256_absorb(state, m, mlen);
+}
+
+/*************************************************
+* Name:        crypto_sign_signature_final
+*
+* Description: Finishes an incremental signature computation.
+*
+* Arguments:   - keccak_state *state: pointer to hashing state
+*              - uint8_t *sig:        pointer to output signature (of length CRYPTO_BYTES)
+*              - size_t *siglen:      pointer to output length of signature
+*              - uint8_t *sk:         pointer to bit-packed secret key
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_sign_signature_final(keccak_state *state,
+                                uint8_t *sig,
+                                size_t *siglen,
+                                const uint8_t *sk)
+{
+  uint8_t mu[CRHBYTES];
+
+  shake256_finalize(state);
+  shake256_squeeze(mu, CRHBYTES, state);
+
+  return crypto_sign_signature_mu(sig, siglen, mu, sk);
+}
+
 /*************************************************
 * Name:        crypto_sign
 *
@@ -272,89 +691,183 @@ int crypto_sign(uint8_t *sm,
 }
 
 /*************************************************
-* Name:        crypto_sign_verify_internal
+* Name:        crypto_sign_verify_prefilter
 *
-* Description: Verifies signature. Internal API.
+* Description: Cheap structural screening of a signature before any
+*              unpacking or matrix expansion. Checks the length, the
+*              encoding of the hint vector and the range of z directly
+*              on the packed bytes. A signature that passes may still be
+*              invalid; one that fails is always rejected by verify.
 *
-* Arguments:   - uint8_t *m: pointer to input signature
+* Arguments:   - const uint8_t *sig: pointer to input signature
 *              - size_t siglen: length of signature
-*              - const uint8_t *m: pointer to message
-*              - size_t mlen: length of message
-*              - const uint8_t *pre: pointer to prefix string
-*              - size_t prelen: length of prefix string
+*              - crypto_sign_prefilter_stats *stats: optional pointer to
+*                rejection counters, incremented per reason; may be NULL
+*
+* Returns 0 if the signature passes and -1 otherwise
+**************************************************/
+int crypto_sign_verify_prefilter(const uint8_t *sig, size_t siglen,
+                                 crypto_sign_prefilter_stats *stats)
+{
+  unsigned int i;
+
+  if(siglen != CRYPTO_BYTES) {
+    if(stats)
+      stats->length++;
+    return -1;
+  }
+
+  if(check_sig_hint(sig)) {
+    if(stats)
+      stats->hint++;
+    return -1;
+  }
+
+  for(i = 0; i < L; ++i) {
+    if(polyz_packed_chknorm(sig + CTILDEBYTES + i*POLYZ_PACKEDBYTES, GAMMA1 - BETA)) {
+      if(stats)
+        stats->z++;
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+/*************************************************
+* Name:        verify_mu
+*
+* Description: Verifies a signature that passed the prefilter against mu.
+*
+* Arguments:   - uint8_t *sig: pointer to input signature
+*              - const uint8_t *mu: pointer to message representative
 *              - const uint8_t *pk: pointer to bit-packed public key
 *
 * Returns 0 if signature could be verified correctly and -1 otherwise
 **************************************************/
-int crypto_sign_verify_internal(const uint8_t *sig,
-                                size_t siglen,
-                                const uint8_t *m,
-                                size_t mlen,
-                                const uint8_t *pre,
-                                size_t prelen,
-                                const uint8_t *pk)
+static int verify_mu(const uint8_t *sig,
+                     const uint8_t mu[CRHBYTES],
+                     const uint8_t *pk)
 {
-  unsigned int i;
-  uint8_t buf[K*POLYW1_PACKEDBYTES];
   uint8_t rho[SEEDBYTES];
-  uint8_t mu[CRHBYTES];
   uint8_t c[CTILDEBYTES];
-  uint8_t c2[CTILDEBYTES];
   poly cp;
-  polyvecl mat[K], z;
+#ifndef DILITHIUM_LAZY_MATRIX
+  polyvecl mat[K];
+#endif
+  polyvecl z;
   polyveck t1, w1, h;
-  keccak_state state;
-
-  if(siglen != CRYPTO_BYTES)
-    return -1;
 
+  /* Hint encoding and shortness of z were checked by the prefilter */
   unpack_pk(rho, &t1, pk);
-  if(unpack_sig(c, &z, &h, sig))
-    return -1;
-  if(polyvecl_chknorm(&z, GAMMA1 - BETA))
-    return -1;
-
-  /* Compute CRH(H(rho, t1), pre, msg) */
-  shake256(mu, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
-  shake256_init(&state);
-  shake256_absorb(&state, mu, TRBYTES);
-  shake256_absorb(&state, pre, prelen);
-  shake256_absorb(&state, m, mlen);
-  shake256_finalize(&state);
-  shake256_squeeze(mu, CRHBYTES, &state);
+  unpack_sig(c, &z, &h, sig);
 
   /* Matrix-vector multiplication; compute Az - c2^dt1 */
   poly_challenge(&cp, c);
-  polyvec_matrix_expand(mat, rho);
 
   polyvecl_ntt(&z);
+#ifdef DILITHIUM_LAZY_MATRIX
+  polyvec_matrix_expand_pointwise_montgomery(&w1, rho, &z);
+#else
+  polyvec_matrix_expand(mat, rho);
   polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
+#endif
 
-  poly_ntt(&cp);
   polyveck_shiftl(&t1);
   polyveck_ntt(&t1);
-  polyveck_pointwise_poly_montgomery(&t1, &cp, &t1);
+  return verify_challenge(c, &cp, &w1, &t1, &h, mu);
+}
 
-  polyveck_sub(&w1, &w1, &t1);
-  polyveck_reduce(&w1);
-  polyveck_invntt_tomont(&w1);
+/*************************************************
+* Name:        verify_internal
+*
+* Description: Runs the prefilter, then computes mu = CRH(H(rho, t1), pre,
+*              msg) and verifies the signature against it. Malformed
+*              signatures are rejected before the public key and the
+*              message are hashed.
+*
+* Arguments:   as crypto_sign_verify_internal, plus
+*              - crypto_sign_prefilter_stats *stats: optional pointer to
+*                prefilter rejection counters; may be NULL
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+static int verify_internal(const uint8_t *sig,
+                           size_t siglen,
+                           const uint8_t *m,
+                           size_t mlen,
+                           const uint8_t *pre,
+                           size_t prelen,
+                           const uint8_t *pk,
+                           crypto_sign_prefilter_stats *stats)
+{
+  uint8_t mu[CRHBYTES];
+  keccak_state state;
 
-  /* Reconstruct w1 */
-  polyveck_caddq(&w1);
-  polyveck_use_hint(&w1, &w1, &h);
-  polyveck_pack_w1(buf, &w1);
+  if(crypto_sign_verify_prefilter(sig, siglen, stats))
+    return -1;
 
-  /* Call random oracle and verify challenge */
+  /* Compute CRH(H(rho, t1), pre, msg) */
+  shake256(mu, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
   shake256_init(&state);
-  shake256_absorb(&state, mu, CRHBYTES);
-  shake256_absorb(&state, buf, K*POLYW1_PACKEDBYTES);
+  shake256_absorb(&state, mu, TRBYTES);
+  shake256_absorb(&state, pre, prelen);
+  shake256_absorb(&state, m, mlen);
   shake256_finalize(&state);
-  shake256_squeeze(c2, CTILDEBYTES, &state);
-  for(i = 0; i < CTILDEBYTES; ++i)
-    if(c[i] != c2[i])
-      return -1;
+  shake256_squeeze(mu, CRHBYTES, &state);
 
-  return 0;
+  return verify_mu(sig, mu, pk);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_mu
+*
+* Description: Verifies signature against a precomputed message
+*              representative mu = CRH(tr, pre, msg), see
+*              crypto_sign_compute_mu.
+*
+* Arguments:   - uint8_t *sig: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *mu: pointer to message representative
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int crypto_sign_verify_mu(const uint8_t *sig,
+                          size_t siglen,
+                          const uint8_t mu[CRHBYTES],
+                          const uint8_t *pk)
+{
+  if(crypto_sign_verify_prefilter(sig, siglen, NULL))
+    return -1;
+
+  return verify_mu(sig, mu, pk);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_internal
+*
+* Description: Verifies signature. Internal API.
+*
+* Arguments:   - uint8_t *m: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *m: pointer to message
+*              - size_t mlen: length of message
+*              - const uint8_t *pre: pointer to prefix string
+*              - size_t prelen: length of prefix string
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int crypto_sign_verify_internal(const uint8_t *sig,
+                                size_t siglen,
+                                const uint8_t *m,
+                                size_t mlen,
+                                const uint8_t *pre,
+                                size_t prelen,
+                                const uint8_t *pk)
+{
+  return verify_internal(sig, siglen, m, mlen, pre, prelen, pk, NULL);
 }
 
 /*************************************************
@@ -379,6 +892,30 @@ int crypto_sign_verify(const uint8_t *sig,
                        const uint8_t *ctx,
                        size_t ctxlen,
                        const uint8_t *pk)
+{
+  return crypto_sign_verify_stats(sig, siglen, m, mlen, ctx, ctxlen, pk, NULL);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_stats
+*
+* Description: Verifies signature like crypto_sign_verify and counts
+*              prefilter rejections by reason.
+*
+* Arguments:   as crypto_sign_verify, plus
+*              - crypto_sign_prefilter_stats *stats: optional pointer to
+*                rejection counters, incremented per reason; may be NULL
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int crypto_sign_verify_stats(const uint8_t *sig,
+                             size_t siglen,
+                             const uint8_t *m,
+                             size_t mlen,
+                             const uint8_t *ctx,
+                             size_t ctxlen,
+                             const uint8_t *pk,
+                             crypto_sign_prefilter_stats *stats)
 {
   size_t i;
   uint8_t pre[257];
@@ -391,7 +928,84 @@ int crypto_sign_verify(const uint8_t *sig,
   for(i = 0; i < ctxlen; i++)
     pre[2 + i] = ctx[i];
 
-  return crypto_sign_verify_internal(sig,siglen,m,mlen,pre,2+ctxlen,pk);
+  return verify_internal(sig,siglen,m,mlen,pre,2+ctxlen,pk,stats);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_init
+*
+* Description: Starts an incremental signature verification. The message
+*              is passed in pieces to crypto_sign_verify_update and the
+*              signature is checked by crypto_sign_verify_final.
+*
+* Arguments:   - keccak_state *state: pointer to output hashing state
+*              - const uint8_t *ctx: pointer to context string
+*              - size_t ctxlen: length of context string
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 (success) or -1 (context string too long)
+**************************************************/
+int crypto_sign_verify_init(keccak_state *state,
+                            const uint8_t *ctx,
+                            size_t ctxlen,
+                            const uint8_t *pk)
+{
+  uint8_t tr[TRBYTES];
+  uint8_t pre[2];
+
+  if(ctxlen > 255)
+    return -1;
+
+  /* Absorb H(rho, t1) and pre = (0, ctxlen, ctx) */
+  shake256(tr, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
+  pre[0] = 0;
+  pre[1] = ctxlen;
+  shake256_init(state);
+  shake256_absorb(state, tr, TRBYTES);
+  shake256_absorb(state, pre, 2);
+  shake256_absorb(state, ctx, ctxlen);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_update
+*
+* Description: Absorbs the next piece of the signed message.
+*
+* Arguments:   - keccak_state *state: pointer to hashing state
+*              - const uint8_t *m: pointer to message piece
+*              - size_t mlen: length of message piece
+**************************************************/
+void crypto_sign_verify_update(keccak_state *state,
+                               const uint8_t *m,
+                               size_t mlen)
+{
+  shake256_absorb(state, m, mlen);
+}
+
+/*************************************************
+* Name:        crypto_sign_verify_final
+*
+* Description: Finishes an incremental signature verification.
+*
+* Arguments:   - keccak_state *state: pointer to hashing state
+*              - const uint8_t *sig: pointer to input signature
+*              - size_t siglen: length of signature
+*              - const uint8_t *pk: pointer to bit-packed public key
+*
+* Returns 0 if signature could be verified correctly and -1 otherwise
+**************************************************/
+int crypto_sign_verify_final(keccak_state *state,
+                             const uint8_t *sig,
+                             size_t siglen,
+                             const uint8_t *pk)
+{
+  uint8_t mu[CRHBYTES];
+
+  shake256_finalize(state);
+  shake256_squeeze(mu, CRHBYTES, state);
+
+  return crypto_sign_verify_mu(sig, siglen, mu, pk);
 }
 
 /*************************************************
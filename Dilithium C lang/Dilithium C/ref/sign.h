@@ -6,10 +6,30 @@
 #include "params.h"
 #include "polyvec.h"
 #include "poly.h"
+#include "fips202.h"
 
 #define crypto_sign_keypair DILITHIUM_NAMESPACE(keypair)
 int crypto_sign_keypair(uint8_t *pk, uint8_t *sk);
 
+#define crypto_sign_keypair_pk DILITHIUM_NAMESPACE(keypair_pk)
+int crypto_sign_keypair_pk(uint8_t *pk, const uint8_t seed[SEEDBYTES]);
+
+#define crypto_sign_keypair_pct DILITHIUM_NAMESPACE(keypair_pct)
+int crypto_sign_keypair_pct(uint8_t *pk, uint8_t *sk, const uint8_t seed[SEEDBYTES]);
+
+#define crypto_sign_compute_mu DILITHIUM_NAMESPACE(compute_mu)
+int crypto_sign_compute_mu(uint8_t mu[CRHBYTES],
+                           const uint8_t tr[TRBYTES],
+                           const uint8_t *m, size_t mlen,
+                           const uint8_t *ctx, size_t ctxlen);
+
+#define crypto_sign_signature_mu_internal DILITHIUM_NAMESPACE(signature_mu_internal)
+int crypto_sign_signature_mu_internal(uint8_t *sig,
+                                      size_t *siglen,
+                                      const uint8_t mu[CRHBYTES],
+                                      const uint8_t rnd[RNDBYTES],
+                                      const uint8_t *sk);
+
 #define crypto_sign_signature_internal DILITHIUM_NAMESPACE(signature_internal)
 int crypto_sign_signature_internal(uint8_t *sig,
                                    size_t *siglen,
@@ -26,6 +46,25 @@ int crypto_sign_signature(uint8_t *sig, size_t *siglen,
                           const uint8_t *ctx, size_t ctxlen,
                           const uint8_t *sk);
 
+#define crypto_sign_signature_mu DILITHIUM_NAMESPACE(signature_mu)
+int crypto_sign_signature_mu(uint8_t *sig, size_t *siglen,
+                             const uint8_t mu[CRHBYTES],
+                             const uint8_t *sk);
+
+#define crypto_sign_signature_init DILITHIUM_NAMESPACE(signature_init)
+int crypto_sign_signature_init(keccak_state *state,
+                               const uint8_t *ctx, size_t ctxlen,
+                               const uint8_t *sk);
+
+#define crypto_sign_signature_update DILITHIUM_NAMESPACE(signature_update)
+void crypto_sign_signature_update(keccak_state *state,
+                                  const uint8_t *m, size_t mlen);
+
+#define crypto_sign_signature_final DILITHIUM_NAMESPACE(signature_final)
+int crypto_sign_signature_final(keccak_state *state,
+                                uint8_t *sig, size_t *siglen,
+                                const uint8_t *sk);
+
 #define crypto_sign DILITHIUM_NAMESPACETOP
 int crypto_sign(uint8_t *sm, size_t *smlen,
                 const uint8_t *m, size_t mlen,
@@ -47,6 +86,42 @@ int crypto_sign_verify(const uint8_t *sig, size_t siglen,
                        const uint8_t *ctx, size_t ctxlen,
                        const uint8_t *pk);
 
+typedef struct {
+  uint64_t length;
+  uint64_t hint;
+  uint64_t z;
+} crypto_sign_prefilter_stats;
+
+#define crypto_sign_verify_prefilter DILITHIUM_NAMESPACE(verify_prefilter)
+int crypto_sign_verify_prefilter(const uint8_t *sig, size_t siglen,
+                                 crypto_sign_prefilter_stats *stats);
+
+#define crypto_sign_verify_stats DILITHIUM_NAMESPACE(verify_stats)
+int crypto_sign_verify_stats(const uint8_t *sig, size_t siglen,
+                             const uint8_t *m, size_t mlen,
+                             const uint8_t *ctx, size_t ctxlen,
+                             const uint8_t *pk,
+                             crypto_sign_prefilter_stats *stats);
+
+#define crypto_sign_verify_mu DILITHIUM_NAMESPACE(verify_mu)
+int crypto_sign_verify_mu(const uint8_t *sig, size_t siglen,
+                          const uint8_t mu[CRHBYTES],
+                          const uint8_t *pk);
+
+#define crypto_sign_verify_init DILITHIUM_NAMESPACE(verify_init)
+int crypto_sign_verify_init(keccak_state *state,
+                            const uint8_t *ctx, size_t ctxlen,
+                            const uint8_t *pk);
+
+#define crypto_sign_verify_update DILITHIUM_NAMESPACE(verify_update)
+void crypto_sign_verify_update(keccak_state *state,
+                               const uint8_t *m, size_t mlen);
+
+#define crypto_sign_verify_final DILITHIUM_NAMESPACE(verify_final)
+int crypto_sign_verify_final(keccak_state *state,
+                             const uint8_t *sig, size_t siglen,
+                             const uint8_t *pk);
+
 #define crypto_sign_open DILITHIUM_NAMESPACE(open)
 int crypto_sign_open(uint8_t *m, size_t *mlen,
                      const uint8_t *sm, size_t smlen,
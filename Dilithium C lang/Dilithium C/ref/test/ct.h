@@ -0,0 +1,2 @@
+/* Shared by the tests of all schemes; see q4_lib/bench */
+#include "../../../../q4_lib/bench/ct.h"
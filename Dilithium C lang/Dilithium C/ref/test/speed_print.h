@@ -1,9 +1,2 @@
-#ifndef PRINT_SPEED_H
-#define PRINT_SPEED_H
-
-#include <stddef.h>
-#include <stdint.h>
-
-void print_results(const char *s, uint64_t *t, size_t tlen);
-
-#endif
+/* Shared by the tests of all schemes; see q4_lib/bench */
+#include "../../../../q4_lib/bench/speed_print.h"
@@ -0,0 +1,159 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "../sign.h"
+#include "../packing.h"
+#include "../polyvec.h"
+#include "../params.h"
+#include "../randombytes.h"
+#include "ct.h"
+
+/*
+ * Constant-time checks for signing.
+ *
+ * The signing loop is allowed to leak how many candidates are rejected, as
+ * well as the challenge and the hints, which are public once the signature
+ * is output. Signing as a whole is therefore not timed; the dudect-style
+ * timing test (see ct.h) covers the secret-dependent arithmetic it is built
+ * from instead.
+ *
+ * With -DCT_VALGRIND, signing also runs once with the secret key and the
+ * signing randomness marked as secret. Run it with
+ * valgrind --error-exitcode=1 --suppressions=test/ct.supp; the suppressions
+ * cover exactly the leaks listed above.
+ */
+
+#ifndef NMEASURES
+#define NMEASURES 100000
+#endif
+
+static uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+static uint8_t sk[CRYPTO_SECRETKEYBYTES];
+
+/* Uniform-ish coefficients in [0, bound) */
+static void random_coeffs(int32_t *c, size_t n, uint32_t bound)
+{
+  size_t i;
+  uint32_t r;
+
+  for(i = 0; i < n; i++) {
+    randombytes((uint8_t *)&r, sizeof(r));
+    c[i] = r % bound;
+  }
+}
+
+/* Class 0: the generated secret key; class 1: random bytes */
+static void prepare_unpack_sk(uint8_t *in, int cls)
+{
+  if(cls == 0)
+    memcpy(in, sk, CRYPTO_SECRETKEYBYTES);
+  else
+    randombytes(in, CRYPTO_SECRETKEYBYTES);
+}
+
+static void run_unpack_sk(uint8_t *in)
+{
+  uint8_t rho[SEEDBYTES], tr[TRBYTES], key[SEEDBYTES];
+  polyveck t0, s2;
+  polyvecl s1;
+
+  unpack_sk(rho, tr, key, &t0, &s1, &s2, in);
+  __asm__ volatile("" : : "r"(&s1), "r"(&s2), "r"(&t0) : "memory");
+}
+
+/* Class 0: zero vector; class 1: random coefficients in [-ETA, ETA] */
+static void prepare_ntt(uint8_t *in, int cls)
+{
+  unsigned int i;
+  polyvecl *v = (polyvecl *)in;
+
+  memset(v, 0, sizeof(*v));
+  if(cls == 1) {
+    random_coeffs((int32_t *)v, L*N, 2*ETA+1);
+    for(i = 0; i < L*N; i++)
+      ((int32_t *)v)[i] -= ETA;
+  }
+}
+
+static void run_ntt(uint8_t *in)
+{
+  polyvecl_ntt((polyvecl *)in);
+}
+
+/* Class 0: zero vector; class 1: random coefficients in [0, Q) */
+static void prepare_rounding(uint8_t *in, int cls)
+{
+  polyveck *v = (polyveck *)in;
+
+  memset(v, 0, sizeof(*v));
+  if(cls == 1)
+    random_coeffs((int32_t *)v, K*N, Q);
+}
+
+static void run_decompose(uint8_t *in)
+{
+  polyveck w1, w0;
+
+  polyveck_decompose(&w1, &w0, (const polyveck *)in);
+  __asm__ volatile("" : : "r"(&w1), "r"(&w0) : "memory");
+}
+
+static void run_power2round(uint8_t *in)
+{
+  polyveck t1, t0;
+
+  polyveck_power2round(&t1, &t0, (const polyveck *)in);
+  __asm__ volatile("" : : "r"(&t1), "r"(&t0) : "memory");
+}
+
+static const ct_target targets[] = {
+  { "unpack_sk (key vs random)", CRYPTO_SECRETKEYBYTES, prepare_unpack_sk, run_unpack_sk },
+  { "polyvecl_ntt (zero vs s1-like)", sizeof(polyvecl), prepare_ntt, run_ntt },
+  { "polyveck_decompose (zero vs random)", sizeof(polyveck), prepare_rounding, run_decompose },
+  { "polyveck_power2round (zero vs random)", sizeof(polyveck), prepare_rounding, run_power2round },
+};
+
+#ifdef CT_VALGRIND
+static int run_sign_secret(void)
+{
+  size_t siglen;
+  uint8_t m[32], rnd[RNDBYTES];
+  uint8_t pre[2] = {0};
+  uint8_t sig[CRYPTO_BYTES];
+
+  randombytes(m, sizeof(m));
+  randombytes(rnd, sizeof(rnd));
+
+  /* key, s1, s2 and t0 are secret; rho and tr are public */
+  ct_poison(sk + SEEDBYTES, SEEDBYTES);
+  ct_poison(sk + 2*SEEDBYTES + TRBYTES, CRYPTO_SECRETKEYBYTES - 2*SEEDBYTES - TRBYTES);
+  ct_poison(rnd, sizeof(rnd));
+  crypto_sign_signature_internal(sig, &siglen, m, sizeof(m), pre, sizeof(pre), rnd, sk);
+  ct_unpoison(sig, sizeof(sig));
+  ct_unpoison(sk, CRYPTO_SECRETKEYBYTES);
+
+  if(crypto_sign_verify_internal(sig, siglen, m, sizeof(m), pre, sizeof(pre), pk)) {
+    printf("%s: verification failed\n", CRYPTO_ALGNAME);
+    return 1;
+  }
+  return 0;
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  unsigned long nmeasures = NMEASURES;
+
+  if(argc > 1)
+    nmeasures = strtoul(argv[1], NULL, 10);
+
+  crypto_sign_keypair(pk, sk);
+#ifdef CT_VALGRIND
+  if(run_sign_secret())
+    return 1;
+#endif
+
+  return ct_run(CRYPTO_ALGNAME, targets, sizeof(targets)/sizeof(targets[0]), nmeasures);
+}
@@ -12,14 +12,21 @@ int main(void)
 {
   size_t i, j;
   int ret;
-  size_t mlen, smlen;
+  size_t mlen, smlen, siglen;
   uint8_t b;
+  keccak_state state;
   uint8_t ctx[CTXLEN] = {0};
   uint8_t m[MLEN + CRYPTO_BYTES];
   uint8_t m2[MLEN + CRYPTO_BYTES];
   uint8_t sm[MLEN + CRYPTO_BYTES];
   uint8_t pk[CRYPTO_PUBLICKEYBYTES];
   uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t pk2[CRYPTO_PUBLICKEYBYTES];
+  uint8_t seed[SEEDBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t tr[TRBYTES];
+  uint8_t mu[CRHBYTES];
+  crypto_sign_prefilter_stats stats;
 
   snprintf((char*)ctx,CTXLEN,"test_dilitium");
 
@@ -49,6 +56,82 @@ int main(void)
       }
     }
 
+    /* Incremental interface, message split at a random position */
+    randombytes((uint8_t *)&j, sizeof(j));
+    j %= MLEN + 1;
+    crypto_sign_verify_init(&state, ctx, CTXLEN, pk);
+    crypto_sign_verify_update(&state, m, j);
+    crypto_sign_verify_update(&state, m + j, MLEN - j);
+    if(crypto_sign_verify_final(&state, sm, CRYPTO_BYTES, pk)) {
+      fprintf(stderr, "Incremental verification failed\n");
+      return -1;
+    }
+
+    crypto_sign_signature_init(&state, ctx, CTXLEN, sk);
+    crypto_sign_signature_update(&state, m, j);
+    crypto_sign_signature_update(&state, m + j, MLEN - j);
+    crypto_sign_signature_final(&state, sig, &siglen, sk);
+    if(crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk)) {
+      fprintf(stderr, "Incremental signature invalid\n");
+      return -1;
+    }
+
+    /* Precomputed message representative */
+    shake256(tr, TRBYTES, pk, CRYPTO_PUBLICKEYBYTES);
+    crypto_sign_compute_mu(mu, tr, m, MLEN, ctx, CTXLEN);
+    if(crypto_sign_verify_mu(sm, CRYPTO_BYTES, mu, pk)) {
+      fprintf(stderr, "Verification from mu failed\n");
+      return -1;
+    }
+    crypto_sign_signature_mu(sig, &siglen, mu, sk);
+    if(crypto_sign_verify(sig, siglen, m, MLEN, ctx, CTXLEN, pk)) {
+      fprintf(stderr, "Signature from mu invalid\n");
+      return -1;
+    }
+
+    /* Keygen with pairwise consistency test; same key as from the seed alone */
+    randombytes(seed, SEEDBYTES);
+    if(crypto_sign_keypair_pct(pk, sk, seed)) {
+      fprintf(stderr, "Pairwise consistency test failed\n");
+      return -1;
+    }
+    crypto_sign_keypair_pk(pk2, seed);
+    for(j = 0; j < CRYPTO_PUBLICKEYBYTES; ++j) {
+      if(pk[j] != pk2[j]) {
+        fprintf(stderr, "Public keys with and without test don't match\n");
+        return -1;
+      }
+    }
+    crypto_sign(sm, &smlen, m, MLEN, ctx, CTXLEN, sk);
+    if(crypto_sign_open(m2, &mlen, sm, smlen, ctx, CTXLEN, pk)) {
+      fprintf(stderr, "Key from consistency test doesn't sign\n");
+      return -1;
+    }
+
+    /* Prefilter accepts valid signatures, and verify counts each of its
+     * rejection reasons exactly once */
+    crypto_sign_signature(sig, &siglen, m, MLEN, ctx, CTXLEN, sk);
+    stats.length = stats.hint = stats.z = 0;
+    if(crypto_sign_verify_prefilter(sig, siglen, &stats)
+       || crypto_sign_verify_stats(sig, siglen, m, MLEN, ctx, CTXLEN, pk, &stats)) {
+      fprintf(stderr, "Prefilter rejected valid signature\n");
+      return -1;
+    }
+    crypto_sign_verify_stats(sig, siglen - 1, m, MLEN, ctx, CTXLEN, pk, &stats);
+    b = sig[CRYPTO_BYTES - 1];
+    sig[CRYPTO_BYTES - 1] = OMEGA + 1;
+    crypto_sign_verify_stats(sig, siglen, m, MLEN, ctx, CTXLEN, pk, &stats);
+    sig[CRYPTO_BYTES - 1] = b;
+    sig[CTILDEBYTES + 0] = sig[CTILDEBYTES + 1] = sig[CTILDEBYTES + 2] = 0;
+    if(!crypto_sign_verify_stats(sig, siglen, m, MLEN, ctx, CTXLEN, pk, &stats)) {
+      fprintf(stderr, "Out-of-range z accepted\n");
+      return -1;
+    }
+    if(stats.length != 1 || stats.hint != 1 || stats.z != 1) {
+      fprintf(stderr, "Prefilter counters wrong\n");
+      return -1;
+    }
+
     randombytes((uint8_t *)&j, sizeof(j));
     do {
       randombytes(&b, 1);
@@ -1,4 +1,5 @@
 #include <stdint.h>
+#include <stdlib.h>
 #include "../sign.h"
 #include "../poly.h"
 #include "../polyvec.h"
@@ -7,8 +8,11 @@
 #include "speed_print.h"
 
 #define NTESTS 1000
+#define MLEN 65536
 
-uint64_t t[NTESTS];
+uint64_t *t;
+size_t ntests;
+static uint8_t m[MLEN];
 
 int main(void)
 {
@@ -18,70 +22,96 @@ int main(void)
   uint8_t sk[CRYPTO_SECRETKEYBYTES];
   uint8_t sig[CRYPTO_BYTES];
   uint8_t seed[CRHBYTES];
+  crypto_sign_prefilter_stats stats;
   polyvecl mat[K];
   poly *a = &mat[0].vec[0];
   poly *b = &mat[0].vec[1];
   poly *c = &mat[0].vec[2];
 
-  for(i = 0; i < NTESTS; ++i) {
+  ntests = speed_init(CRYPTO_ALGNAME, NTESTS);
+  t = malloc(ntests * sizeof(uint64_t));
+  if(!t)
+    return 1;
+
+  for(i = 0; i < ntests; ++i) {
     t[i] = cpucycles();
     polyvec_matrix_expand(mat, seed);
   }
-  print_results("polyvec_matrix_expand:", t, NTESTS);
+  print_results("polyvec_matrix_expand:", t, ntests);
 
-  for(i = 0; i < NTESTS; ++i) {
+  for(i = 0; i < ntests; ++i) {
     t[i] = cpucycles();
     poly_uniform_eta(a, seed, 0);
   }
-  print_results("poly_uniform_eta:", t, NTESTS);
+  print_results("poly_uniform_eta:", t, ntests);
 
-  for(i = 0; i < NTESTS; ++i) {
+  for(i = 0; i < ntests; ++i) {
     t[i] = cpucycles();
     poly_uniform_gamma1(a, seed, 0);
   }
-  print_results("poly_uniform_gamma1:", t, NTESTS);
+  print_results("poly_uniform_gamma1:", t, ntests);
 
-  for(i = 0; i < NTESTS; ++i) {
+  for(i = 0; i < ntests; ++i) {
     t[i] = cpucycles();
     poly_ntt(a);
   }
-  print_results("poly_ntt:", t, NTESTS);
+  print_results("poly_ntt:", t, ntests);
 
-  for(i = 0; i < NTESTS; ++i) {
+  for(i = 0; i < ntests; ++i) {
     t[i] = cpucycles();
     poly_invntt_tomont(a);
   }
-  print_results("poly_invntt_tomont:", t, NTESTS);
+  print_results("poly_invntt_tomont:", t, ntests);
 
-  for(i = 0; i < NTESTS; ++i) {
+  for(i = 0; i < ntests; ++i) {
     t[i] = cpucycles();
     poly_pointwise_montgomery(c, a, b);
   }
-  print_results("poly_pointwise_montgomery:", t, NTESTS);
+  print_results("poly_pointwise_montgomery:", t, ntests);
 
-  for(i = 0; i < NTESTS; ++i) {
+  for(i = 0; i < ntests; ++i) {
     t[i] = cpucycles();
     poly_challenge(c, seed);
   }
-  print_results("poly_challenge:", t, NTESTS);
+  print_results("poly_challenge:", t, ntests);
 
-  for(i = 0; i < NTESTS; ++i) {
+  for(i = 0; i < ntests; ++i) {
     t[i] = cpucycles();
     crypto_sign_keypair(pk, sk);
   }
-  print_results("Keypair:", t, NTESTS);
+  print_results("Keypair:", t, ntests);
 
-  for(i = 0; i < NTESTS; ++i) {
+  for(i = 0; i < ntests; ++i) {
     t[i] = cpucycles();
     crypto_sign_signature(sig, &siglen, sig, CRHBYTES, NULL, 0, sk);
   }
-  print_results("Sign:", t, NTESTS);
+  print_results("Sign:", t, ntests);
 
-  for(i = 0; i < NTESTS; ++i) {
+  for(i = 0; i < ntests; ++i) {
     t[i] = cpucycles();
     crypto_sign_verify(sig, CRYPTO_BYTES, sig, CRHBYTES, NULL, 0, pk);
   }
-  print_results("Verify:", t, NTESTS);
+  print_results("Verify:", t, ntests);
+
+  crypto_sign_signature(sig, &siglen, m, MLEN, NULL, 0, sk);
+  for(i = 0; i < ntests; ++i) {
+    t[i] = cpucycles();
+    crypto_sign_verify(sig, CRYPTO_BYTES, m, MLEN, NULL, 0, pk);
+  }
+  print_results("Verify (64 KiB message):", t, ntests);
+
+  /* Junk signature with z out of range; the prefilter rejects it before
+   * the message is hashed */
+  sig[CTILDEBYTES] = sig[CTILDEBYTES + 1] = sig[CTILDEBYTES + 2] = 0;
+  stats.length = stats.hint = stats.z = 0;
+  for(i = 0; i < ntests; ++i) {
+    t[i] = cpucycles();
+    crypto_sign_verify_stats(sig, CRYPTO_BYTES, m, MLEN, NULL, 0, pk, &stats);
+  }
+  print_results("Verify (z rejected, 64 KiB message):", t, ntests);
+  if(stats.z != ntests)
+    return 1;
 
-  return 0;
+  free(t);
+  return speed_finish();
 }
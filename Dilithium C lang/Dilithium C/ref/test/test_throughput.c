@@ -0,0 +1,69 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "../sign.h"
+#include "../params.h"
+#include "../randombytes.h"
+#include "bench_threads.h"
+
+#define MLEN 59
+
+/* Per-thread key pair and signature; keygen and sign write to scratch */
+typedef struct {
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t sig[CRYPTO_BYTES];
+  uint8_t pk2[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk2[CRYPTO_SECRETKEYBYTES];
+  uint8_t sig2[CRYPTO_BYTES];
+  uint8_t m[MLEN];
+  size_t siglen;
+} sign_ctx;
+
+static void setup(void *p)
+{
+  sign_ctx *c = p;
+
+  randombytes(c->m, MLEN);
+  crypto_sign_keypair(c->pk, c->sk);
+  crypto_sign_signature(c->sig, &c->siglen, c->m, MLEN, NULL, 0, c->sk);
+}
+
+static void keygen(void *p)
+{
+  sign_ctx *c = p;
+  crypto_sign_keypair(c->pk2, c->sk2);
+}
+
+static void sign(void *p)
+{
+  sign_ctx *c = p;
+  size_t siglen;
+  crypto_sign_signature(c->sig2, &siglen, c->m, MLEN, NULL, 0, c->sk);
+}
+
+static void verify(void *p)
+{
+  sign_ctx *c = p;
+
+  if(crypto_sign_verify(c->sig, c->siglen, c->m, MLEN, NULL, 0, c->pk)) {
+    fprintf(stderr, "ERROR: Verification failed\n");
+    abort();
+  }
+}
+
+static const bench_op ops[] = {
+  { "keygen", 1, keygen },
+  { "sign", 1, sign },
+  { "verify", 1, verify },
+};
+
+int main(int argc, char *argv[])
+{
+  const bench_config cfg = {
+    CRYPTO_ALGNAME, ops, sizeof(ops)/sizeof(ops[0]), sizeof(sign_ctx), setup
+  };
+
+  return bench_threads_main(&cfg, argc, argv);
+}
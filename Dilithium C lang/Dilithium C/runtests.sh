@@ -6,6 +6,9 @@ ARCH="${TRAVIS_CPU_ARCH:-$ARCH}"
 
 if [ "$ARCH" = "amd64" -a "$TRAVIS_OS_NAME" != "osx" ]; then
   DIRS="ref avx2"
+  if grep -q avx512bw /proc/cpuinfo 2>/dev/null; then
+    DIRS="$DIRS avx512"
+  fi
 else
   DIRS="ref"
 fi
@@ -15,6 +18,10 @@ if [ "$ARCH" = "amd64" -o "$ARCH" = "arm64" ]; then
   export CFLAGS="-fsanitize=undefined,address ${CFLAGS}"
 fi
 
+make -j$(nproc) -C ../../q4_lib/fips202 clean
+make -j$(nproc) -C ../../q4_lib/fips202
+../../q4_lib/fips202/test/test_fips202
+
 for dir in $DIRS; do
   make -j$(nproc) -C $dir clean
   make -j$(nproc) -C $dir
@@ -28,6 +35,14 @@ for dir in $DIRS; do
     wait $PID1 $PID2
   done
   shasum -a256 -c SHA256SUMS
+  if command -v valgrind >/dev/null; then
+    # valgrind does not run sanitized binaries
+    CFLAGS= make -j$(nproc) -C $dir ct-valgrind
+    for alg in 2 3 5; do
+      valgrind -q --error-exitcode=1 --suppressions=$dir/test/ct.supp \
+        ./$dir/test/test_ct_valgrind$alg
+    done
+  fi
 done
 
 exit 0
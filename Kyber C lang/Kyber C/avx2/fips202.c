@@ -1 +0,0 @@
-../ref/fips202.c
\ No newline at end of file
@@ -1,3 +0,0 @@
-#define KeccakP1600times4_implementation_config "AVX2, all rounds unrolled"
-#define KeccakP1600times4_fullUnrolling
-#define KeccakP1600times4_useAVX2
@@ -19,6 +19,12 @@ void kyber_shake128_absorb(keccak_state *s,
 #define kyber_shake256_prf KYBER_NAMESPACE(kyber_shake256_prf)
 void kyber_shake256_prf(uint8_t *out, size_t outlen, const uint8_t key[KYBER_SYMBYTES], uint8_t nonce);
 
+#define kyber_shake256_prf_many KYBER_NAMESPACE(kyber_shake256_prf_many)
+void kyber_shake256_prf_many(uint64_t s[][25], unsigned int n, const uint8_t key[KYBER_SYMBYTES], uint8_t nonce);
+
+#define kyber_shake256_squeeze_many KYBER_NAMESPACE(kyber_shake256_squeeze_many)
+void kyber_shake256_squeeze_many(uint64_t s[][25], unsigned int n);
+
 #define kyber_shake256_rkprf KYBER_NAMESPACE(kyber_shake256_rkprf)
 void kyber_shake256_rkprf(uint8_t out[KYBER_SSBYTES], const uint8_t key[KYBER_SYMBYTES], const uint8_t input[KYBER_CIPHERTEXTBYTES]);
 
@@ -0,0 +1 @@
+../../ref/test/bench_threads.h
\ No newline at end of file
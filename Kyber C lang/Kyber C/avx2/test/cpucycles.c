@@ -1 +0,0 @@
-../../ref/test/cpucycles.c
\ No newline at end of file
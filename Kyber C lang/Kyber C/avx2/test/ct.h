@@ -0,0 +1 @@
+../../ref/test/ct.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../ref/test/test_throughput.c
\ No newline at end of file
@@ -126,3 +126,89 @@ void poly_cbd_eta2(poly *r, const uint8_t buf[KYBER_ETA2*KYBER_N/4])
 #error "This implementation requires eta2 = 2"
 #endif
 }
+
+/*************************************************
+* Name:        cbd2_lanes
+*
+* Description: Same as cbd2, but reads the uniformly random input as
+*              little-endian 64-bit words, e.g. straight from the lanes of
+*              a Keccak state
+*
+* Arguments:   - poly *r: pointer to output polynomial
+*              - const uint64_t *s: pointer to input words
+**************************************************/
+static void cbd2_lanes(poly *r, const uint64_t s[2*KYBER_N/32])
+{
+  unsigned int i,j;
+  uint64_t t,d;
+  int16_t a,b;
+
+  for(i=0;i<KYBER_N/16;i++) {
+    t  = s[i];
+    d  = t & 0x5555555555555555;
+    d += (t>>1) & 0x5555555555555555;
+
+    for(j=0;j<16;j++) {
+      a = (d >> (4*j+0)) & 0x3;
+      b = (d >> (4*j+2)) & 0x3;
+      r->coeffs[16*i+j] = a - b;
+    }
+  }
+}
+
+/*************************************************
+* Name:        cbd3_lanes
+*
+* Description: Same as cbd3, but reads the uniformly random input as
+*              little-endian 64-bit words.
+*              This function is only needed for Kyber-512
+*
+* Arguments:   - poly *r: pointer to output polynomial
+*              - const uint64_t *s: pointer to input words
+**************************************************/
+#if KYBER_ETA1 == 3
+static void cbd3_lanes(poly *r, const uint64_t s[3*KYBER_N/32])
+{
+  unsigned int i,j,k;
+  uint32_t t,d;
+  uint64_t w;
+  int16_t a,b;
+
+  for(i=0;i<KYBER_N/4;i++) {
+    k = 24*i;
+    w = s[k/64] >> k%64;
+    if(k%64 > 40)
+      w |= s[k/64+1] << (64 - k%64);
+    t  = w & 0xFFFFFF;
+    d  = t & 0x00249249;
+    d += (t>>1) & 0x00249249;
+    d += (t>>2) & 0x00249249;
+
+    for(j=0;j<4;j++) {
+      a = (d >> (6*j+0)) & 0x7;
+      b = (d >> (6*j+3)) & 0x7;
+      r->coeffs[4*i+j] = a - b;
+    }
+  }
+}
+#endif
+
+void poly_cbd_eta1_lanes(poly *r, const uint64_t s[KYBER_ETA1*KYBER_N/32])
+{
+#if KYBER_ETA1 == 2
+  cbd2_lanes(r, s);
+#elif KYBER_ETA1 == 3
+  cbd3_lanes(r, s);
+#else
+#error "This implementation requires eta1 in {2,3}"
+#endif
+}
+
+void poly_cbd_eta2_lanes(poly *r, const uint64_t s[KYBER_ETA2*KYBER_N/32])
+{
+#if KYBER_ETA2 == 2
+  cbd2_lanes(r, s);
+#else
+#error "This implementation requires eta2 = 2"
+#endif
+}
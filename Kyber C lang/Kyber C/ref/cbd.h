@@ -11,4 +11,10 @@ void poly_cbd_eta1(poly *r, const uint8_t buf[KYBER_ETA1*KYBER_N/4]);
 #define poly_cbd_eta2 KYBER_NAMESPACE(poly_cbd_eta2)
 void poly_cbd_eta2(poly *r, const uint8_t buf[KYBER_ETA2*KYBER_N/4]);
 
+#define poly_cbd_eta1_lanes KYBER_NAMESPACE(poly_cbd_eta1_lanes)
+void poly_cbd_eta1_lanes(poly *r, const uint64_t s[KYBER_ETA1*KYBER_N/32]);
+
+#define poly_cbd_eta2_lanes KYBER_NAMESPACE(poly_cbd_eta2_lanes)
+void poly_cbd_eta2_lanes(poly *r, const uint64_t s[KYBER_ETA2*KYBER_N/32]);
+
 #endif
@@ -190,10 +190,10 @@ void gen_matrix(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], int transposed)
 }
 
 /*************************************************
-* Name:        indcpa_keypair_derand
+* Name:        keypair_derand
 *
-* Description: Generates public and private key for the CPA-secure
-*              public-key encryption scheme underlying Kyber
+* Description: Key generation of indcpa_keypair_derand, also returning
+*              the matrix A and the public-key polyvec in NTT domain
 *
 * Arguments:   - uint8_t *pk: pointer to output public key
 *                             (of length KYBER_INDCPA_PUBLICKEYBYTES bytes)
@@ -201,17 +201,21 @@ void gen_matrix(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], int transposed)
 *                             (of length KYBER_INDCPA_SECRETKEYBYTES bytes)
 *              - const uint8_t *coins: pointer to input randomness
 *                             (of length KYBER_SYMBYTES bytes)
+*              - polyvec *a: pointer to output matrix A
+*              - polyvec *pkpv: pointer to output public-key polyvec
 **************************************************/
-void indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+static void keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
                            uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
-                           const uint8_t coins[KYBER_SYMBYTES])
+                           const uint8_t coins[KYBER_SYMBYTES],
+                           polyvec a[KYBER_K],
+                           polyvec *pkpv)
 {
   unsigned int i;
   uint8_t buf[2*KYBER_SYMBYTES];
   const uint8_t *publicseed = buf;
   const uint8_t *noiseseed = buf+KYBER_SYMBYTES;
-  uint8_t nonce = 0;
-  polyvec a[KYBER_K], e, pkpv, skpv;
+  poly *noise[2*KYBER_K];
+  polyvec e, skpv;
 
   memcpy(buf, coins, KYBER_SYMBYTES);
   buf[KYBER_SYMBYTES] = KYBER_K;
@@ -219,72 +223,129 @@ void indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
 
   gen_a(a, publicseed);
 
-  for(i=0;i<KYBER_K;i++)
-    poly_getnoise_eta1(&skpv.vec[i], noiseseed, nonce++);
-  for(i=0;i<KYBER_K;i++)
-    poly_getnoise_eta1(&e.vec[i], noiseseed, nonce++);
+  for(i=0;i<KYBER_K;i++) {
+    noise[i] = &skpv.vec[i];
+    noise[KYBER_K+i] = &e.vec[i];
+  }
+  poly_getnoise_many(noise, 2*KYBER_K, 2*KYBER_K, noiseseed, 0);
 
   polyvec_ntt(&skpv);
   polyvec_ntt(&e);
 
   // matrix-vector multiplication
   for(i=0;i<KYBER_K;i++) {
-    polyvec_basemul_acc_montgomery(&pkpv.vec[i], &a[i], &skpv);
-    poly_tomont(&pkpv.vec[i]);
+    polyvec_basemul_acc_montgomery(&pkpv->vec[i], &a[i], &skpv);
+    poly_tomont(&pkpv->vec[i]);
   }
 
-  polyvec_add(&pkpv, &pkpv, &e);
-  polyvec_reduce(&pkpv);
+  polyvec_add(pkpv, pkpv, &e);
+  polyvec_reduce(pkpv);
 
   pack_sk(sk, &skpv);
-  pack_pk(pk, &pkpv, publicseed);
+  pack_pk(pk, pkpv, publicseed);
 }
 
+/*************************************************
+* Name:        indcpa_keypair_derand
+*
+* Description: Generates public and private key for the CPA-secure
+*              public-key encryption scheme underlying Kyber
+*
+* Arguments:   - uint8_t *pk: pointer to output public key
+*                             (of length KYBER_INDCPA_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk: pointer to output private key
+*                             (of length KYBER_INDCPA_SECRETKEYBYTES bytes)
+*              - const uint8_t *coins: pointer to input randomness
+*                             (of length KYBER_SYMBYTES bytes)
+**************************************************/
+void indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                           uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                           const uint8_t coins[KYBER_SYMBYTES])
+{
+  polyvec a[KYBER_K], pkpv;
+  keypair_derand(pk, sk, coins, a, &pkpv);
+}
 
 /*************************************************
-* Name:        indcpa_enc
+* Name:        indcpa_keypair_expanded_derand
 *
-* Description: Encryption function of the CPA-secure
-*              public-key encryption scheme underlying Kyber.
+* Description: Same as indcpa_keypair_derand, but also returns the public
+*              key as indcpa_enc uses it: the transpose of the matrix A
+*              that key generation sampled anyway, and the unpacked
+*              public-key polyvec. Encrypting with indcpa_enc_expanded
+*              then needs neither unpacking nor sampling A^T again.
+*
+* Arguments:   - uint8_t *pk: pointer to output public key
+*                             (of length KYBER_INDCPA_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk: pointer to output private key
+*                             (of length KYBER_INDCPA_SECRETKEYBYTES bytes)
+*              - const uint8_t *coins: pointer to input randomness
+*                             (of length KYBER_SYMBYTES bytes)
+*              - indcpa_public *pub: pointer to output expanded public key
+**************************************************/
+void indcpa_keypair_expanded_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                                    uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                                    const uint8_t coins[KYBER_SYMBYTES],
+                                    indcpa_public *pub)
+{
+  unsigned int i, j;
+  poly t;
+
+  keypair_derand(pk, sk, coins, pub->at, &pub->pkpv);
+
+  /* Entry (i,j) of A^T is entry (j,i) of A */
+  for(i=0;i<KYBER_K;i++) {
+    for(j=i+1;j<KYBER_K;j++) {
+      t = pub->at[i].vec[j];
+      pub->at[i].vec[j] = pub->at[j].vec[i];
+      pub->at[j].vec[i] = t;
+    }
+  }
+}
+
+
+/*************************************************
+* Name:        indcpa_enc_expanded
+*
+* Description: Encryption function of the CPA-secure public-key
+*              encryption scheme, for a public key expanded by
+*              indcpa_keypair_expanded_derand or indcpa_enc.
 *
 * Arguments:   - uint8_t *c: pointer to output ciphertext
 *                            (of length KYBER_INDCPA_BYTES bytes)
 *              - const uint8_t *m: pointer to input message
 *                                  (of length KYBER_INDCPA_MSGBYTES bytes)
-*              - const uint8_t *pk: pointer to input public key
-*                                   (of length KYBER_INDCPA_PUBLICKEYBYTES)
+*              - const indcpa_public *pub: pointer to expanded public key
 *              - const uint8_t *coins: pointer to input random coins used as seed
 *                                      (of length KYBER_SYMBYTES) to deterministically
 *                                      generate all randomness
 **************************************************/
-void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
-                const uint8_t m[KYBER_INDCPA_MSGBYTES],
-                const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
-                const uint8_t coins[KYBER_SYMBYTES])
+void indcpa_enc_expanded(uint8_t c[KYBER_INDCPA_BYTES],
+                         const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                         const indcpa_public *pub,
+                         const uint8_t coins[KYBER_SYMBYTES])
 {
   unsigned int i;
-  uint8_t seed[KYBER_SYMBYTES];
-  uint8_t nonce = 0;
-  polyvec sp, pkpv, ep, at[KYBER_K], b;
+  poly *noise[2*KYBER_K+1];
+  polyvec sp, ep, b;
   poly v, k, epp;
 
-  unpack_pk(&pkpv, seed, pk);
   poly_frommsg(&k, m);
-  gen_at(at, seed);
 
-  for(i=0;i<KYBER_K;i++)
-    poly_getnoise_eta1(sp.vec+i, coins, nonce++);
-  for(i=0;i<KYBER_K;i++)
-    poly_getnoise_eta2(ep.vec+i, coins, nonce++);
-  poly_getnoise_eta2(&epp, coins, nonce++);
+  for(i=0;i<KYBER_K;i++) {
+    noise[i] = sp.vec+i;
+    noise[KYBER_K+i] = ep.vec+i;
+  }
+  noise[2*KYBER_K] = &epp;
+  poly_getnoise_many(noise, 2*KYBER_K+1, KYBER_K, coins, 0);
 
   polyvec_ntt(&sp);
 
   // matrix-vector multiplication
   for(i=0;i<KYBER_K;i++)
-    polyvec_basemul_acc_montgomery(&b.vec[i], &at[i], &sp);
+    polyvec_basemul_acc_montgomery(&b.vec[i], &pub->at[i], &sp);
 
-  polyvec_basemul_acc_montgomery(&v, &pkpv, &sp);
+  polyvec_basemul_acc_montgomery(&v, &pub->pkpv, &sp);
 
   polyvec_invntt_tomont(&b);
   poly_invntt_tomont(&v);
@@ -298,6 +359,35 @@ void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
   pack_ciphertext(c, &b, &v);
 }
 
+/*************************************************
+* Name:        indcpa_enc
+*
+* Description: Encryption function of the CPA-secure
+*              public-key encryption scheme underlying Kyber.
+*
+* Arguments:   - uint8_t *c: pointer to output ciphertext
+*                            (of length KYBER_INDCPA_BYTES bytes)
+*              - const uint8_t *m: pointer to input message
+*                                  (of length KYBER_INDCPA_MSGBYTES bytes)
+*              - const uint8_t *pk: pointer to input public key
+*                                   (of length KYBER_INDCPA_PUBLICKEYBYTES)
+*              - const uint8_t *coins: pointer to input random coins used as seed
+*                                      (of length KYBER_SYMBYTES) to deterministically
+*                                      generate all randomness
+**************************************************/
+void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
+                const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                const uint8_t coins[KYBER_SYMBYTES])
+{
+  uint8_t seed[KYBER_SYMBYTES];
+  indcpa_public pub;
+
+  unpack_pk(&pub.pkpv, seed, pk);
+  gen_at(pub.at, seed);
+  indcpa_enc_expanded(c, m, &pub, coins);
+}
+
 /*************************************************
 * Name:        indcpa_dec
 *
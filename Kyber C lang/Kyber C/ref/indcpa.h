@@ -8,17 +8,35 @@
 #define gen_matrix KYBER_NAMESPACE(gen_matrix)
 void gen_matrix(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], int transposed);
 
+/* Public key as indcpa_enc uses it: A^T and t, both in NTT domain */
+typedef struct {
+  polyvec at[KYBER_K];
+  polyvec pkpv;
+} indcpa_public;
+
 #define indcpa_keypair_derand KYBER_NAMESPACE(indcpa_keypair_derand)
 void indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
                            uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
                            const uint8_t coins[KYBER_SYMBYTES]);
 
+#define indcpa_keypair_expanded_derand KYBER_NAMESPACE(indcpa_keypair_expanded_derand)
+void indcpa_keypair_expanded_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                                    uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                                    const uint8_t coins[KYBER_SYMBYTES],
+                                    indcpa_public *pub);
+
 #define indcpa_enc KYBER_NAMESPACE(indcpa_enc)
 void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
                 const uint8_t m[KYBER_INDCPA_MSGBYTES],
                 const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
                 const uint8_t coins[KYBER_SYMBYTES]);
 
+#define indcpa_enc_expanded KYBER_NAMESPACE(indcpa_enc_expanded)
+void indcpa_enc_expanded(uint8_t c[KYBER_INDCPA_BYTES],
+                         const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                         const indcpa_public *pub,
+                         const uint8_t coins[KYBER_SYMBYTES]);
+
 #define indcpa_dec KYBER_NAMESPACE(indcpa_dec)
 void indcpa_dec(uint8_t m[KYBER_INDCPA_MSGBYTES],
                 const uint8_t c[KYBER_INDCPA_BYTES],
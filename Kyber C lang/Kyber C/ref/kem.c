@@ -56,6 +56,92 @@ int crypto_kem_keypair(uint8_t *pk,
   return 0;
 }
 
+/*************************************************
+* Name:        crypto_kem_keypair_pct_derand
+*
+* Description: Generates public and private key like
+*              crypto_kem_keypair_derand, then runs a pairwise consistency
+*              test: encapsulates to the new public key and decapsulates
+*              with the new secret key. Both encryptions of the test (the
+*              encapsulation and the re-encryption in decapsulation) use
+*              A^T and the public-key polyvec from key generation instead of
+*              unpacking pk and sampling A^T again. Decryption reads the
+*              packed secret key, so the packing is covered too. The test
+*              message is H(pk); no randomness is drawn.
+*
+* Arguments:   - uint8_t *pk: pointer to output public key
+*                (an already allocated array of KYBER_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk: pointer to output private key
+*                (an already allocated array of KYBER_SECRETKEYBYTES bytes)
+*              - uint8_t *coins: pointer to input randomness
+*                (an already allocated array filled with 2*KYBER_SYMBYTES random bytes)
+**
+* Returns 0 (success) or -1 if the test fails; pk and sk are zeroed then
+**************************************************/
+int crypto_kem_keypair_pct_derand(uint8_t *pk,
+                                  uint8_t *sk,
+                                  const uint8_t *coins)
+{
+  int fail;
+  indcpa_public pub;
+  uint8_t buf[2*KYBER_SYMBYTES];
+  /* Will contain key, coins */
+  uint8_t kr[2*KYBER_SYMBYTES];
+  uint8_t ss[KYBER_SSBYTES];
+  uint8_t ct[KYBER_CIPHERTEXTBYTES];
+  uint8_t cmp[KYBER_CIPHERTEXTBYTES];
+  const uint8_t *h = sk+KYBER_SECRETKEYBYTES-2*KYBER_SYMBYTES;
+
+  indcpa_keypair_expanded_derand(pk, sk, coins, &pub);
+  memcpy(sk+KYBER_INDCPA_SECRETKEYBYTES, pk, KYBER_PUBLICKEYBYTES);
+  hash_h(sk+KYBER_SECRETKEYBYTES-2*KYBER_SYMBYTES, pk, KYBER_PUBLICKEYBYTES);
+  /* Value z for pseudo-random output on reject */
+  memcpy(sk+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES, coins+KYBER_SYMBYTES, KYBER_SYMBYTES);
+
+  /* Encapsulate */
+  memcpy(buf, h, KYBER_SYMBYTES);
+  memcpy(buf+KYBER_SYMBYTES, h, KYBER_SYMBYTES);
+  hash_g(kr, buf, 2*KYBER_SYMBYTES);
+  indcpa_enc_expanded(ct, buf, &pub, kr+KYBER_SYMBYTES);
+  memcpy(ss, kr, KYBER_SYMBYTES);
+
+  /* Decapsulate */
+  indcpa_dec(buf, ct, sk);
+  memcpy(buf+KYBER_SYMBYTES, h, KYBER_SYMBYTES);
+  hash_g(kr, buf, 2*KYBER_SYMBYTES);
+  indcpa_enc_expanded(cmp, buf, &pub, kr+KYBER_SYMBYTES);
+
+  fail = verify(ct, cmp, KYBER_CIPHERTEXTBYTES);
+  fail |= verify(ss, kr, KYBER_SSBYTES);
+  if(fail) {
+    memset(pk, 0, KYBER_PUBLICKEYBYTES);
+    memset(sk, 0, KYBER_SECRETKEYBYTES);
+    return -1;
+  }
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_kem_keypair_pct
+*
+* Description: Generates public and private key and runs the pairwise
+*              consistency test of crypto_kem_keypair_pct_derand
+*
+* Arguments:   - uint8_t *pk: pointer to output public key
+*                (an already allocated array of KYBER_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk: pointer to output private key
+*                (an already allocated array of KYBER_SECRETKEYBYTES bytes)
+*
+* Returns 0 (success) or -1 if the test fails
+**************************************************/
+int crypto_kem_keypair_pct(uint8_t *pk,
+                           uint8_t *sk)
+{
+  uint8_t coins[2*KYBER_SYMBYTES];
+  randombytes(coins, 2*KYBER_SYMBYTES);
+  return crypto_kem_keypair_pct_derand(pk, sk, coins);
+}
+
 /*************************************************
 * Name:        crypto_kem_enc_derand
 *
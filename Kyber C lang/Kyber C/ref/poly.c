@@ -248,6 +248,53 @@ void poly_getnoise_eta2(poly *r, const uint8_t seed[KYBER_SYMBYTES], uint8_t non
   poly_cbd_eta2(r, buf);
 }
 
+/*************************************************
+* Name:        poly_getnoise_many
+*
+* Description: Sample n polynomials at once, the first n1 with parameter
+*              KYBER_ETA1 and the others with KYBER_ETA2, using the nonces
+*              nonce, nonce+1, ..., nonce+n-1. Equivalent to calling
+*              poly_getnoise_eta1/poly_getnoise_eta2 for each of them, but
+*              all PRF instances are permuted as one batch and the CBD reads
+*              the Keccak states in place.
+*
+* Arguments:   - poly **r: pointers to n output polynomials
+*              - unsigned int n: number of polynomials (at most 2*KYBER_K+1)
+*              - unsigned int n1: number of polynomials sampled with KYBER_ETA1
+*              - const uint8_t *seed: pointer to input seed
+*                                     (of length KYBER_SYMBYTES bytes)
+*              - uint8_t nonce: one-byte nonce of the first polynomial
+**************************************************/
+void poly_getnoise_many(poly *r[], unsigned int n, unsigned int n1, const uint8_t seed[KYBER_SYMBYTES], uint8_t nonce)
+{
+  unsigned int i;
+  uint64_t s[2*KYBER_K+1][25];
+#if KYBER_ETA1*KYBER_N/4 > SHAKE256_RATE
+  unsigned int j;
+  uint64_t buf[2*KYBER_K][KYBER_ETA1*KYBER_N/32];
+#endif
+
+  prf_many(s, n, seed, nonce);
+  for(i=n1;i<n;i++)
+    poly_cbd_eta2_lanes(r[i], s[i]);
+
+#if KYBER_ETA1*KYBER_N/4 > SHAKE256_RATE
+  /* Kyber-512 needs a second output block for its eta1 polynomials */
+  for(i=0;i<n1;i++)
+    for(j=0;j<SHAKE256_RATE/8;j++)
+      buf[i][j] = s[i][j];
+  prf_squeeze_many(s, n1);
+  for(i=0;i<n1;i++) {
+    for(j=SHAKE256_RATE/8;j<KYBER_ETA1*KYBER_N/32;j++)
+      buf[i][j] = s[i][j-SHAKE256_RATE/8];
+    poly_cbd_eta1_lanes(r[i], buf[i]);
+  }
+#else
+  for(i=0;i<n1;i++)
+    poly_cbd_eta1_lanes(r[i], s[i]);
+#endif
+}
+
 
 /*************************************************
 * Name:        poly_ntt
@@ -1,6 +1,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "randombytes.h"
 
 #ifdef _WIN32
@@ -9,6 +10,8 @@
 #else
 #include <fcntl.h>
 #include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #ifdef __linux__
 #define _GNU_SOURCE
 #include <unistd.h>
@@ -21,7 +24,7 @@
 #endif
 
 #ifdef _WIN32
-void randombytes(uint8_t *out, size_t outlen) {
+static void randombytes_sys(uint8_t *out, size_t outlen) {
   HCRYPTPROV ctx;
   size_t len;
 
@@ -41,7 +44,7 @@ void randombytes(uint8_t *out, size_t outlen) {
     abort();
 }
 #elif defined(__linux__) && defined(SYS_getrandom)
-void randombytes(uint8_t *out, size_t outlen) {
+static void randombytes_sys(uint8_t *out, size_t outlen) {
   ssize_t ret;
 
   while(outlen > 0) {
@@ -56,7 +59,7 @@ void randombytes(uint8_t *out, size_t outlen) {
   }
 }
 #elif defined(__NetBSD__)
-void randombytes(uint8_t *out, size_t outlen) {
+static void randombytes_sys(uint8_t *out, size_t outlen) {
   ssize_t ret;
 
   while(outlen > 0) {
@@ -71,7 +74,7 @@ void randombytes(uint8_t *out, size_t outlen) {
   }
 }
 #else
-void randombytes(uint8_t *out, size_t outlen) {
+static void randombytes_sys(uint8_t *out, size_t outlen) {
   static int fd = -1;
   ssize_t ret;
 
@@ -95,3 +98,92 @@ void randombytes(uint8_t *out, size_t outlen) {
   }
 }
 #endif
+
+#ifndef RANDOMBYTES_BUFSIZE
+#define RANDOMBYTES_BUFSIZE 4096
+#endif
+
+#if defined(_MSC_VER)
+#define RANDOMBYTES_TLS __declspec(thread)
+#else
+#define RANDOMBYTES_TLS _Thread_local
+#endif
+
+/* Per-thread buffer of system randomness; pos is the first unused byte */
+static RANDOMBYTES_TLS struct {
+  uint8_t buf[RANDOMBYTES_BUFSIZE];
+  size_t pos;
+  unsigned long forks;
+} rb = { {0}, RANDOMBYTES_BUFSIZE, 0 };
+
+#ifdef _WIN32
+static unsigned long randombytes_forks(void) {
+  return 0;
+}
+#else
+/* Incremented in the child after fork() so that it does not hand out the
+ * same buffered bytes as its parent. The handler is registered once, by
+ * whichever thread first asks for buffered bytes. */
+static _Atomic unsigned long rb_forks;
+static pthread_once_t rb_atfork = PTHREAD_ONCE_INIT;
+
+static void randombytes_child(void) {
+  atomic_fetch_add(&rb_forks, 1);
+}
+
+static void randombytes_atfork(void) {
+  if(pthread_atfork(NULL, NULL, randombytes_child))
+    abort();
+}
+
+static unsigned long randombytes_forks(void) {
+  if(pthread_once(&rb_atfork, randombytes_atfork))
+    abort();
+  return atomic_load(&rb_forks);
+}
+#endif
+
+/*************************************************
+* Name:        randombytes
+*
+* Description: Fill output with randomness from the operating system.
+*              Requests below RANDOMBYTES_BUFSIZE bytes are served from a
+*              per-thread buffer that is refilled with one system call when
+*              exhausted, or discarded after a fork; every byte is erased
+*              from the buffer once handed out. Larger requests go to the
+*              system directly.
+*
+* Arguments:   - uint8_t *out: pointer to output
+*              - size_t outlen: number of random bytes to write to out
+**************************************************/
+void randombytes(uint8_t *out, size_t outlen) {
+  size_t n;
+  unsigned long forks;
+
+  if(outlen >= RANDOMBYTES_BUFSIZE) {
+    randombytes_sys(out, outlen);
+    return;
+  }
+
+  forks = randombytes_forks();
+  if(rb.forks != forks) {
+    memset(rb.buf, 0, sizeof(rb.buf));
+    rb.pos = RANDOMBYTES_BUFSIZE;
+    rb.forks = forks;
+  }
+
+  while(outlen > 0) {
+    if(rb.pos == RANDOMBYTES_BUFSIZE) {
+      randombytes_sys(rb.buf, RANDOMBYTES_BUFSIZE);
+      rb.pos = 0;
+    }
+
+    n = RANDOMBYTES_BUFSIZE - rb.pos;
+    n = (n < outlen) ? n : outlen;
+    memcpy(out, rb.buf + rb.pos, n);
+    memset(rb.buf + rb.pos, 0, n);
+    rb.pos += n;
+    out += n;
+    outlen -= n;
+  }
+}
@@ -4,6 +4,26 @@
 #include "params.h"
 #include "symmetric.h"
 #include "fips202.h"
+#include "keccakf1600.h"
+
+/*************************************************
+* Name:        load64
+*
+* Description: Load 8 bytes into uint64_t in little-endian order
+*
+* Arguments:   - const uint8_t *x: pointer to input byte array
+*
+* Returns the loaded 64-bit unsigned integer
+**************************************************/
+static uint64_t load64(const uint8_t x[8]) {
+  unsigned int i;
+  uint64_t r = 0;
+
+  for(i=0;i<8;i++)
+    r |= (uint64_t)x[i] << 8*i;
+
+  return r;
+}
 
 /*************************************************
 * Name:        kyber_shake128_absorb
@@ -50,6 +70,48 @@ void kyber_shake256_prf(uint8_t *out, size_t outlen, const uint8_t key[KYBER_SYM
   shake256(out, outlen, extkey, sizeof(extkey));
 }
 
+/*************************************************
+* Name:        kyber_shake256_prf_many
+*
+* Description: The PRF for n consecutive nonces at once. Absorbs key || nonce+i
+*              into state i and permutes all states as one batch, so that
+*              each state holds its first SHAKE256_RATE output bytes in
+*              lanes 0 to SHAKE256_RATE/8-1, ready to be read in place.
+*
+* Arguments:   - uint64_t (*s)[25]: pointer to n output Keccak states
+*              - unsigned int n: number of states
+*              - const uint8_t *key: pointer to the key (of length KYBER_SYMBYTES)
+*              - uint8_t nonce: nonce of the first state
+**************************************************/
+void kyber_shake256_prf_many(uint64_t s[][25], unsigned int n, const uint8_t key[KYBER_SYMBYTES], uint8_t nonce)
+{
+  unsigned int i, j;
+
+  for(i=0;i<n;i++) {
+    for(j=0;j<KYBER_SYMBYTES/8;j++)
+      s[i][j] = load64(key+8*j);
+    s[i][KYBER_SYMBYTES/8] = (uint8_t)(nonce+i) | (uint64_t)0x1F << 8;
+    for(j=KYBER_SYMBYTES/8+1;j<25;j++)
+      s[i][j] = 0;
+    s[i][(SHAKE256_RATE-1)/8] ^= (uint64_t)1 << 63;
+  }
+
+  KeccakF1600_StatePermute_many(s, n);
+}
+
+/*************************************************
+* Name:        kyber_shake256_squeeze_many
+*
+* Description: Advance n PRF states to their next SHAKE256_RATE output bytes
+*
+* Arguments:   - uint64_t (*s)[25]: pointer to n Keccak states
+*              - unsigned int n: number of states
+**************************************************/
+void kyber_shake256_squeeze_many(uint64_t s[][25], unsigned int n)
+{
+  KeccakF1600_StatePermute_many(s, n);
+}
+
 /*************************************************
 * Name:        kyber_shake256_prf
 *
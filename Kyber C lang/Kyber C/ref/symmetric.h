@@ -18,6 +18,12 @@ void kyber_shake128_absorb(keccak_state *s,
 #define kyber_shake256_prf KYBER_NAMESPACE(kyber_shake256_prf)
 void kyber_shake256_prf(uint8_t *out, size_t outlen, const uint8_t key[KYBER_SYMBYTES], uint8_t nonce);
 
+#define kyber_shake256_prf_many KYBER_NAMESPACE(kyber_shake256_prf_many)
+void kyber_shake256_prf_many(uint64_t s[][25], unsigned int n, const uint8_t key[KYBER_SYMBYTES], uint8_t nonce);
+
+#define kyber_shake256_squeeze_many KYBER_NAMESPACE(kyber_shake256_squeeze_many)
+void kyber_shake256_squeeze_many(uint64_t s[][25], unsigned int n);
+
 #define kyber_shake256_rkprf KYBER_NAMESPACE(kyber_shake256_rkprf)
 void kyber_shake256_rkprf(uint8_t out[KYBER_SSBYTES], const uint8_t key[KYBER_SYMBYTES], const uint8_t input[KYBER_CIPHERTEXTBYTES]);
 
@@ -28,6 +34,8 @@ void kyber_shake256_rkprf(uint8_t out[KYBER_SSBYTES], const uint8_t key[KYBER_SY
 #define xof_absorb(STATE, SEED, X, Y) kyber_shake128_absorb(STATE, SEED, X, Y)
 #define xof_squeezeblocks(OUT, OUTBLOCKS, STATE) shake128_squeezeblocks(OUT, OUTBLOCKS, STATE)
 #define prf(OUT, OUTBYTES, KEY, NONCE) kyber_shake256_prf(OUT, OUTBYTES, KEY, NONCE)
+#define prf_many(STATES, N, KEY, NONCE) kyber_shake256_prf_many(STATES, N, KEY, NONCE)
+#define prf_squeeze_many(STATES, N) kyber_shake256_squeeze_many(STATES, N)
 #define rkprf(OUT, KEY, INPUT) kyber_shake256_rkprf(OUT, KEY, INPUT)
 
 #endif /* SYMMETRIC_H */
@@ -0,0 +1,123 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "../kem.h"
+#include "../params.h"
+#include "../verify.h"
+#include "../randombytes.h"
+#include "ct.h"
+
+/*
+ * Constant-time checks for the KEM: a dudect-style timing test of
+ * decapsulation and of the comparison and conditional move it relies on.
+ * See ct.h for the method.
+ *
+ * With -DCT_VALGRIND, encapsulation and decapsulation also run once with
+ * the coins and the secret key marked as secret.
+ */
+
+#ifndef NMEASURES
+#define NMEASURES 100000
+#endif
+
+static uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+static uint8_t sk[CRYPTO_SECRETKEYBYTES];
+static uint8_t ct_valid[CRYPTO_CIPHERTEXTBYTES];
+
+/* Class 0: valid ciphertext; class 1: uniformly random ciphertext */
+static void prepare_dec(uint8_t *in, int cls)
+{
+  if(cls == 0)
+    memcpy(in, ct_valid, CRYPTO_CIPHERTEXTBYTES);
+  else
+    randombytes(in, CRYPTO_CIPHERTEXTBYTES);
+}
+
+static void run_dec(uint8_t *in)
+{
+  uint8_t key[CRYPTO_BYTES];
+  crypto_kem_dec(key, in, sk);
+}
+
+/* Class 0: equal inputs; class 1: inputs differing in a random byte */
+static void prepare_verify(uint8_t *in, int cls)
+{
+  uint32_t i;
+
+  randombytes(in, CRYPTO_CIPHERTEXTBYTES);
+  memcpy(in + CRYPTO_CIPHERTEXTBYTES, in, CRYPTO_CIPHERTEXTBYTES);
+  if(cls == 1) {
+    randombytes((uint8_t *)&i, sizeof(i));
+    in[CRYPTO_CIPHERTEXTBYTES + i % CRYPTO_CIPHERTEXTBYTES] ^= 1;
+  }
+}
+
+static void run_verify(uint8_t *in)
+{
+  volatile int r;
+  r = verify(in, in + CRYPTO_CIPHERTEXTBYTES, CRYPTO_CIPHERTEXTBYTES);
+  (void)r;
+}
+
+/* Class 0: condition 0; class 1: condition 1 */
+static void prepare_cmov(uint8_t *in, int cls)
+{
+  randombytes(in, KYBER_SSBYTES);
+  in[KYBER_SSBYTES] = cls;
+}
+
+static void run_cmov(uint8_t *in)
+{
+  uint8_t r[KYBER_SSBYTES] = {0};
+  cmov(r, in, KYBER_SSBYTES, in[KYBER_SSBYTES]);
+  __asm__ volatile("" : : "r"(r) : "memory");
+}
+
+static const ct_target targets[] = {
+  { "crypto_kem_dec (valid vs random ct)", CRYPTO_CIPHERTEXTBYTES, prepare_dec, run_dec },
+  { "verify (equal vs different)", 2*CRYPTO_CIPHERTEXTBYTES, prepare_verify, run_verify },
+  { "cmov (b = 0 vs b = 1)", KYBER_SSBYTES+1, prepare_cmov, run_cmov },
+};
+
+#ifdef CT_VALGRIND
+static void run_kem_secret(void)
+{
+  uint8_t coins[KYBER_SYMBYTES];
+  uint8_t ct[CRYPTO_CIPHERTEXTBYTES];
+  uint8_t key[CRYPTO_BYTES];
+
+  /* Encapsulation: coins are secret, the public key is not */
+  randombytes(coins, sizeof(coins));
+  ct_poison(coins, sizeof(coins));
+  crypto_kem_enc_derand(ct, key, pk, coins);
+  ct_unpoison(ct, sizeof(ct));
+
+  /* Decapsulation: the IND-CPA secret key and z are secret; the copy of the
+   * public key and its hash stored in sk are not */
+  ct_poison(sk, KYBER_INDCPA_SECRETKEYBYTES);
+  ct_poison(sk + CRYPTO_SECRETKEYBYTES - KYBER_SYMBYTES, KYBER_SYMBYTES);
+  crypto_kem_dec(key, ct, sk);
+  ct[0] ^= 1;
+  crypto_kem_dec(key, ct, sk);
+  ct_unpoison(sk, CRYPTO_SECRETKEYBYTES);
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  unsigned long nmeasures = NMEASURES;
+  uint8_t key[CRYPTO_BYTES];
+
+  if(argc > 1)
+    nmeasures = strtoul(argv[1], NULL, 10);
+
+  crypto_kem_keypair(pk, sk);
+  crypto_kem_enc(ct_valid, key, pk);
+#ifdef CT_VALGRIND
+  run_kem_secret();
+#endif
+
+  return ct_run(CRYPTO_ALGNAME, targets, sizeof(targets)/sizeof(targets[0]), nmeasures);
+}
@@ -94,6 +94,39 @@ static int test_invalid_ciphertext(void)
   return 0;
 }
 
+static int test_keypair_pct(void)
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t pk2[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk2[CRYPTO_SECRETKEYBYTES];
+  uint8_t coins[2*KYBER_SYMBYTES];
+  uint8_t ct[CRYPTO_CIPHERTEXTBYTES];
+  uint8_t key_a[CRYPTO_BYTES];
+  uint8_t key_b[CRYPTO_BYTES];
+
+  //Keygen with consistency test gives the same keys as without
+  randombytes(coins, sizeof(coins));
+  if(crypto_kem_keypair_pct_derand(pk, sk, coins)) {
+    printf("ERROR pairwise consistency test\n");
+    return 1;
+  }
+  crypto_kem_keypair_derand(pk2, sk2, coins);
+  if(memcmp(pk, pk2, CRYPTO_PUBLICKEYBYTES) || memcmp(sk, sk2, CRYPTO_SECRETKEYBYTES)) {
+    printf("ERROR keys with and without consistency test\n");
+    return 1;
+  }
+
+  crypto_kem_enc(ct, key_b, pk);
+  crypto_kem_dec(key_a, ct, sk);
+  if(memcmp(key_a, key_b, CRYPTO_BYTES)) {
+    printf("ERROR keys from consistency test\n");
+    return 1;
+  }
+
+  return 0;
+}
+
 int main(void)
 {
   unsigned int i;
@@ -103,6 +136,7 @@ int main(void)
     r  = test_keys();
     r |= test_invalid_sk_a();
     r |= test_invalid_ciphertext();
+    r |= test_keypair_pct();
     if(r)
       return 1;
   }
@@ -13,7 +13,8 @@
 
 #define NTESTS 1000
 
-uint64_t t[NTESTS];
+uint64_t *t;
+size_t ntests;
 uint8_t seed[KYBER_SYMBYTES] = {0};
 
 int main(void)
@@ -27,129 +28,148 @@ int main(void)
   uint8_t coins64[2*KYBER_SYMBYTES];
   polyvec matrix[KYBER_K];
   poly ap;
+#ifdef poly_getnoise_many
+  poly *noise[2*KYBER_K+1];
+#endif
+
+  ntests = speed_init(CRYPTO_ALGNAME, NTESTS);
+  t = malloc(ntests * sizeof(uint64_t));
+  if(!t)
+    return 1;
 
   randombytes(coins32, KYBER_SYMBYTES);
   randombytes(coins64, 2*KYBER_SYMBYTES);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     gen_matrix(matrix, seed, 0);
   }
-  print_results("gen_a: ", t, NTESTS);
+  print_results("gen_a: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     poly_getnoise_eta1(&ap, seed, 0);
   }
-  print_results("poly_getnoise_eta1: ", t, NTESTS);
+  print_results("poly_getnoise_eta1: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     poly_getnoise_eta2(&ap, seed, 0);
   }
-  print_results("poly_getnoise_eta2: ", t, NTESTS);
+  print_results("poly_getnoise_eta2: ", t, ntests);
+
+#ifdef poly_getnoise_many
+  for(i=0;i<2*KYBER_K+1;i++)
+    noise[i] = (i < KYBER_K) ? &matrix[0].vec[i] : (i < 2*KYBER_K) ? &matrix[1].vec[i-KYBER_K] : &ap;
+  for(i=0;i<ntests;i++) {
+    t[i] = cpucycles();
+    poly_getnoise_many(noise, 2*KYBER_K+1, KYBER_K, seed, 0);
+  }
+  print_results("poly_getnoise_many (enc): ", t, ntests);
+#endif
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     poly_ntt(&ap);
   }
-  print_results("NTT: ", t, NTESTS);
+  print_results("NTT: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     poly_invntt_tomont(&ap);
   }
-  print_results("INVNTT: ", t, NTESTS);
+  print_results("INVNTT: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     polyvec_basemul_acc_montgomery(&ap, &matrix[0], &matrix[1]);
   }
-  print_results("polyvec_basemul_acc_montgomery: ", t, NTESTS);
+  print_results("polyvec_basemul_acc_montgomery: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     poly_tomsg(ct,&ap);
   }
-  print_results("poly_tomsg: ", t, NTESTS);
+  print_results("poly_tomsg: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     poly_frommsg(&ap,ct);
   }
-  print_results("poly_frommsg: ", t, NTESTS);
+  print_results("poly_frommsg: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     poly_compress(ct,&ap);
   }
-  print_results("poly_compress: ", t, NTESTS);
+  print_results("poly_compress: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     poly_decompress(&ap,ct);
   }
-  print_results("poly_decompress: ", t, NTESTS);
+  print_results("poly_decompress: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     polyvec_compress(ct,&matrix[0]);
   }
-  print_results("polyvec_compress: ", t, NTESTS);
+  print_results("polyvec_compress: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     polyvec_decompress(&matrix[0],ct);
   }
-  print_results("polyvec_decompress: ", t, NTESTS);
+  print_results("polyvec_decompress: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     indcpa_keypair_derand(pk, sk, coins32);
   }
-  print_results("indcpa_keypair: ", t, NTESTS);
+  print_results("indcpa_keypair: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     indcpa_enc(ct, key, pk, seed);
   }
-  print_results("indcpa_enc: ", t, NTESTS);
+  print_results("indcpa_enc: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     indcpa_dec(key, ct, sk);
   }
-  print_results("indcpa_dec: ", t, NTESTS);
+  print_results("indcpa_dec: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     crypto_kem_keypair_derand(pk, sk, coins64);
   }
-  print_results("kyber_keypair_derand: ", t, NTESTS);
+  print_results("kyber_keypair_derand: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     crypto_kem_keypair(pk, sk);
   }
-  print_results("kyber_keypair: ", t, NTESTS);
+  print_results("kyber_keypair: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     crypto_kem_enc_derand(ct, key, pk, coins32);
   }
-  print_results("kyber_encaps_derand: ", t, NTESTS);
+  print_results("kyber_encaps_derand: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     crypto_kem_enc(ct, key, pk);
   }
-  print_results("kyber_encaps: ", t, NTESTS);
+  print_results("kyber_encaps: ", t, ntests);
 
-  for(i=0;i<NTESTS;i++) {
+  for(i=0;i<ntests;i++) {
     t[i] = cpucycles();
     crypto_kem_dec(key, ct, sk);
   }
-  print_results("kyber_decaps: ", t, NTESTS);
+  print_results("kyber_decaps: ", t, ntests);
 
-  return 0;
+  free(t);
+  return speed_finish();
 }
@@ -0,0 +1,59 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "../kem.h"
+#include "../params.h"
+#include "bench_threads.h"
+
+/* Per-thread key pair and ciphertext; keygen and encaps write to scratch */
+typedef struct {
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t ct[CRYPTO_CIPHERTEXTBYTES];
+  uint8_t pk2[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk2[CRYPTO_SECRETKEYBYTES];
+  uint8_t ct2[CRYPTO_CIPHERTEXTBYTES];
+  uint8_t key[CRYPTO_BYTES];
+} kem_ctx;
+
+static void setup(void *p)
+{
+  kem_ctx *c = p;
+
+  crypto_kem_keypair(c->pk, c->sk);
+  crypto_kem_enc(c->ct, c->key, c->pk);
+}
+
+static void keygen(void *p)
+{
+  kem_ctx *c = p;
+  crypto_kem_keypair(c->pk2, c->sk2);
+}
+
+static void encaps(void *p)
+{
+  kem_ctx *c = p;
+  crypto_kem_enc(c->ct2, c->key, c->pk);
+}
+
+static void decaps(void *p)
+{
+  kem_ctx *c = p;
+  crypto_kem_dec(c->key, c->ct, c->sk);
+}
+
+static const bench_op ops[] = {
+  { "keygen", 1, keygen },
+  { "encaps", 1, encaps },
+  { "decaps", 1, decaps },
+};
+
+int main(int argc, char *argv[])
+{
+  const bench_config cfg = {
+    CRYPTO_ALGNAME, ops, sizeof(ops)/sizeof(ops[0]), sizeof(kem_ctx), setup
+  };
+
+  return bench_threads_main(&cfg, argc, argv);
+}
@@ -15,6 +15,10 @@ if [ "$ARCH" = "amd64" -o "$ARCH" = "arm64" ]; then
 #  export CFLAGS="-fsanitize=undefined,address ${CFLAGS}"
 fi
 
+make -j$(nproc) -C ../../q4_lib/fips202 clean
+make -j$(nproc) -C ../../q4_lib/fips202
+../../q4_lib/fips202/test/test_fips202
+
 for dir in $DIRS; do
   make -j$(nproc) -C $dir clean
   make -j$(nproc) -C $dir
@@ -25,6 +29,10 @@ for dir in $DIRS; do
     ./$dir/test/test_vectors$alg > tvecs$alg 
   done
   shasum -a256 -c SHA256SUMS
+  make -j$(nproc) -C $dir ct-valgrind
+  for alg in 512 768 1024; do
+    valgrind -q --error-exitcode=1 ./$dir/test/test_ct_valgrind$alg
+  done
 done
 
 exit 0
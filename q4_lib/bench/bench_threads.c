@@ -0,0 +1,405 @@
+#define _GNU_SOURCE
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+#include "bench_threads.h"
+
+/*
+ * Throughput benchmark: for every thread count, each thread is pinned to
+ * its own CPU and runs operations drawn at random (by weight) from the
+ * mix until the duration is over. One thread per physical core is used
+ * first; SMT siblings only with -smt. Latencies are kept per thread and
+ * operation, reservoir-sampled beyond LATCAP samples.
+ *
+ * Usage: test_throughput [-t 1,2,4] [-d seconds] [-m op=weight,...] [-smt] [-v]
+ * SPEED_FORMAT=csv prints one CSV row per thread count and operation.
+ */
+
+#define LATCAP 65536
+#define MAXCPUS 1024
+
+typedef struct {
+  uint32_t *lat;
+  size_t n;
+  uint64_t count;
+} op_stats;
+
+typedef struct {
+  pthread_t tid;
+  int cpu;
+  uint64_t rng;
+  void *ctx;
+  op_stats ops[BENCH_MAXOPS];
+} worker;
+
+static const bench_config *bcfg;
+static unsigned int weight[BENCH_MAXOPS], wsum;
+static pthread_barrier_t start_barrier;
+static atomic_int stop;
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint64_t xorshift64(uint64_t *s) {
+  *s ^= *s << 13;
+  *s ^= *s >> 7;
+  *s ^= *s << 17;
+  return *s;
+}
+
+static int cmp_u32(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of a sorted list, in microseconds */
+static double pct_us(const uint32_t *l, size_t n, unsigned int p) {
+  size_t i = (n * p + 99) / 100;
+
+  if(n == 0)
+    return 0;
+  return l[i ? i - 1 : 0] / 1e3;
+}
+
+/*************************************************
+* Name:        cpu_order
+*
+* Description: List the CPUs the process may run on, one per physical
+*              core first and their SMT siblings after that
+*
+* Arguments:   - int *cpus: output list of at least MAXCPUS entries
+*              - unsigned int *ncores: number of physical cores
+*
+* Returns the number of logical CPUs
+**************************************************/
+static unsigned int cpu_order(int *cpus, unsigned int *ncores) {
+  unsigned int i, n = 0, nsib = 0;
+  int sib[MAXCPUS];
+#ifdef __linux__
+  int cpu, first;
+  char path[96], list[64];
+  FILE *f;
+  cpu_set_t set;
+
+  if(sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for(cpu = 0; cpu < CPU_SETSIZE && cpu < MAXCPUS; cpu++) {
+      if(!CPU_ISSET(cpu, &set))
+        continue;
+      /* The lowest-numbered sibling represents the core */
+      first = cpu;
+      snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu);
+      f = fopen(path, "r");
+      if(f) {
+        if(fgets(list, sizeof(list), f))
+          first = atoi(list);
+        fclose(f);
+      }
+      if(first == cpu || !CPU_ISSET(first, &set))
+        cpus[n++] = cpu;
+      else
+        sib[nsib++] = cpu;
+    }
+  }
+#endif
+  if(n == 0) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    for(n = 0; n < (online > 0 ? (unsigned long)online : 1) && n < MAXCPUS; n++)
+      cpus[n] = -1;
+  }
+
+  *ncores = n;
+  for(i = 0; i < nsib; i++)
+    cpus[n + i] = sib[i];
+  return n + nsib;
+}
+
+static void record(op_stats *s, uint64_t *rng, uint32_t ns) {
+  uint64_t j;
+
+  s->count++;
+  if(s->n < LATCAP) {
+    s->lat[s->n++] = ns;
+    return;
+  }
+  j = xorshift64(rng) % s->count;
+  if(j < LATCAP)
+    s->lat[j] = ns;
+}
+
+static void *worker_main(void *arg) {
+  worker *w = arg;
+  unsigned int i, r;
+  uint64_t t0, t1;
+
+#ifdef __linux__
+  if(w->cpu >= 0) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(w->cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  }
+#endif
+  /* Per-thread keys are generated on the thread's own CPU */
+  bcfg->setup(w->ctx);
+  pthread_barrier_wait(&start_barrier);
+
+  while(!atomic_load_explicit(&stop, memory_order_relaxed)) {
+    r = xorshift64(&w->rng) % wsum;
+    for(i = 0; r >= weight[i]; i++)
+      r -= weight[i];
+
+    t0 = now_ns();
+    bcfg->ops[i].run(w->ctx);
+    t1 = now_ns();
+    record(&w->ops[i], &w->rng, (uint32_t)((t1 - t0) > UINT32_MAX ? UINT32_MAX : (t1 - t0)));
+  }
+
+  return NULL;
+}
+
+/*************************************************
+* Name:        run_threads
+*
+* Description: Run the operation mix on nthreads pinned threads and print
+*              throughput and latency percentiles
+*
+* Returns aggregate operations per second
+**************************************************/
+static double run_threads(unsigned int nthreads, const int *cpus, double seconds,
+                          double base, int csv, int verbose) {
+  unsigned int i, j;
+  size_t n;
+  uint64_t t0, t1, total = 0;
+  double ops_s, eff, p50, p50min, p50max;
+  uint32_t *all;
+  worker *w = calloc(nthreads, sizeof(worker));
+  struct timespec dur;
+
+  if(!w)
+    abort();
+  for(i = 0; i < nthreads; i++) {
+    w[i].cpu = cpus[i];
+    w[i].rng = 0x9E3779B97F4A7C15ULL * (i + 1);
+    w[i].ctx = malloc(bcfg->ctxlen);
+    if(!w[i].ctx)
+      abort();
+    for(j = 0; j < bcfg->nops; j++) {
+      w[i].ops[j].lat = malloc(LATCAP * sizeof(uint32_t));
+      if(!w[i].ops[j].lat)
+        abort();
+    }
+  }
+
+  atomic_store(&stop, 0);
+  pthread_barrier_init(&start_barrier, NULL, nthreads + 1);
+  for(i = 0; i < nthreads; i++)
+    if(pthread_create(&w[i].tid, NULL, worker_main, &w[i])) {
+      fprintf(stderr, "ERROR: Cannot create thread %u\n", i);
+      exit(1);
+    }
+
+  pthread_barrier_wait(&start_barrier);
+  t0 = now_ns();
+  dur.tv_sec = (time_t)seconds;
+  dur.tv_nsec = (long)((seconds - (double)dur.tv_sec) * 1e9);
+  nanosleep(&dur, NULL);
+  atomic_store(&stop, 1);
+  for(i = 0; i < nthreads; i++)
+    pthread_join(w[i].tid, NULL);
+  t1 = now_ns();
+  pthread_barrier_destroy(&start_barrier);
+
+  for(i = 0; i < nthreads; i++)
+    for(j = 0; j < bcfg->nops; j++)
+      total += w[i].ops[j].count;
+  ops_s = total / ((t1 - t0) / 1e9);
+  eff = base > 0 ? ops_s / nthreads / base : 1;
+
+  if(!csv)
+    printf("%s, %u threads: %.0f ops/s, %.0f ops/s per thread, scaling efficiency %.2f\n",
+           bcfg->scheme, nthreads, ops_s, ops_s / nthreads, eff);
+
+  all = malloc((size_t)nthreads * LATCAP * sizeof(uint32_t));
+  if(!all)
+    abort();
+  for(j = 0; j < bcfg->nops; j++) {
+    if(!weight[j])
+      continue;
+    n = 0;
+    p50min = 1e30;
+    p50max = 0;
+    total = 0;
+    for(i = 0; i < nthreads; i++) {
+      op_stats *s = &w[i].ops[j];
+      qsort(s->lat, s->n, sizeof(uint32_t), cmp_u32);
+      p50 = pct_us(s->lat, s->n, 50);
+      if(p50 < p50min) p50min = p50;
+      if(p50 > p50max) p50max = p50;
+      memcpy(all + n, s->lat, s->n * sizeof(uint32_t));
+      n += s->n;
+      total += s->count;
+      if(verbose && !csv)
+        printf("  thread %2u (cpu %3d) %-8s %10llu ops  p50 %9.1f  p99 %9.1f us\n", i, w[i].cpu,
+               bcfg->ops[j].name, (unsigned long long)s->count, p50, pct_us(s->lat, s->n, 99));
+    }
+    qsort(all, n, sizeof(uint32_t), cmp_u32);
+
+    if(csv)
+      printf("\"%s\",%u,\"%s\",%llu,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.3f\n", bcfg->scheme,
+             nthreads, bcfg->ops[j].name, (unsigned long long)total, total / ((t1 - t0) / 1e9),
+             pct_us(all, n, 50), pct_us(all, n, 90), pct_us(all, n, 99), pct_us(all, n, 100),
+             p50min, p50max, eff);
+    else
+      printf("  %-8s %10llu ops  p50 %9.1f  p90 %9.1f  p99 %9.1f  max %9.1f us"
+             "  (thread p50 %.1f..%.1f)\n", bcfg->ops[j].name, (unsigned long long)total,
+             pct_us(all, n, 50), pct_us(all, n, 90), pct_us(all, n, 99), pct_us(all, n, 100),
+             p50min, p50max);
+  }
+  if(!csv)
+    printf("\n");
+
+  free(all);
+  for(i = 0; i < nthreads; i++) {
+    for(j = 0; j < bcfg->nops; j++)
+      free(w[i].ops[j].lat);
+    free(w[i].ctx);
+  }
+  free(w);
+  return ops_s;
+}
+
+/* Parse "name=weight,..." into the weight table */
+static int parse_mix(const char *s) {
+  unsigned int j;
+  size_t len;
+  const char *eq;
+  char *end;
+
+  for(j = 0; j < bcfg->nops; j++)
+    weight[j] = 0;
+  while(*s) {
+    eq = strchr(s, '=');
+    if(!eq)
+      return -1;
+    len = eq - s;
+    for(j = 0; j < bcfg->nops; j++)
+      if(strlen(bcfg->ops[j].name) == len && !strncmp(bcfg->ops[j].name, s, len))
+        break;
+    if(j == bcfg->nops)
+      return -1;
+    weight[j] = strtoul(eq + 1, &end, 10);
+    if(end == eq + 1 || (*end && *end != ','))
+      return -1;
+    s = (*end == ',') ? end + 1 : end;
+  }
+  return 0;
+}
+
+/*************************************************
+* Name:        bench_threads_main
+*
+* Description: Parse the command line and run the throughput benchmark
+*              for every requested thread count
+*
+* Arguments:   - const bench_config *cfg: scheme, operations and per-thread
+*                state of the benchmark
+*              - int argc, char *argv[]: command line
+*
+* Returns 0 on success, 1 on usage errors
+**************************************************/
+int bench_threads_main(const bench_config *cfg, int argc, char *argv[]) {
+  int i, csv, verbose = 0, smt = 0, cpus[MAXCPUS];
+  unsigned int j, n, ncores, nlogical, maxthreads, nlist = 0, list[64];
+  double seconds = 2, base = 0, ops_s;
+  const char *s, *threads = NULL, *mix = NULL;
+  char *end;
+
+  bcfg = cfg;
+  if(cfg->nops > BENCH_MAXOPS)
+    abort();
+  wsum = 0;
+  for(j = 0; j < cfg->nops; j++)
+    weight[j] = cfg->ops[j].weight;
+
+  for(i = 1; i < argc; i++) {
+    if(!strcmp(argv[i], "-t") && i + 1 < argc)
+      threads = argv[++i];
+    else if(!strcmp(argv[i], "-d") && i + 1 < argc)
+      seconds = strtod(argv[++i], NULL);
+    else if(!strcmp(argv[i], "-m") && i + 1 < argc)
+      mix = argv[++i];
+    else if(!strcmp(argv[i], "-smt"))
+      smt = 1;
+    else if(!strcmp(argv[i], "-v"))
+      verbose = 1;
+    else
+      goto usage;
+  }
+
+  if(mix && parse_mix(mix))
+    goto usage;
+  for(j = 0; j < cfg->nops; j++)
+    wsum += weight[j];
+  if(wsum == 0 || seconds <= 0)
+    goto usage;
+
+  nlogical = cpu_order(cpus, &ncores);
+  maxthreads = smt ? nlogical : ncores;
+
+  if(threads) {
+    for(s = threads; *s && nlist < 64; s = (*end == ',') ? end + 1 : end) {
+      list[nlist] = strtoul(s, &end, 10);
+      if(end == s || list[nlist] == 0 || list[nlist] > MAXCPUS || (*end && *end != ','))
+        goto usage;
+      if(list[nlist] > maxthreads)
+        fprintf(stderr, "WARNING: %u threads on %u %s, threads will share CPUs\n", list[nlist],
+                maxthreads, smt ? "logical CPUs" : "cores (use -smt for siblings)");
+      nlist++;
+    }
+  }
+  else {
+    for(n = 1; n < maxthreads && nlist < 63; n *= 2)
+      list[nlist++] = n;
+    list[nlist++] = maxthreads;
+  }
+
+  csv = (s = getenv("SPEED_FORMAT")) && !strcmp(s, "csv");
+  if(csv)
+    printf("scheme,threads,op,ops,ops_per_s,p50_us,p90_us,p99_us,max_us,"
+           "thread_p50_min_us,thread_p50_max_us,efficiency\n");
+  else
+    printf("%s: %u cores, %u logical CPUs, %.1f s per run\n\n", cfg->scheme, ncores, nlogical, seconds);
+
+  for(j = 0; j < nlist; j++) {
+    int pinned[MAXCPUS];
+    for(n = 0; n < list[j]; n++)
+      pinned[n] = (list[j] > maxthreads) ? -1 : cpus[n];
+    ops_s = run_threads(list[j], pinned, seconds, base, csv, verbose);
+    /* Efficiency is relative to the per-thread rate of the first run */
+    if(j == 0)
+      base = ops_s / list[j];
+  }
+
+  return 0;
+
+usage:
+  fprintf(stderr, "Usage: %s [-t 1,2,4] [-d seconds] [-m op=weight,...] [-smt] [-v]\nOperations:",
+          argv[0]);
+  for(j = 0; j < cfg->nops; j++)
+    fprintf(stderr, " %s", cfg->ops[j].name);
+  fprintf(stderr, "\n");
+  return 1;
+}
@@ -0,0 +1,24 @@
+#ifndef BENCH_THREADS_H
+#define BENCH_THREADS_H
+
+#include <stddef.h>
+
+#define BENCH_MAXOPS 8
+
+typedef struct {
+  const char *name;
+  unsigned int weight;
+  void (*run)(void *ctx);
+} bench_op;
+
+typedef struct {
+  const char *scheme;
+  const bench_op *ops;
+  unsigned int nops;
+  size_t ctxlen;
+  void (*setup)(void *ctx);
+} bench_config;
+
+int bench_threads_main(const bench_config *cfg, int argc, char *argv[]);
+
+#endif
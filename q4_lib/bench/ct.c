@@ -0,0 +1,214 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "cpucycles.h"
+#include "ct.h"
+#ifdef CT_VALGRIND
+#include <valgrind/memcheck.h>
+#endif
+
+#define NBATCH 1000
+#define NCROPS 3
+
+/* From the randombytes.c of the scheme under test */
+void randombytes(uint8_t *out, size_t outlen);
+
+/* Running mean and variance (Welford) of each class */
+typedef struct {
+  double n[2], mean[2], m2[2];
+} ttest;
+
+static void ttest_push(ttest *t, int cls, double x)
+{
+  double d;
+
+  t->n[cls] += 1;
+  d = x - t->mean[cls];
+  t->mean[cls] += d / t->n[cls];
+  t->m2[cls] += d * (x - t->mean[cls]);
+}
+
+static double ttest_value(const ttest *t)
+{
+  double v0, v1;
+
+  if(t->n[0] < 2 || t->n[1] < 2)
+    return 0;
+  v0 = t->m2[0] / (t->n[0] - 1);
+  v1 = t->m2[1] / (t->n[1] - 1);
+  return (t->mean[0] - t->mean[1]) / sqrt(v0 / t->n[0] + v1 / t->n[1]);
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+/*************************************************
+* Name:        ct_poison
+*
+* Description: With CT_VALGRIND, mark a secret buffer as uninitialized so
+*              that memcheck reports branches and memory accesses that
+*              depend on it; no-op otherwise
+*
+* Arguments:   - const void *p: pointer to secret buffer
+*              - size_t len: length of buffer
+**************************************************/
+void ct_poison(const void *p, size_t len)
+{
+#ifdef CT_VALGRIND
+  VALGRIND_MAKE_MEM_UNDEFINED(p, len);
+#else
+  (void)p;
+  (void)len;
+#endif
+}
+
+/*************************************************
+* Name:        ct_unpoison
+*
+* Description: With CT_VALGRIND, mark a buffer as defined again, e.g. an
+*              output that is public; no-op otherwise
+*
+* Arguments:   - const void *p: pointer to buffer
+*              - size_t len: length of buffer
+**************************************************/
+void ct_unpoison(const void *p, size_t len)
+{
+#ifdef CT_VALGRIND
+  VALGRIND_MAKE_MEM_DEFINED(p, len);
+#else
+  (void)p;
+  (void)len;
+#endif
+}
+
+/*************************************************
+* Name:        ct_measure
+*
+* Description: Run a dudect-style timing test on one target
+*
+* Arguments:   - const ct_target *tg: target to measure
+*              - unsigned long nmeasures: number of measurements
+*
+* Returns largest |t| over the uncropped and cropped tests
+**************************************************/
+double ct_measure(const ct_target *tg, unsigned long nmeasures)
+{
+  unsigned int i, j;
+  unsigned long done;
+  double t, tmax = 0;
+  uint8_t cls[NBATCH];
+  uint64_t t0, dt[NBATCH], sorted[NBATCH], crop[NCROPS] = {0};
+  ttest tt[NCROPS+1];
+  /* Inputs may be polynomial vectors, which the SIMD code expects aligned */
+  size_t inlen = (tg->inlen + 63) & ~(size_t)63;
+  uint8_t *in = aligned_alloc(64, NBATCH * inlen);
+
+  if(!in)
+    abort();
+  memset(tt, 0, sizeof(tt));
+
+  for(done = 0; done < nmeasures; done += NBATCH) {
+    randombytes(cls, sizeof(cls));
+    for(i = 0; i < NBATCH; i++) {
+      cls[i] &= 1;
+      tg->prepare(in + i * inlen, cls[i]);
+    }
+
+    for(i = 0; i < NBATCH; i++) {
+      t0 = cpucycles();
+      tg->run(in + i * inlen);
+      dt[i] = cpucycles() - t0;
+    }
+
+    /* First batch is warm-up and sets the cropping thresholds */
+    if(done == 0) {
+      memcpy(sorted, dt, sizeof(dt));
+      qsort(sorted, NBATCH, sizeof(sorted[0]), cmp_u64);
+      for(j = 0; j < NCROPS; j++)
+        crop[j] = sorted[NBATCH - NBATCH / (4 << j) - 1];
+      continue;
+    }
+
+    for(i = 0; i < NBATCH; i++) {
+      ttest_push(&tt[NCROPS], cls[i], (double)dt[i]);
+      for(j = 0; j < NCROPS; j++)
+        if(dt[i] <= crop[j])
+          ttest_push(&tt[j], cls[i], (double)dt[i]);
+    }
+  }
+
+  for(j = 0; j <= NCROPS; j++) {
+    t = fabs(ttest_value(&tt[j]));
+    if(t > tmax)
+      tmax = t;
+  }
+
+  free(in);
+  return tmax;
+}
+
+#ifdef CT_VALGRIND
+/* Runs a target once per class, on input marked as secret */
+static void ct_run_once(const ct_target *tg)
+{
+  int cls;
+  uint8_t *in = aligned_alloc(64, (tg->inlen + 63) & ~(size_t)63);
+
+  if(!in)
+    abort();
+  for(cls = 0; cls < 2; cls++) {
+    tg->prepare(in, cls);
+    ct_poison(in, tg->inlen);
+    tg->run(in);
+    ct_unpoison(in, tg->inlen);
+  }
+  free(in);
+}
+#endif
+
+/*************************************************
+* Name:        ct_run
+*
+* Description: Measure a list of targets and print one line per target
+*
+* Arguments:   - const char *alg: algorithm name printed with each line
+*              - const ct_target *targets: targets to measure
+*              - size_t ntargets: number of targets
+*              - unsigned long nmeasures: number of measurements per target
+*
+* Returns 1 if any target exceeds CT_T_FAIL, 0 otherwise; always 0 with
+* CT_VALGRIND, where valgrind reports the leaks
+**************************************************/
+int ct_run(const char *alg, const ct_target *targets, size_t ntargets,
+           unsigned long nmeasures)
+{
+  size_t i;
+  int r = 0;
+  double t;
+
+#ifdef CT_VALGRIND
+  (void)t;
+  (void)nmeasures;
+  for(i = 0; i < ntargets; i++) {
+    ct_run_once(&targets[i]);
+    printf("%s %-40s run under valgrind --error-exitcode=1\n", alg, targets[i].name);
+  }
+  return r;
+#endif
+
+  for(i = 0; i < ntargets; i++) {
+    t = ct_measure(&targets[i], nmeasures);
+    printf("%s %-40s max |t| = %6.2f  %s\n", alg, targets[i].name, t,
+           t > CT_T_FAIL ? "LEAKAGE" : t > 4.5 ? "possible leakage" : "ok");
+    if(t > CT_T_FAIL)
+      r = 1;
+  }
+
+  return r;
+}
@@ -0,0 +1,40 @@
+#ifndef CT_H
+#define CT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * dudect-style timing test shared by the constant-time tests of all schemes.
+ *
+ * Every measurement runs a target on an input from one of two classes chosen
+ * at random, and Welch's t-test compares the two timing distributions (also
+ * after cropping the slowest measurements at a few percentiles). |t| > 4.5
+ * hints at leakage, |t| > CT_T_FAIL makes the test fail.
+ *
+ * Classes are drawn with randombytes(), which the scheme under test provides.
+ *
+ * Compiled with -DCT_VALGRIND, ct_run instead runs every target once per
+ * class with its input marked as uninitialized memory, and ct_poison marks
+ * the key and seed buffers the caller passes. Run the binary with
+ * valgrind --error-exitcode=1 so that any branch or memory access that
+ * depends on a secret is reported. This needs the valgrind headers.
+ */
+
+#define CT_T_FAIL 10.0
+
+typedef struct {
+  const char *name;
+  /* bytes of input per measurement; inputs are 64-byte aligned */
+  size_t inlen;
+  void (*prepare)(uint8_t *in, int cls);
+  void (*run)(uint8_t *in);
+} ct_target;
+
+void ct_poison(const void *p, size_t len);
+void ct_unpoison(const void *p, size_t len);
+double ct_measure(const ct_target *tg, unsigned long nmeasures);
+int ct_run(const char *alg, const ct_target *targets, size_t ntargets,
+           unsigned long nmeasures);
+
+#endif
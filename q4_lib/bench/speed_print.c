@@ -0,0 +1,493 @@
+#define _GNU_SOURCE
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+#include "cpucycles.h"
+#include "speed_print.h"
+
+/*
+ * Benchmark configuration is read from the environment by speed_init():
+ *
+ *   SPEED_ITERATIONS  number of measured iterations (default: NTESTS)
+ *   SPEED_WARMUP      iterations run and discarded first (default: 10%)
+ *   SPEED_CPU         pin the process to this CPU (Linux only)
+ *   SPEED_FORMAT      text (default), csv or json
+ *   SPEED_OUTPUT      write results to this file instead of stdout
+ *   SPEED_BASELINE    csv output of an earlier run to compare against
+ *   SPEED_THRESHOLD   relative change of the median in percent that,
+ *                     together with disjoint confidence intervals,
+ *                     counts as a regression (default: 3)
+ */
+
+#define SPEED_TEXT 0
+#define SPEED_CSV 1
+#define SPEED_JSON 2
+
+#define MAXBASELINE 256
+#define MAXNAME 96
+
+typedef struct {
+  char scheme[32];
+  char name[MAXNAME];
+  double median, ci_lo, ci_hi;
+} baseline_entry;
+
+typedef struct {
+  uint64_t min, max, p5, p25, median, p75, p95, p99;
+  double mean, stddev, ci_lo, ci_hi, mean_lo, mean_hi;
+} speed_stats;
+
+static struct {
+  int initialized;
+  int format;
+  FILE *out;
+  const char *scheme;
+  size_t iterations;
+  size_t warmup;
+  long cpu;
+  double threshold;
+  uint64_t overhead;
+  size_t nresults;
+  unsigned int regressions;
+  size_t nbaseline;
+  baseline_entry baseline[MAXBASELINE];
+} cfg;
+
+static int cmp_uint64(const void *a, const void *b) {
+  if(*(uint64_t *)a < *(uint64_t *)b) return -1;
+  if(*(uint64_t *)a > *(uint64_t *)b) return 1;
+  return 0;
+}
+
+static size_t env_size(const char *var, size_t dflt) {
+  const char *s = getenv(var);
+  char *end;
+  unsigned long long v;
+
+  if(!s || !*s)
+    return dflt;
+  v = strtoull(s, &end, 10);
+  if(*end) {
+    fprintf(stderr, "ERROR: %s must be a number\n", var);
+    exit(1);
+  }
+  return v;
+}
+
+/* First line of a sysfs file without the newline, or "unknown" */
+static void read_sysfs(char *buf, size_t buflen, const char *path) {
+  FILE *f = fopen(path, "r");
+
+  snprintf(buf, buflen, "unknown");
+  if(!f)
+    return;
+  if(fgets(buf, buflen, f))
+    buf[strcspn(buf, "\n")] = 0;
+  fclose(f);
+}
+
+/* Label as passed to print_results() without trailing separators */
+static void result_name(char *name, const char *s) {
+  size_t i, n;
+
+  n = strlen(s);
+  while(n > 0 && (s[n-1] == ' ' || s[n-1] == ':'))
+    n--;
+  if(n > MAXNAME - 1)
+    n = MAXNAME - 1;
+  for(i = 0; i < n; i++)
+    name[i] = (s[i] == '"' || s[i] == ',' || s[i] == '\\') ? '_' : s[i];
+  name[n] = 0;
+}
+
+/*************************************************
+* Name:        csv_field
+*
+* Description: Copy the idx-th comma-separated field of a line, without
+*              surrounding quotes
+*
+* Returns 0 on success, -1 if the line has fewer fields
+**************************************************/
+static int csv_field(char *out, size_t outlen, const char *line, int idx) {
+  size_t n;
+
+  while(idx-- > 0) {
+    line = strchr(line, ',');
+    if(!line)
+      return -1;
+    line++;
+  }
+  n = strcspn(line, ",\r\n");
+  if(n >= 2 && line[0] == '"' && line[n-1] == '"') {
+    line++;
+    n -= 2;
+  }
+  if(n >= outlen)
+    n = outlen - 1;
+  memcpy(out, line, n);
+  out[n] = 0;
+  return 0;
+}
+
+static void load_baseline(const char *path) {
+  FILE *f;
+  char line[1024], field[MAXNAME];
+  int i, j, col[5] = {-1, -1, -1, -1, -1};
+  static const char *cols[5] = {"scheme", "name", "median", "ci95_median_lo", "ci95_median_hi"};
+  baseline_entry *e;
+
+  f = fopen(path, "r");
+  if(!f) {
+    fprintf(stderr, "ERROR: Cannot open baseline %s\n", path);
+    exit(1);
+  }
+
+  if(fgets(line, sizeof(line), f))
+    for(i = 0; csv_field(field, sizeof(field), line, i) == 0; i++)
+      for(j = 0; j < 5; j++)
+        if(!strcmp(field, cols[j]))
+          col[j] = i;
+  for(i = 0; i < 5; i++) {
+    if(col[i] < 0) {
+      fprintf(stderr, "ERROR: Baseline %s has no column %s\n", path, cols[i]);
+      exit(1);
+    }
+  }
+
+  while(cfg.nbaseline < MAXBASELINE && fgets(line, sizeof(line), f)) {
+    e = &cfg.baseline[cfg.nbaseline];
+    if(csv_field(e->scheme, sizeof(e->scheme), line, col[0])
+       || csv_field(e->name, sizeof(e->name), line, col[1]))
+      continue;
+    if(csv_field(field, sizeof(field), line, col[2]))
+      continue;
+    e->median = strtod(field, NULL);
+    if(csv_field(field, sizeof(field), line, col[3]))
+      continue;
+    e->ci_lo = strtod(field, NULL);
+    if(csv_field(field, sizeof(field), line, col[4]))
+      continue;
+    e->ci_hi = strtod(field, NULL);
+    cfg.nbaseline++;
+  }
+
+  fclose(f);
+}
+
+static const baseline_entry *find_baseline(const char *name) {
+  size_t i;
+
+  for(i = 0; i < cfg.nbaseline; i++)
+    if(!strcmp(cfg.baseline[i].scheme, cfg.scheme) && !strcmp(cfg.baseline[i].name, name))
+      return &cfg.baseline[i];
+  return NULL;
+}
+
+/* Counter ticks per microsecond, measured against the monotonic clock */
+static double counter_mhz(void) {
+  struct timespec a, b;
+  uint64_t c0, c1;
+  double ns;
+
+  clock_gettime(CLOCK_MONOTONIC, &a);
+  c0 = cpucycles();
+  do {
+    clock_gettime(CLOCK_MONOTONIC, &b);
+    ns = (b.tv_sec - a.tv_sec) * 1e9 + (b.tv_nsec - a.tv_nsec);
+  } while(ns < 2e7);
+  c1 = cpucycles();
+
+  return (c1 - c0) / ns * 1e3;
+}
+
+/*************************************************
+* Name:        speed_init
+*
+* Description: Read the benchmark configuration from the environment,
+*              pin the process, check the cycle counter and print the
+*              machine description
+*
+* Arguments:   - const char *scheme: name of the scheme being measured
+*              - size_t ntests: default number of iterations
+*
+* Returns the number of timestamps each measurement has to record
+* (warm-up and measured iterations plus one)
+**************************************************/
+size_t speed_init(const char *scheme, size_t ntests) {
+  const char *s;
+  char path[128], turbo[32], governor[32];
+  double mhz;
+
+  cfg.initialized = 1;
+  cfg.scheme = scheme;
+  cfg.out = stdout;
+  cfg.iterations = env_size("SPEED_ITERATIONS", ntests);
+  cfg.warmup = env_size("SPEED_WARMUP", cfg.iterations / 10);
+  cfg.cpu = -1;
+  if(cfg.iterations < 1) {
+    fprintf(stderr, "ERROR: Need at least one iteration!\n");
+    exit(1);
+  }
+
+  s = getenv("SPEED_FORMAT");
+  if(!s || !*s || !strcmp(s, "text"))
+    cfg.format = SPEED_TEXT;
+  else if(!strcmp(s, "csv"))
+    cfg.format = SPEED_CSV;
+  else if(!strcmp(s, "json"))
+    cfg.format = SPEED_JSON;
+  else {
+    fprintf(stderr, "ERROR: SPEED_FORMAT must be text, csv or json\n");
+    exit(1);
+  }
+
+  s = getenv("SPEED_OUTPUT");
+  if(s && *s) {
+    cfg.out = fopen(s, "w");
+    if(!cfg.out) {
+      fprintf(stderr, "ERROR: Cannot open %s\n", s);
+      exit(1);
+    }
+  }
+
+  s = getenv("SPEED_THRESHOLD");
+  cfg.threshold = (s && *s) ? strtod(s, NULL) : 3.0;
+  s = getenv("SPEED_BASELINE");
+  if(s && *s)
+    load_baseline(s);
+
+  s = getenv("SPEED_CPU");
+  if(s && *s) {
+#ifdef __linux__
+    cpu_set_t set;
+
+    cfg.cpu = (long)env_size("SPEED_CPU", 0);
+    CPU_ZERO(&set);
+    CPU_SET(cfg.cpu, &set);
+    if(sched_setaffinity(0, sizeof(set), &set)) {
+      fprintf(stderr, "ERROR: Cannot pin to CPU %ld\n", cfg.cpu);
+      exit(1);
+    }
+#else
+    fprintf(stderr, "WARNING: SPEED_CPU is only supported on Linux\n");
+#endif
+  }
+
+#ifdef USE_RDPMC
+  read_sysfs(path, sizeof(path), "/sys/devices/cpu/rdpmc");
+  if(strcmp(path, "2")) {
+    fprintf(stderr, "ERROR: Built with USE_RDPMC, run echo 2 > /sys/devices/cpu/rdpmc\n");
+    exit(1);
+  }
+#endif
+
+  /* Turbo and frequency scaling make cycle counts noisy */
+  read_sysfs(turbo, sizeof(turbo), "/sys/devices/system/cpu/intel_pstate/no_turbo");
+  if(!strcmp(turbo, "unknown")) {
+    read_sysfs(turbo, sizeof(turbo), "/sys/devices/system/cpu/cpufreq/boost");
+    if(strcmp(turbo, "unknown"))
+      snprintf(turbo, sizeof(turbo), "%s", strcmp(turbo, "0") ? "on" : "off");
+  }
+  else
+    snprintf(turbo, sizeof(turbo), "%s", strcmp(turbo, "0") ? "off" : "on");
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%ld/cpufreq/scaling_governor",
+           cfg.cpu < 0 ? 0 : cfg.cpu);
+  read_sysfs(governor, sizeof(governor), path);
+
+  if(!strcmp(turbo, "on"))
+    fprintf(stderr, "WARNING: Turbo boost is enabled, results will be noisy\n");
+  if(strcmp(governor, "unknown") && strcmp(governor, "performance"))
+    fprintf(stderr, "WARNING: CPU frequency governor is %s, not performance\n", governor);
+
+  cfg.overhead = cpucycles_overhead();
+  mhz = counter_mhz();
+
+  switch(cfg.format) {
+    case SPEED_TEXT:
+      fprintf(cfg.out, "%s: %zu iterations, %zu warm-up, counter %s at %.0f MHz, cpu %ld, "
+              "turbo %s, governor %s\n\n", scheme, cfg.iterations, cfg.warmup,
+#ifdef USE_RDPMC
+              "rdpmc",
+#else
+              "rdtsc",
+#endif
+              mhz, cfg.cpu, turbo, governor);
+      break;
+    case SPEED_CSV:
+      fprintf(cfg.out, "scheme,name,iterations,warmup,min,p5,p25,median,p75,p95,p99,max,"
+              "mean,stddev,ci95_median_lo,ci95_median_hi,ci95_mean_lo,ci95_mean_hi");
+      if(cfg.nbaseline)
+        fprintf(cfg.out, ",baseline_median,delta_pct,verdict");
+      fprintf(cfg.out, "\n");
+      break;
+    case SPEED_JSON:
+      fprintf(cfg.out, "{\n  \"scheme\": \"%s\",\n  \"counter\": \"%s\",\n  \"counter_mhz\": %.1f,\n"
+              "  \"cpu\": %ld,\n  \"turbo\": \"%s\",\n  \"governor\": \"%s\",\n"
+              "  \"iterations\": %zu,\n  \"warmup\": %zu,\n  \"results\": [",
+              scheme,
+#ifdef USE_RDPMC
+              "rdpmc",
+#else
+              "rdtsc",
+#endif
+              mhz, cfg.cpu, turbo, governor, cfg.iterations, cfg.warmup);
+      break;
+  }
+
+  return cfg.warmup + cfg.iterations + 1;
+}
+
+static uint64_t percentile(const uint64_t *l, size_t llen, unsigned int p) {
+  size_t i = (llen * p + 99) / 100;
+  return l[i ? i - 1 : 0];
+}
+
+/*************************************************
+* Name:        compute_stats
+*
+* Description: Percentiles, mean and 95% confidence intervals of the
+*              median (order statistics) and of the mean (normal
+*              approximation); sorts the input
+**************************************************/
+static void compute_stats(speed_stats *st, uint64_t *l, size_t llen) {
+  size_t i, lo, hi;
+  double acc = 0, var = 0, w;
+
+  qsort(l, llen, sizeof(uint64_t), cmp_uint64);
+
+  st->min = l[0];
+  st->max = l[llen-1];
+  st->p5 = percentile(l, llen, 5);
+  st->p25 = percentile(l, llen, 25);
+  st->p75 = percentile(l, llen, 75);
+  st->p95 = percentile(l, llen, 95);
+  st->p99 = percentile(l, llen, 99);
+  if(llen%2) st->median = l[llen/2];
+  else st->median = (l[llen/2-1]+l[llen/2])/2;
+
+  for(i = 0; i < llen; i++)
+    acc += l[i];
+  st->mean = acc / llen;
+  for(i = 0; i < llen; i++)
+    var += (l[i] - st->mean) * (l[i] - st->mean);
+  st->stddev = llen > 1 ? sqrt(var / (llen - 1)) : 0;
+
+  w = 1.96 * sqrt((double)llen) / 2;
+  lo = (llen / 2.0 > w) ? (size_t)floor(llen / 2.0 - w) : 0;
+  hi = (size_t)ceil(llen / 2.0 + w);
+  st->ci_lo = l[lo];
+  st->ci_hi = l[hi < llen ? hi : llen - 1];
+  st->mean_lo = st->mean - 1.96 * st->stddev / sqrt((double)llen);
+  st->mean_hi = st->mean + 1.96 * st->stddev / sqrt((double)llen);
+}
+
+void print_results(const char *s, uint64_t *t, size_t tlen) {
+  size_t i, skip;
+  char name[MAXNAME];
+  const char *verdict = NULL;
+  double delta = 0;
+  speed_stats st;
+  const baseline_entry *b = NULL;
+
+  if(tlen < 2) {
+    fprintf(stderr, "ERROR: Need a least two cycle counts!\n");
+    return;
+  }
+
+  if(!cfg.initialized)
+    speed_init("", tlen - 1);
+
+  tlen--;
+  for(i=0;i<tlen;++i)
+    t[i] = t[i+1] - t[i] - cfg.overhead;
+
+  skip = (cfg.warmup < tlen) ? cfg.warmup : 0;
+  compute_stats(&st, t + skip, tlen - skip);
+  result_name(name, s);
+
+  b = find_baseline(name);
+  if(b) {
+    delta = 100.0 * (st.median - b->median) / b->median;
+    verdict = "same";
+    if(delta > cfg.threshold && st.ci_lo > b->ci_hi) {
+      verdict = "slower";
+      cfg.regressions++;
+    }
+    else if(delta < -cfg.threshold && st.ci_hi < b->ci_lo)
+      verdict = "faster";
+  }
+
+  switch(cfg.format) {
+    case SPEED_TEXT:
+      fprintf(cfg.out, "%s\n", s);
+      fprintf(cfg.out, "median: %llu cycles/ticks\n", (unsigned long long)st.median);
+      fprintf(cfg.out, "average: %llu cycles/ticks\n", (unsigned long long)st.mean);
+      fprintf(cfg.out, "95%% CI median: [%.0f, %.0f], stddev: %.1f\n", st.ci_lo, st.ci_hi, st.stddev);
+      fprintf(cfg.out, "min/p5/p25/p75/p95/p99/max: %llu/%llu/%llu/%llu/%llu/%llu/%llu\n",
+              (unsigned long long)st.min, (unsigned long long)st.p5, (unsigned long long)st.p25,
+              (unsigned long long)st.p75, (unsigned long long)st.p95, (unsigned long long)st.p99,
+              (unsigned long long)st.max);
+      if(b)
+        fprintf(cfg.out, "baseline: %.0f cycles/ticks (%+.1f%%, %s)\n", b->median, delta, verdict);
+      fprintf(cfg.out, "\n");
+      break;
+    case SPEED_CSV:
+      fprintf(cfg.out, "\"%s\",\"%s\",%zu,%zu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,"
+              "%.1f,%.1f,%.0f,%.0f,%.1f,%.1f", cfg.scheme, name, tlen - skip, skip,
+              (unsigned long long)st.min, (unsigned long long)st.p5, (unsigned long long)st.p25,
+              (unsigned long long)st.median, (unsigned long long)st.p75, (unsigned long long)st.p95,
+              (unsigned long long)st.p99, (unsigned long long)st.max,
+              st.mean, st.stddev, st.ci_lo, st.ci_hi, st.mean_lo, st.mean_hi);
+      if(cfg.nbaseline) {
+        if(b)
+          fprintf(cfg.out, ",%.0f,%.2f,%s", b->median, delta, verdict);
+        else
+          fprintf(cfg.out, ",,,");
+      }
+      fprintf(cfg.out, "\n");
+      break;
+    case SPEED_JSON:
+      fprintf(cfg.out, "%s\n    {\"name\": \"%s\", \"iterations\": %zu, \"warmup\": %zu, "
+              "\"min\": %llu, \"p5\": %llu, \"p25\": %llu, \"median\": %llu, \"p75\": %llu, "
+              "\"p95\": %llu, \"p99\": %llu, \"max\": %llu, \"mean\": %.1f, \"stddev\": %.1f, "
+              "\"ci95_median\": [%.0f, %.0f], \"ci95_mean\": [%.1f, %.1f]",
+              cfg.nresults ? "," : "", name, tlen - skip, skip,
+              (unsigned long long)st.min, (unsigned long long)st.p5, (unsigned long long)st.p25,
+              (unsigned long long)st.median, (unsigned long long)st.p75, (unsigned long long)st.p95,
+              (unsigned long long)st.p99, (unsigned long long)st.max,
+              st.mean, st.stddev, st.ci_lo, st.ci_hi, st.mean_lo, st.mean_hi);
+      if(b)
+        fprintf(cfg.out, ", \"baseline_median\": %.0f, \"delta_pct\": %.2f, \"verdict\": \"%s\"",
+                b->median, delta, verdict);
+      fprintf(cfg.out, "}");
+      break;
+  }
+  cfg.nresults++;
+}
+
+/*************************************************
+* Name:        speed_finish
+*
+* Description: Complete the output and report regressions against the
+*              baseline
+*
+* Returns 1 if a result is slower than the baseline, 0 otherwise
+**************************************************/
+int speed_finish(void) {
+  if(cfg.format == SPEED_JSON)
+    fprintf(cfg.out, "\n  ],\n  \"regressions\": %u\n}\n", cfg.regressions);
+  if(cfg.out && cfg.out != stdout)
+    fclose(cfg.out);
+  cfg.out = stdout;
+
+  if(cfg.nbaseline)
+    fprintf(stderr, "%s: %u regressions against baseline\n", cfg.scheme, cfg.regressions);
+  return cfg.regressions > 0;
+}
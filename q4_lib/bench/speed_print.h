@@ -0,0 +1,11 @@
+#ifndef PRINT_SPEED_H
+#define PRINT_SPEED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+size_t speed_init(const char *scheme, size_t ntests);
+void print_results(const char *s, uint64_t *t, size_t tlen);
+int speed_finish(void);
+
+#endif
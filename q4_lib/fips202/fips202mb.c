@@ -0,0 +1,194 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "fips202.h"
+#include "keccakf1600.h"
+
+/* Bookkeeping for one lane of the multi-buffer engine */
+typedef struct {
+  int busy;
+  int squeezing;
+  size_t job;
+  size_t inpos;
+  size_t outpos;
+} keccak_lane;
+
+/*************************************************
+* Name:        load64
+*
+* Description: Load 8 bytes into uint64_t in little-endian order
+*
+* Arguments:   - const uint8_t *x: pointer to input byte array
+*
+* Returns the loaded 64-bit unsigned integer
+**************************************************/
+static uint64_t load64(const uint8_t x[8]) {
+  unsigned int i;
+  uint64_t r = 0;
+
+  for(i=0;i<8;i++)
+    r |= (uint64_t)x[i] << 8*i;
+
+  return r;
+}
+
+/*************************************************
+* Name:        keccak_lane_absorb
+*
+* Description: Absorb the next rate block of a job into its state; the
+*              final block is padded and switches the lane to squeezing.
+*
+* Arguments:   - uint64_t *s: pointer to Keccak state of the lane
+*              - keccak_lane *l: pointer to lane bookkeeping
+*              - unsigned int r: rate in bytes
+*              - const uint8_t *in: pointer to input of the job
+*              - size_t inlen: length of input in bytes
+*              - uint8_t p: domain-separation byte
+**************************************************/
+static void keccak_lane_absorb(uint64_t s[25],
+                               keccak_lane *l,
+                               unsigned int r,
+                               const uint8_t *in,
+                               size_t inlen,
+                               uint8_t p)
+{
+  unsigned int i, n;
+
+  in += l->inpos;
+  n = (inlen - l->inpos < r) ? inlen - l->inpos : r;
+  for(i = 0; i + 8 <= n; i += 8)
+    s[i/8] ^= load64(in + i);
+  for(; i < n; ++i)
+    s[i/8] ^= (uint64_t)in[i] << 8*(i%8);
+  l->inpos += n;
+
+  if(n < r) {
+    s[i/8] ^= (uint64_t)p << 8*(i%8);
+    s[(r-1)/8] ^= 1ULL << 63;
+    l->squeezing = 1;
+  }
+}
+
+/*************************************************
+* Name:        keccak_many
+*
+* Description: Multi-buffer Keccak sponge. Jobs are taken from the queue
+*              in order and each runs in one lane of the widest available
+*              permutation backend; a lane that finishes is refilled with
+*              the next job before the next permutation, so messages of
+*              different lengths keep all lanes busy.
+*
+* Arguments:   - uint8_t **out: pointers to n output buffers
+*              - size_t outlen: number of output bytes per job
+*              - const uint8_t **in: pointers to n inputs
+*              - const size_t *inlen: lengths of the n inputs
+*              - size_t n: number of jobs
+*              - unsigned int r: rate in bytes
+*              - uint8_t p: domain-separation byte
+**************************************************/
+static void keccak_many(uint8_t *out[],
+                        size_t outlen,
+                        const uint8_t *in[],
+                        const size_t inlen[],
+                        size_t n,
+                        unsigned int r,
+                        uint8_t p)
+{
+  unsigned int i, j, k = 0, lanes, active;
+  size_t next = 0;
+  uint64_t s[KECCAKF1600_MAXLANES][25];
+  keccak_lane l[KECCAKF1600_MAXLANES];
+  const keccakf1600_backend *b = keccakf1600_active(1);
+
+  lanes = b->lanes;
+  memset(s, 0, sizeof(s));
+  for(i = 0; i < lanes; ++i)
+    l[i].busy = 0;
+
+  for(;;) {
+    active = 0;
+    for(i = 0; i < lanes; ++i) {
+      if(!l[i].busy && next < n) {
+        memset(s[i], 0, sizeof(s[i]));
+        l[i].busy = 1;
+        l[i].squeezing = 0;
+        l[i].job = next++;
+        l[i].inpos = l[i].outpos = 0;
+      }
+      if(!l[i].busy)
+        continue;
+
+      if(!l[i].squeezing)
+        keccak_lane_absorb(s[i], &l[i], r, in[l[i].job], inlen[l[i].job], p);
+      k = i;
+      active++;
+    }
+
+    if(active == 0)
+      break;
+    else if(active == 1)
+      KeccakF1600_StatePermute(s[k]);
+    else
+      b->permute(s);
+
+    for(i = 0; i < lanes; ++i) {
+      if(!l[i].busy || !l[i].squeezing)
+        continue;
+
+      k = (outlen - l[i].outpos < r) ? outlen - l[i].outpos : r;
+      for(j = 0; j < k; ++j)
+        out[l[i].job][l[i].outpos + j] = s[i][j/8] >> 8*(j%8);
+      l[i].outpos += k;
+      if(l[i].outpos == outlen)
+        l[i].busy = 0;
+    }
+  }
+}
+
+/*************************************************
+* Name:        shake256_many
+*
+* Description: SHAKE256 of n independent inputs of arbitrary lengths
+*
+* Arguments:   - uint8_t **out: pointers to n output buffers
+*              - size_t outlen: requested output length in bytes
+*              - const uint8_t **in: pointers to n inputs
+*              - const size_t *inlen: lengths of the n inputs
+*              - size_t n: number of inputs
+**************************************************/
+void shake256_many(uint8_t *out[], size_t outlen, const uint8_t *in[], const size_t inlen[], size_t n)
+{
+  if(outlen == 0)
+    return;
+  keccak_many(out, outlen, in, inlen, n, SHAKE256_RATE, 0x1F);
+}
+
+/*************************************************
+* Name:        sha3_256_many
+*
+* Description: SHA3-256 of n independent inputs of arbitrary lengths
+*
+* Arguments:   - uint8_t **h: pointers to n output buffers (32 bytes each)
+*              - const uint8_t **in: pointers to n inputs
+*              - const size_t *inlen: lengths of the n inputs
+*              - size_t n: number of inputs
+**************************************************/
+void sha3_256_many(uint8_t *h[], const uint8_t *in[], const size_t inlen[], size_t n)
+{
+  keccak_many(h, 32, in, inlen, n, SHA3_256_RATE, 0x06);
+}
+
+/*************************************************
+* Name:        sha3_512_many
+*
+* Description: SHA3-512 of n independent inputs of arbitrary lengths
+*
+* Arguments:   - uint8_t **h: pointers to n output buffers (64 bytes each)
+*              - const uint8_t **in: pointers to n inputs
+*              - const size_t *inlen: lengths of the n inputs
+*              - size_t n: number of inputs
+**************************************************/
+void sha3_512_many(uint8_t *h[], const uint8_t *in[], const size_t inlen[], size_t n)
+{
+  keccak_many(h, 64, in, inlen, n, SHA3_512_RATE, 0x06);
+}
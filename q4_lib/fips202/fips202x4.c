@@ -30,7 +30,7 @@ static void keccakx4_absorb_once(__m256i s[25],
     }
     inlen -= r;
 
-    f1600x4(s, KeccakF_RoundConstants);
+    KeccakF1600_StatePermute4x(s);
   }
 
   for(i = 0; i < inlen/8; ++i) {
@@ -65,7 +65,7 @@ static void keccakx4_squeezeblocks(uint8_t *out0,
   __m128d t;
 
   while(nblocks > 0) {
-    f1600x4(s, KeccakF_RoundConstants);
+    KeccakF1600_StatePermute4x(s);
     for(i=0; i < r/8; ++i) {
       t = _mm_castsi128_pd(_mm256_castsi256_si128(s[i]));
       _mm_storel_pd((__attribute__((__may_alias__)) double *)&out0[8*i], t);
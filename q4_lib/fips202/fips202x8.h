@@ -0,0 +1,37 @@
+#ifndef FIPS202X8_H
+#define FIPS202X8_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#define FIPS202X8_NAMESPACE(s) q4_fips202x8_##s
+
+typedef struct {
+  __m512i s[25];
+} keccakx8_state;
+
+#define KeccakF1600_StatePermute8x FIPS202X8_NAMESPACE(KeccakF1600_StatePermute8x)
+void KeccakF1600_StatePermute8x(__m512i *state);
+
+#define shake128x8_absorb_once FIPS202X8_NAMESPACE(shake128x8_absorb_once)
+void shake128x8_absorb_once(keccakx8_state *state,
+                            const uint8_t *in[8],
+                            size_t inlen);
+
+#define shake128x8_squeezeblocks FIPS202X8_NAMESPACE(shake128x8_squeezeblocks)
+void shake128x8_squeezeblocks(uint8_t *out[8],
+                              size_t nblocks,
+                              keccakx8_state *state);
+
+#define shake256x8_absorb_once FIPS202X8_NAMESPACE(shake256x8_absorb_once)
+void shake256x8_absorb_once(keccakx8_state *state,
+                            const uint8_t *in[8],
+                            size_t inlen);
+
+#define shake256x8_squeezeblocks FIPS202X8_NAMESPACE(shake256x8_squeezeblocks)
+void shake256x8_squeezeblocks(uint8_t *out[8],
+                              size_t nblocks,
+                              keccakx8_state *state);
+
+#endif
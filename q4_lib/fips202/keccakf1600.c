@@ -0,0 +1,274 @@
+/* Based on the public domain implementation in crypto_hash/keccakc512/simple/ from
+ * http://bench.cr.yp.to/supercop.html by Ronny Van Keer and the public domain "TweetFips202"
+ * implementation from https://twitter.com/tweetfips202 by Gilles Van Assche, Daniel J. Bernstein,
+ * and Peter Schwabe */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "fips202.h"
+#include "keccakf1600.h"
+
+#define NROUNDS 24
+#define ROL(a, offset) ((a << offset) ^ (a >> (64-offset)))
+
+/* Keccak round constants */
+const uint64_t KeccakF_RoundConstants[NROUNDS] = {
+  (uint64_t)0x0000000000000001ULL,
+  (uint64_t)0x0000000000008082ULL,
+  (uint64_t)0x800000000000808aULL,
+  (uint64_t)0x8000000080008000ULL,
+  (uint64_t)0x000000000000808bULL,
+  (uint64_t)0x0000000080000001ULL,
+  (uint64_t)0x8000000080008081ULL,
+  (uint64_t)0x8000000000008009ULL,
+  (uint64_t)0x000000000000008aULL,
+  (uint64_t)0x0000000000000088ULL,
+  (uint64_t)0x0000000080008009ULL,
+  (uint64_t)0x000000008000000aULL,
+  (uint64_t)0x000000008000808bULL,
+  (uint64_t)0x800000000000008bULL,
+  (uint64_t)0x8000000000008089ULL,
+  (uint64_t)0x8000000000008003ULL,
+  (uint64_t)0x8000000000008002ULL,
+  (uint64_t)0x8000000000000080ULL,
+  (uint64_t)0x000000000000800aULL,
+  (uint64_t)0x800000008000000aULL,
+  (uint64_t)0x8000000080008081ULL,
+  (uint64_t)0x8000000000008080ULL,
+  (uint64_t)0x0000000080000001ULL,
+  (uint64_t)0x8000000080008008ULL
+};
+
+/*************************************************
+* Name:        keccakf1600_scalar
+*
+* Description: The Keccak F1600 Permutation; portable C
+*
+* Arguments:   - uint64_t *state: pointer to input/output Keccak state
+**************************************************/
+static void keccakf1600_scalar(uint64_t state[25])
+{
+#define V uint64_t
+#define LOAD(s, i) (s)[i]
+#define STORE(s, i, a) (s)[i] = (a)
+#define XOR(a, b) ((a) ^ (b))
+#define XOR5(a, b, c, d, e) ((a) ^ (b) ^ (c) ^ (d) ^ (e))
+#define CHI(y, x, a, b, c) ((a) ^ (~(b) & (c)))
+#define RC(i) KeccakF_RoundConstants[i]
+#include "keccakf1600.inc"
+#undef V
+#undef LOAD
+#undef STORE
+#undef XOR
+#undef XOR5
+#undef CHI
+#undef RC
+}
+
+void keccakf1600_permute_scalar(uint64_t (*state)[25])
+{
+  keccakf1600_scalar(state[0]);
+}
+
+/* Backend indices; keccakf1600_backends is ordered from least to most
+ * preferred within each lane count */
+enum {
+  KECCAKF1600_SCALAR,
+#ifdef KECCAKF1600_FAST_SCALAR
+  KECCAKF1600_LANECOMP,
+#ifdef KECCAKF1600_X86_64
+  KECCAKF1600_BMI1,
+#endif
+#endif
+#ifdef KECCAKF1600_X86_64
+  KECCAKF1600_AVX2X4,
+  KECCAKF1600_AVX512X8,
+#endif
+  KECCAKF1600_NBACKENDS
+};
+
+const keccakf1600_backend keccakf1600_backends[] = {
+  [KECCAKF1600_SCALAR] = { "scalar", 1, NULL, keccakf1600_permute_scalar },
+#ifdef KECCAKF1600_FAST_SCALAR
+  [KECCAKF1600_LANECOMP] = { "lanecomp", 1, NULL, keccakf1600_permute_lc },
+#ifdef KECCAKF1600_X86_64
+  [KECCAKF1600_BMI1] = { "bmi1", 1, keccakf1600_supported_bmi1, keccakf1600_permute_bmi1 },
+#endif
+#endif
+#ifdef KECCAKF1600_X86_64
+  [KECCAKF1600_AVX2X4] = { "avx2x4", 4, keccakf1600_supported_avx2, keccakf1600_permute_x4_avx2 },
+  [KECCAKF1600_AVX512X8] = { "avx512x8", 8, keccakf1600_supported_avx512, keccakf1600_permute_x8_avx512 },
+#endif
+  [KECCAKF1600_NBACKENDS] = { NULL, 0, NULL, NULL }
+};
+
+/* The selection is one word, written atomically: the index of the
+ * single-state backend plus one in bits 0-7, that of the batch backend
+ * plus one in bits 8-15. It is 0 until CPU features have been detected. */
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+static volatile long active;
+/* Volatile loads have acquire semantics with MSVC on x86 */
+#define ACTIVE_LOAD() (active)
+#define ACTIVE_STORE(v) _InterlockedExchange(&active, (v))
+#define ACTIVE_PUBLISH(v) _InterlockedCompareExchange(&active, (v), 0)
+#else
+static long active;
+#define ACTIVE_LOAD() __atomic_load_n(&active, __ATOMIC_ACQUIRE)
+#define ACTIVE_STORE(v) __atomic_store_n(&active, (v), __ATOMIC_RELEASE)
+#define ACTIVE_PUBLISH(v) do { \
+    long expected_ = 0; \
+    __atomic_compare_exchange_n(&active, &expected_, (v), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE); \
+  } while(0)
+#endif
+
+#define ACTIVE_WORD(single, many) (((long)(single) + 1) | (((long)(many) + 1) << 8))
+#define ACTIVE_SINGLE(a) ((unsigned int)((a) & 0xff) - 1)
+#define ACTIVE_MANY(a) ((unsigned int)(((a) >> 8) & 0xff) - 1)
+
+static long keccakf1600_detect(void)
+{
+  unsigned int i, single = KECCAKF1600_SCALAR, many = KECCAKF1600_SCALAR;
+  const keccakf1600_backend *b;
+
+  for(i = 0; i < KECCAKF1600_NBACKENDS; ++i) {
+    b = &keccakf1600_backends[i];
+    if(b->supported && !b->supported())
+      continue;
+    if(b->lanes == 1)
+      single = i;
+    if(b->lanes >= keccakf1600_backends[many].lanes)
+      many = i;
+  }
+
+  return ACTIVE_WORD(single, many);
+}
+
+/* The selection word; the first caller publishes the detected backends.
+ * Racing first callers detect the same backends, and only one of them
+ * stores its result, so an earlier keccakf1600_select is never undone. */
+static long keccakf1600_selection(void)
+{
+  long a = ACTIVE_LOAD();
+
+  if(!a) {
+    ACTIVE_PUBLISH(keccakf1600_detect());
+    a = ACTIVE_LOAD();
+  }
+  return a;
+}
+
+/*************************************************
+* Name:        keccakf1600_active
+*
+* Description: Return the backend currently used for single states
+*              (many = 0) or for batches of independent states (many = 1).
+*              Detects CPU features on first use.
+*
+* Arguments:   - unsigned int many: select batch instead of single backend
+*
+* Returns pointer to backend descriptor
+**************************************************/
+const keccakf1600_backend *keccakf1600_active(unsigned int many)
+{
+  long a = keccakf1600_selection();
+
+  return &keccakf1600_backends[many ? ACTIVE_MANY(a) : ACTIVE_SINGLE(a)];
+}
+
+/*************************************************
+* Name:        keccakf1600_select
+*
+* Description: Pin a backend by name, e.g. for benchmarks and tests.
+*              Single-lane backends are used for both single states and
+*              batches; multi-lane backends only for batches. NULL restores
+*              automatic selection.
+*
+* Arguments:   - const char *name: backend name or NULL
+*
+* Returns 0 on success and -1 if the backend is unknown or not supported
+* by this CPU
+**************************************************/
+int keccakf1600_select(const char *name)
+{
+  unsigned int i;
+  long a = keccakf1600_detect();
+  const keccakf1600_backend *b;
+
+  if(!name) {
+    ACTIVE_STORE(a);
+    return 0;
+  }
+
+  for(i = 0; i < KECCAKF1600_NBACKENDS; ++i) {
+    b = &keccakf1600_backends[i];
+    if(strcmp(b->name, name))
+      continue;
+    if(b->supported && !b->supported())
+      return -1;
+    ACTIVE_STORE(ACTIVE_WORD(b->lanes == 1 ? i : ACTIVE_SINGLE(a), i));
+    return 0;
+  }
+
+  return -1;
+}
+
+/*************************************************
+* Name:        KeccakF1600_StatePermute
+*
+* Description: The Keccak F1600 Permutation using the active backend.
+*              Single-state backends are called directly, not through the
+*              backend table, as this runs once per absorbed block.
+*
+* Arguments:   - uint64_t *state: pointer to input/output Keccak state
+**************************************************/
+void KeccakF1600_StatePermute(uint64_t state[25])
+{
+  switch(ACTIVE_SINGLE(keccakf1600_selection())) {
+#ifdef KECCAKF1600_FAST_SCALAR
+#ifdef KECCAKF1600_X86_64
+    case KECCAKF1600_BMI1:
+      keccakf1600_permute_bmi1((uint64_t (*)[25])state);
+      break;
+#endif
+    case KECCAKF1600_LANECOMP:
+      keccakf1600_permute_lc((uint64_t (*)[25])state);
+      break;
+#endif
+    default:
+      keccakf1600_scalar(state);
+      break;
+  }
+}
+
+/*************************************************
+* Name:        KeccakF1600_StatePermute_many
+*
+* Description: Apply the Keccak F1600 Permutation to n independent states
+*              using the widest available backend. A partial final batch
+*              is padded when that is cheaper than permuting it serially.
+*
+* Arguments:   - uint64_t (*state)[25]: pointer to n input/output states
+*              - size_t n: number of states
+**************************************************/
+void KeccakF1600_StatePermute_many(uint64_t (*state)[25], size_t n)
+{
+  const keccakf1600_backend *b = keccakf1600_active(1);
+  uint64_t t[KECCAKF1600_MAXLANES][25];
+
+  while(n >= b->lanes) {
+    b->permute(state);
+    state += b->lanes;
+    n -= b->lanes;
+  }
+
+  if(n > 1) {
+    memcpy(t, state, n*sizeof(t[0]));
+    memset(t[n], 0, (b->lanes - n)*sizeof(t[0]));
+    b->permute(t);
+    memcpy(state, t, n*sizeof(t[0]));
+  }
+  else if(n == 1)
+    keccakf1600_active(0)->permute(state);
+}
@@ -0,0 +1,63 @@
+#ifndef KECCAKF1600_H
+#define KECCAKF1600_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "fips202.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define KECCAKF1600_X86_64
+#endif
+
+#if defined(__GNUC__)
+#define KECCAKF1600_TARGET(t) __attribute__((target(t)))
+#else
+#define KECCAKF1600_TARGET(t)
+#endif
+
+#define KECCAKF1600_MAXLANES 8
+
+/* A permutation backend processes `lanes` independent states per call */
+typedef struct {
+  const char *name;
+  unsigned int lanes;
+  int (*supported)(void);
+  void (*permute)(uint64_t (*state)[25]);
+} keccakf1600_backend;
+
+#define KeccakF1600_StatePermute FIPS202_NAMESPACE(KeccakF1600_StatePermute)
+void KeccakF1600_StatePermute(uint64_t state[25]);
+#define KeccakF1600_StatePermute_many FIPS202_NAMESPACE(KeccakF1600_StatePermute_many)
+void KeccakF1600_StatePermute_many(uint64_t (*state)[25], size_t n);
+
+#define keccakf1600_backends FIPS202_NAMESPACE(keccakf1600_backends)
+extern const keccakf1600_backend keccakf1600_backends[];
+#define keccakf1600_active FIPS202_NAMESPACE(keccakf1600_active)
+const keccakf1600_backend *keccakf1600_active(unsigned int many);
+#define keccakf1600_select FIPS202_NAMESPACE(keccakf1600_select)
+int keccakf1600_select(const char *name);
+
+#define keccakf1600_permute_scalar FIPS202_NAMESPACE(keccakf1600_permute_scalar)
+void keccakf1600_permute_scalar(uint64_t (*state)[25]);
+
+#define keccakf1600_permute_lc FIPS202_NAMESPACE(keccakf1600_permute_lc)
+void keccakf1600_permute_lc(uint64_t (*state)[25]);
+
+#ifdef KECCAKF1600_X86_64
+#define keccakf1600_supported_bmi1 FIPS202_NAMESPACE(keccakf1600_supported_bmi1)
+int keccakf1600_supported_bmi1(void);
+#define keccakf1600_permute_bmi1 FIPS202_NAMESPACE(keccakf1600_permute_bmi1)
+void keccakf1600_permute_bmi1(uint64_t (*state)[25]);
+
+#define keccakf1600_supported_avx2 FIPS202_NAMESPACE(keccakf1600_supported_avx2)
+int keccakf1600_supported_avx2(void);
+#define keccakf1600_permute_x4_avx2 FIPS202_NAMESPACE(keccakf1600_permute_x4_avx2)
+void keccakf1600_permute_x4_avx2(uint64_t (*state)[25]);
+
+#define keccakf1600_supported_avx512 FIPS202_NAMESPACE(keccakf1600_supported_avx512)
+int keccakf1600_supported_avx512(void);
+#define keccakf1600_permute_x8_avx512 FIPS202_NAMESPACE(keccakf1600_permute_x8_avx512)
+void keccakf1600_permute_x8_avx512(uint64_t (*state)[25]);
+#endif
+
+#endif
@@ -0,0 +1,107 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "fips202.h"
+#include "keccakf1600.h"
+
+#define NROUNDS 24
+#define ROL(a, offset) ((a << offset) ^ (a >> (64-offset)))
+
+/* Lanes kept complemented inside the permutation (be, bi, go, ki, mi, sa) */
+#define LC_LANES ((1UL << 1) | (1UL << 2) | (1UL << 8) | (1UL << 12) | (1UL << 17) | (1UL << 20))
+#define LC(i, a) (((LC_LANES >> (i)) & 1) ? ~(a) : (a))
+
+/* Chi on complemented lanes; every row needs at most one NOT */
+#define CHI_ba(a, b, c) ((a) ^ ((b) | (c)))
+#define CHI_be(a, b, c) ((a) ^ (~(b) | (c)))
+#define CHI_bi(a, b, c) ((a) ^ ((b) & (c)))
+#define CHI_bo(a, b, c) ((a) ^ ((b) | (c)))
+#define CHI_bu(a, b, c) ((a) ^ ((b) & (c)))
+#define CHI_ga(a, b, c) ((a) ^ ((b) | (c)))
+#define CHI_ge(a, b, c) ((a) ^ ((b) & (c)))
+#define CHI_gi(a, b, c) ((a) ^ ((b) | ~(c)))
+#define CHI_go(a, b, c) ((a) ^ ((b) | (c)))
+#define CHI_gu(a, b, c) ((a) ^ ((b) & (c)))
+#define CHI_ka(a, b, c) ((a) ^ ((b) | (c)))
+#define CHI_ke(a, b, c) ((a) ^ ((b) & (c)))
+#define CHI_ki(a, b, c) ((a) ^ (~(b) & (c)))
+#define CHI_ko(a, b, c) (~(a) ^ ((b) | (c)))
+#define CHI_ku(a, b, c) ((a) ^ ((b) & (c)))
+#define CHI_ma(a, b, c) ((a) ^ ((b) & (c)))
+#define CHI_me(a, b, c) ((a) ^ ((b) | (c)))
+#define CHI_mi(a, b, c) ((a) ^ (~(b) | (c)))
+#define CHI_mo(a, b, c) (~(a) ^ ((b) & (c)))
+#define CHI_mu(a, b, c) ((a) ^ ((b) | (c)))
+#define CHI_sa(a, b, c) ((a) ^ (~(b) & (c)))
+#define CHI_se(a, b, c) (~(a) ^ ((b) | (c)))
+#define CHI_si(a, b, c) ((a) ^ ((b) & (c)))
+#define CHI_so(a, b, c) ((a) ^ ((b) | (c)))
+#define CHI_su(a, b, c) ((a) ^ ((b) & (c)))
+
+/*************************************************
+* Name:        keccakf1600_permute_lc
+*
+* Description: The Keccak F1600 Permutation with lane complementing.
+*              Six lanes are stored inverted so that chi needs one NOT per
+*              row instead of five; suited to cores without ANDN.
+*
+* Arguments:   - uint64_t (*state)[25]: pointer to input/output Keccak state
+**************************************************/
+void keccakf1600_permute_lc(uint64_t (*s)[25])
+{
+  uint64_t *state = s[0];
+#define V uint64_t
+#define LOAD(s, i) LC(i, (s)[i])
+#define STORE(s, i, a) (s)[i] = LC(i, a)
+#define XOR(a, b) ((a) ^ (b))
+#define XOR5(a, b, c, d, e) ((a) ^ (b) ^ (c) ^ (d) ^ (e))
+#define CHI(y, x, a, b, c) CHI_##y##x(a, b, c)
+#define RC(i) KeccakF_RoundConstants[i]
+#include "keccakf1600.inc"
+#undef LOAD
+#undef STORE
+#undef CHI
+}
+
+#ifdef KECCAKF1600_X86_64
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*************************************************
+* Name:        keccakf1600_permute_bmi1
+*
+* Description: The Keccak F1600 Permutation compiled for BMI1, so that chi
+*              is a single ANDN and XOR per lane.
+*
+* Arguments:   - uint64_t (*state)[25]: pointer to input/output Keccak state
+**************************************************/
+KECCAKF1600_TARGET("bmi")
+void keccakf1600_permute_bmi1(uint64_t (*s)[25])
+{
+  uint64_t *state = s[0];
+#define LOAD(s, i) (s)[i]
+#define STORE(s, i, a) (s)[i] = (a)
+#define CHI(y, x, a, b, c) ((a) ^ (~(b) & (c)))
+#include "keccakf1600.inc"
+}
+
+/*************************************************
+* Name:        keccakf1600_supported_bmi1
+*
+* Description: Check that the CPU supports BMI1
+*
+* Returns 1 if supported and 0 otherwise
+**************************************************/
+int keccakf1600_supported_bmi1(void)
+{
+#if defined(_MSC_VER)
+  int r[4];
+
+  __cpuidex(r, 7, 0);
+  return (r[1] >> 3) & 1;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("bmi") != 0;
+#endif
+}
+#endif
@@ -0,0 +1,107 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "fips202.h"
+#include "keccakf1600.h"
+
+#ifdef KECCAKF1600_X86_64
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include "fips202x4.h"
+
+#define NROUNDS 24
+
+/*************************************************
+* Name:        KeccakF1600_StatePermute4x
+*
+* Description: The Keccak F1600 permutation applied to four independent
+*              states held one per 64-bit lane of each AVX2 register.
+*              Rotations by 8 and 56 are byte shuffles.
+*
+* Arguments:   - __m256i *state: pointer to input/output Keccak states
+**************************************************/
+KECCAKF1600_TARGET("avx2")
+void KeccakF1600_StatePermute4x(__m256i *state)
+{
+  const __m256i rho8 = _mm256_set_epi8(30, 29, 28, 27, 26, 25, 24, 31, 22, 21, 20, 19, 18, 17, 16, 23,
+                                       14, 13, 12, 11, 10, 9, 8, 15, 6, 5, 4, 3, 2, 1, 0, 7);
+  const __m256i rho56 = _mm256_set_epi8(24, 31, 30, 29, 28, 27, 26, 25, 16, 23, 22, 21, 20, 19, 18, 17,
+                                        8, 15, 14, 13, 12, 11, 10, 9, 0, 7, 6, 5, 4, 3, 2, 1);
+#define V __m256i
+#define LOAD(s, i) _mm256_load_si256(&(s)[i])
+#define STORE(s, i, a) _mm256_store_si256(&(s)[i], a)
+#define XOR(a, b) _mm256_xor_si256(a, b)
+#define XOR5(a, b, c, d, e) XOR(XOR(XOR(a, b), XOR(c, d)), e)
+#define ROL(a, o) ((o) == 8 ? _mm256_shuffle_epi8(a, rho8) : \
+                   (o) == 56 ? _mm256_shuffle_epi8(a, rho56) : \
+                   _mm256_or_si256(_mm256_slli_epi64(a, o), _mm256_srli_epi64(a, 64-(o))))
+#define CHI(y, x, a, b, c) XOR(a, _mm256_andnot_si256(b, c))
+#define RC(i) _mm256_set1_epi64x(KeccakF_RoundConstants[i])
+#include "keccakf1600.inc"
+#undef V
+#undef LOAD
+#undef STORE
+#undef XOR
+#undef XOR5
+#undef ROL
+#undef CHI
+#undef RC
+}
+
+/*************************************************
+* Name:        keccakf1600_permute_x4_avx2
+*
+* Description: Backend entry point; transposes four scalar states into
+*              AVX2 lanes, permutes them and transposes back.
+*
+* Arguments:   - uint64_t (*state)[25]: pointer to four input/output states
+**************************************************/
+KECCAKF1600_TARGET("avx2")
+void keccakf1600_permute_x4_avx2(uint64_t (*state)[25])
+{
+  unsigned int i, j;
+  __m256i s[25];
+  union {
+    uint64_t w[4];
+    __m256i v;
+  } t;
+
+  for(i = 0; i < 25; ++i)
+    s[i] = _mm256_set_epi64x(state[3][i], state[2][i], state[1][i], state[0][i]);
+
+  KeccakF1600_StatePermute4x(s);
+
+  for(i = 0; i < 25; ++i) {
+    t.v = s[i];
+    for(j = 0; j < 4; ++j)
+      state[j][i] = t.w[j];
+  }
+}
+
+/*************************************************
+* Name:        keccakf1600_supported_avx2
+*
+* Description: Check that the CPU and operating system support AVX2
+*
+* Returns 1 if supported and 0 otherwise
+**************************************************/
+int keccakf1600_supported_avx2(void)
+{
+#if defined(_MSC_VER)
+  int r[4];
+
+  __cpuid(r, 1);
+  if(!(r[2] & (1 << 27)) || (_xgetbv(0) & 0x6) != 0x6)
+    return 0;
+  __cpuidex(r, 7, 0);
+  return (r[1] >> 5) & 1;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#else
+typedef int keccakf1600x4_unused;
+#endif
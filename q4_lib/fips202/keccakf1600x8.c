@@ -0,0 +1,95 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "fips202.h"
+#include "keccakf1600.h"
+
+#ifdef KECCAKF1600_X86_64
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include "fips202x8.h"
+
+#define NROUNDS 24
+
+/*************************************************
+* Name:        KeccakF1600_StatePermute8x
+*
+* Description: The Keccak F1600 permutation applied to eight independent
+*              states held one per 64-bit lane of each AVX-512 register.
+*              Five-way XOR and chi are single ternary-logic instructions.
+*
+* Arguments:   - __m512i *state: pointer to input/output Keccak states
+**************************************************/
+KECCAKF1600_TARGET("avx512f")
+void KeccakF1600_StatePermute8x(__m512i *state)
+{
+#define V __m512i
+#define LOAD(s, i) _mm512_load_si512(&(s)[i])
+#define STORE(s, i, a) _mm512_store_si512(&(s)[i], a)
+#define XOR(a, b) _mm512_xor_si512(a, b)
+#define XOR5(a, b, c, d, e) _mm512_ternarylogic_epi64(_mm512_ternarylogic_epi64(a, b, c, 0x96), d, e, 0x96)
+#define ROL(a, o) _mm512_rol_epi64(a, o)
+#define CHI(y, x, a, b, c) _mm512_ternarylogic_epi64(a, b, c, 0xD2)
+#define RC(i) _mm512_set1_epi64(KeccakF_RoundConstants[i])
+#include "keccakf1600.inc"
+#undef V
+#undef LOAD
+#undef STORE
+#undef XOR
+#undef XOR5
+#undef ROL
+#undef CHI
+#undef RC
+}
+
+/*************************************************
+* Name:        keccakf1600_permute_x8_avx512
+*
+* Description: Backend entry point; gathers eight scalar states into
+*              AVX-512 lanes, permutes them and scatters them back.
+*
+* Arguments:   - uint64_t (*state)[25]: pointer to eight input/output states
+**************************************************/
+KECCAKF1600_TARGET("avx512f")
+void keccakf1600_permute_x8_avx512(uint64_t (*state)[25])
+{
+  unsigned int i;
+  __m512i s[25], idx;
+
+  idx = _mm512_set_epi64(7*25, 6*25, 5*25, 4*25, 3*25, 2*25, 25, 0);
+  for(i = 0; i < 25; ++i)
+    s[i] = _mm512_i64gather_epi64(idx, (const void *)&state[0][i], 8);
+
+  KeccakF1600_StatePermute8x(s);
+
+  for(i = 0; i < 25; ++i)
+    _mm512_i64scatter_epi64((void *)&state[0][i], idx, s[i], 8);
+}
+
+/*************************************************
+* Name:        keccakf1600_supported_avx512
+*
+* Description: Check that the CPU and operating system support AVX-512F
+*
+* Returns 1 if supported and 0 otherwise
+**************************************************/
+int keccakf1600_supported_avx512(void)
+{
+#if defined(_MSC_VER)
+  int r[4];
+
+  __cpuid(r, 1);
+  if(!(r[2] & (1 << 27)) || (_xgetbv(0) & 0xE6) != 0xE6)
+    return 0;
+  __cpuidex(r, 7, 0);
+  return (r[1] >> 16) & 1;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx512f") != 0;
+#endif
+}
+
+#else
+typedef int keccakf1600x8_unused;
+#endif
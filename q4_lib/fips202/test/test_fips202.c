@@ -0,0 +1,135 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "../fips202.h"
+#include "../keccakf1600.h"
+
+#define NTESTS 100
+
+static int check(const char *name, const uint8_t *out, const char *hex)
+{
+  size_t i;
+  unsigned int v;
+
+  for(i = 0; hex[2*i]; ++i) {
+    sscanf(&hex[2*i], "%2x", &v);
+    if(out[i] != v) {
+      printf("%s: wrong output\n", name);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+static int test_kats(void)
+{
+  int r = 0;
+  unsigned int i;
+  uint8_t in[200], out[64];
+
+  for(i = 0; i < sizeof(in); ++i)
+    in[i] = i;
+
+  sha3_256(out, in, 0);
+  r |= check("sha3_256", out, "a7ffc6f8bf1ed76651c14756a061d662f580ff4de43b49fa82d80a4b80f8434a");
+  sha3_512(out, (const uint8_t *)"abc", 3);
+  r |= check("sha3_512", out, "b751850b1a57168a5693cd924b6b096e08f621827444f70d884f5d0240d2712e"
+                               "10e116e9192af3c91a7ec57647e3934057340b4cf408d5a56592f8274eec53f0");
+  shake128(out, 32, in, 0);
+  r |= check("shake128", out, "7f9c2ba4e88f827d616045507605853ed73b8093f6efbc88eb1a6eacfa66ef26");
+  shake256(out, 32, in, sizeof(in));
+  r |= check("shake256", out, "4ee1ca03272b05d3bfb1e1c79a967f823b9fc5e4bb3987b1ba9e9cb5afb07a5e");
+
+  return r;
+}
+
+static int test_many(void)
+{
+  unsigned int i, n;
+  size_t inlen[21];
+  const uint8_t *in[21];
+  uint8_t *out[21];
+  static uint8_t msg[21][600], h[21][300], r[300];
+
+  for(n = 1; n <= 21; n += 4) {
+    for(i = 0; i < n; ++i) {
+      inlen[i] = (i*137 + n*61) % 600;
+      memset(msg[i], i + n, inlen[i]);
+      in[i] = msg[i];
+      out[i] = h[i];
+    }
+
+    shake256_many(out, 300, in, inlen, n);
+    for(i = 0; i < n; ++i) {
+      shake256(r, 300, in[i], inlen[i]);
+      if(memcmp(r, h[i], 300))
+        return 1;
+    }
+    sha3_256_many(out, in, inlen, n);
+    for(i = 0; i < n; ++i) {
+      sha3_256(r, in[i], inlen[i]);
+      if(memcmp(r, h[i], 32))
+        return 1;
+    }
+    sha3_512_many(out, in, inlen, n);
+    for(i = 0; i < n; ++i) {
+      sha3_512(r, in[i], inlen[i]);
+      if(memcmp(r, h[i], 64))
+        return 1;
+    }
+  }
+
+  return 0;
+}
+
+static uint64_t state[19][25], ref[19][25];
+
+int main(void)
+{
+  int r = 0;
+  unsigned int i, j, n;
+  uint64_t x = 0x0123456789abcdefULL;
+  const keccakf1600_backend *b;
+
+  r |= test_kats();
+
+  for(b = keccakf1600_backends; b->name; ++b) {
+    if(keccakf1600_select(b->name)) {
+      printf("%-10s not supported\n", b->name);
+      continue;
+    }
+    r |= test_kats();
+
+    for(i = 0; i < NTESTS; ++i) {
+      n = i % 19 + 1;
+      for(j = 0; j < 25*n; ++j) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        state[j/25][j%25] = ref[j/25][j%25] = x;
+      }
+
+      KeccakF1600_StatePermute_many(state, n);
+      for(j = 0; j < n; ++j)
+        keccakf1600_permute_scalar(&ref[j]);
+
+      if(memcmp(state, ref, n*sizeof(ref[0]))) {
+        printf("%s: wrong permutation for n = %u\n", b->name, n);
+        r = 1;
+        break;
+      }
+    }
+    if(i == NTESTS && test_many()) {
+      printf("%s: wrong multi-buffer hash\n", b->name);
+      r = 1;
+      i = 0;
+    }
+    printf("%-10s %s\n", b->name, i == NTESTS ? "ok" : "FAILED");
+  }
+
+  keccakf1600_select(NULL);
+  printf("active: %s (single), %s (many)\n",
+         keccakf1600_active(0)->name, keccakf1600_active(1)->name);
+
+  return r;
+}
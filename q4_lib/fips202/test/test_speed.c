@@ -0,0 +1,86 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "../fips202.h"
+#include "../keccakf1600.h"
+#include "../../bench/cpucycles.h"
+#include "../../bench/speed_print.h"
+
+#define NTESTS 1000
+#define NSTATES 8
+#define NMSGS 64
+#define MSGLEN 1184
+
+uint64_t *t;
+size_t ntests;
+static uint64_t state[NSTATES][25];
+static uint8_t msg[NMSGS][MSGLEN], h[NMSGS][32];
+
+int main(void)
+{
+  unsigned int i, j;
+  char label[64];
+  size_t inlen[NMSGS];
+  const uint8_t *in[NMSGS];
+  uint8_t *out[NMSGS];
+  uint8_t buf[SHAKE128_RATE*5];
+  const keccakf1600_backend *b;
+
+  ntests = speed_init("fips202", NTESTS);
+  t = malloc(ntests * sizeof(uint64_t));
+  if(!t)
+    return 1;
+
+  for(i = 0; i < NMSGS; ++i) {
+    inlen[i] = MSGLEN;
+    in[i] = msg[i];
+    out[i] = h[i];
+  }
+
+  for(b = keccakf1600_backends; b->name; ++b) {
+    if(keccakf1600_select(b->name))
+      continue;
+
+    snprintf(label, sizeof(label), "%s permute (%u lanes):", b->name, b->lanes);
+    for(i = 0; i < ntests; ++i) {
+      t[i] = cpucycles();
+      b->permute(state);
+    }
+    print_results(label, t, ntests);
+
+    snprintf(label, sizeof(label), "%s permute_many (%u states):", b->name, NSTATES);
+    for(i = 0; i < ntests; ++i) {
+      t[i] = cpucycles();
+      KeccakF1600_StatePermute_many(state, NSTATES);
+    }
+    print_results(label, t, ntests);
+
+    snprintf(label, sizeof(label), "%s sha3_256_many (%u x %u bytes):", b->name, NMSGS, MSGLEN);
+    for(i = 0; i < ntests; ++i) {
+      t[i] = cpucycles();
+      sha3_256_many(out, in, inlen, NMSGS);
+    }
+    print_results(label, t, ntests);
+
+    if(b->lanes > 1)
+      continue;
+
+    snprintf(label, sizeof(label), "%s sha3_256 loop (%u x %u bytes):", b->name, NMSGS, MSGLEN);
+    for(i = 0; i < ntests; ++i) {
+      t[i] = cpucycles();
+      for(j = 0; j < NMSGS; ++j)
+        sha3_256(out[j], in[j], inlen[j]);
+    }
+    print_results(label, t, ntests);
+
+    snprintf(label, sizeof(label), "%s shake128 (%u bytes):", b->name, (unsigned int)sizeof(buf));
+    for(i = 0; i < ntests; ++i) {
+      t[i] = cpucycles();
+      shake128(buf, sizeof(buf), buf, 34);
+    }
+    print_results(label, t, ntests);
+  }
+
+  free(t);
+  return speed_finish();
+}
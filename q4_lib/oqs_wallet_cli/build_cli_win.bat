@@ -9,4 +9,4 @@ if exist "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\B
 if not exist build mkdir build
 
 echo Building oqs_wallet_cli...
-cl /EHsc /std:c++17 /I ..\..\..\build_liboqs_win\include src\main.cpp src\rng_deterministic.cpp src\json_emit.cpp /link /LIBPATH:..\..\..\build_liboqs_win\lib\Release oqs.lib Advapi32.lib /OUT:build\oqs_wallet_cli.exe
+cl /EHsc /std:c++17 /I ..\..\..\build_liboqs_win\include src\main.cpp src\rng_deterministic.cpp src\json_emit.cpp src\keystore.cpp src\mapped_file.cpp src\addr_index.cpp src\bech32.cpp src\hd_derive.cpp src\addr_pool.cpp src\export_writer.cpp src\wallet_audit.cpp src\secure_arena.cpp ..\fips202\fips202.c ..\fips202\fips202mb.c ..\fips202\keccakf1600.c ..\fips202\keccakf1600lc.c ..\fips202\keccakf1600x4.c ..\fips202\keccakf1600x8.c /DDILITHIUM_MODE=3 "..\..\Dilithium C lang\Dilithium C\ref\sign.c" "..\..\Dilithium C lang\Dilithium C\ref\packing.c" "..\..\Dilithium C lang\Dilithium C\ref\polyvec.c" "..\..\Dilithium C lang\Dilithium C\ref\poly.c" "..\..\Dilithium C lang\Dilithium C\ref\ntt.c" "..\..\Dilithium C lang\Dilithium C\ref\reduce.c" "..\..\Dilithium C lang\Dilithium C\ref\rounding.c" "..\..\Dilithium C lang\Dilithium C\ref\symmetric-shake.c" /link /LIBPATH:..\..\..\build_liboqs_win\lib\Release oqs.lib Advapi32.lib /OUT:build\oqs_wallet_cli.exe
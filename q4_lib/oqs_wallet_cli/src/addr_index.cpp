@@ -0,0 +1,188 @@
+#include "addr_index.h"
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+extern "C" {
+#include "../../fips202/fips202.h"
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define AI_PREFETCH(p) __builtin_prefetch(p)
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <xmmintrin.h>
+#define AI_PREFETCH(p) _mm_prefetch((const char*)(p), _MM_HINT_T0)
+#else
+#define AI_PREFETCH(p) ((void)(p))
+#endif
+
+#define AI_MAGIC "QTCADRX"
+#define AI_VERSION 1
+#define AI_PAGE 4096u
+#define AI_USED 0x80000000u   // set in account; hardened accounts are below 2^31
+#define AI_PREFETCH_AHEAD 8
+
+struct AddressIndex::Header {
+    char magic[8];
+    le32 version;
+    le32 page_bytes;
+    le32 purpose;
+    le32 reserved;
+    le64 table_offset;
+    le64 table_capacity;   // entries, power of two
+    le64 count;
+    le64 end;              // first free byte, page aligned
+};
+
+struct ProgramEntry {
+    uint8_t program[QTC_WITNESS_PROGRAM_BYTES];
+    le32 account;
+    le32 change;
+    le32 index;
+};
+
+static_assert(sizeof(ProgramEntry) == 32, "address index entry layout");
+
+void witness_program(uint8_t program[QTC_WITNESS_PROGRAM_BYTES], const uint8_t* pk, size_t pk_len) {
+    uint8_t h[32];
+    sha3_256(h, pk, pk_len);
+    std::memcpy(program, h, QTC_WITNESS_PROGRAM_BYTES);
+}
+
+void witness_programs_many(uint8_t* programs, const uint8_t* const* pks, const size_t* pk_len, size_t n) {
+    std::vector<uint8_t> h(n * 32);
+    std::vector<uint8_t*> out(n);
+    for (size_t i = 0; i < n; ++i) out[i] = &h[i * 32];
+    sha3_256_many(out.data(), const_cast<const uint8_t**>(pks), pk_len, n);
+    for (size_t i = 0; i < n; ++i)
+        std::memcpy(programs + i * QTC_WITNESS_PROGRAM_BYTES, out[i], QTC_WITNESS_PROGRAM_BYTES);
+}
+
+static uint64_t table_page_round(uint64_t n) {
+    return (n + AI_PAGE - 1) & ~(uint64_t)(AI_PAGE - 1);
+}
+
+// The program is a hash already; its leading bytes, read little-endian so
+// the file is portable, are the bucket
+static uint64_t program_bucket(const uint8_t* program, uint64_t capacity) {
+    return *reinterpret_cast<const le64*>(program) & (capacity - 1);
+}
+
+static ProgramEntry* table_probe(ProgramEntry* table, uint64_t capacity, const uint8_t* program) {
+    uint64_t mask = capacity - 1;
+    uint64_t i = program_bucket(program, capacity);
+    for (uint64_t n = 0; n < capacity; ++n, i = (i + 1) & mask) {
+        if (!(table[i].account & AI_USED) ||
+            std::memcmp(table[i].program, program, QTC_WITNESS_PROGRAM_BYTES) == 0)
+            return &table[i];
+    }
+    throw std::runtime_error("corrupt address index: no free entry");
+}
+
+AddressIndex AddressIndex::create(const std::string& file, uint32_t purpose, uint64_t expected) {
+    uint64_t capacity = 16;
+    while (capacity * 3 < expected * 4) capacity *= 2;
+    uint64_t table_bytes = table_page_round(capacity * sizeof(ProgramEntry));
+
+    AddressIndex ai(MappedFile(file, true, true, AI_PAGE + table_bytes));
+    Header* h = ai.hdr();
+    std::memcpy(h->magic, AI_MAGIC, sizeof(h->magic));
+    h->version = AI_VERSION;
+    h->page_bytes = AI_PAGE;
+    h->purpose = purpose;
+    h->table_offset = AI_PAGE;
+    h->table_capacity = capacity;
+    h->count = 0;
+    h->end = AI_PAGE + table_bytes;
+    return ai;
+}
+
+AddressIndex::AddressIndex(const std::string& file, bool writable) : file_(file, writable, false) {
+    uint64_t size = file_.size();
+    if (size < AI_PAGE) throw std::runtime_error("not an address index: " + file);
+    const Header* h = hdr();
+    if (std::memcmp(h->magic, AI_MAGIC, sizeof(h->magic)) != 0 || h->version != AI_VERSION ||
+        h->page_bytes != AI_PAGE)
+        throw std::runtime_error("not an address index: " + file);
+    uint64_t cap = h->table_capacity;
+    if (cap == 0 || (cap & (cap - 1)) || h->table_offset % AI_PAGE ||
+        h->table_offset + cap * sizeof(ProgramEntry) > h->end || h->end > size ||
+        h->count * 4 > cap * 3)
+        throw std::runtime_error("corrupt address index: " + file);
+}
+
+AddressIndex::~AddressIndex() {
+    if (file_.data()) file_.close(hdr()->end);
+}
+
+void AddressIndex::grow_table() {
+    uint64_t capacity = hdr()->table_capacity * 2;
+    uint64_t bytes = table_page_round(capacity * sizeof(ProgramEntry));
+    uint64_t offset = hdr()->end;
+    file_.grow(offset + bytes);
+
+    Header* h = hdr();
+    ProgramEntry* old_table = reinterpret_cast<ProgramEntry*>(file_.data() + h->table_offset);
+    ProgramEntry* table = reinterpret_cast<ProgramEntry*>(file_.data() + offset);
+    std::memset(table, 0, bytes);
+    for (uint64_t i = 0; i < h->table_capacity; ++i) {
+        if (old_table[i].account & AI_USED)
+            *table_probe(table, capacity, old_table[i].program) = old_table[i];
+    }
+    h->end = offset + bytes;
+    h->table_capacity = capacity;
+    h->table_offset = offset;
+}
+
+void AddressIndex::add(const uint8_t program[QTC_WITNESS_PROGRAM_BYTES], const HdPath& path) {
+    if (!file_.writable()) throw std::runtime_error("address index opened read-only");
+    if (path.purpose != hdr()->purpose)
+        throw std::runtime_error("address index holds purpose " + std::to_string(hdr()->purpose));
+    if (path.account & AI_USED) throw std::runtime_error("HD path component out of range");
+
+    if ((hdr()->count + 1) * 4 > hdr()->table_capacity * 3) grow_table();
+
+    Header* h = hdr();
+    ProgramEntry* e = table_probe(reinterpret_cast<ProgramEntry*>(file_.data() + h->table_offset),
+                                  h->table_capacity, program);
+    if (e->account & AI_USED)
+        throw std::runtime_error("address index already maps program to " +
+                                 hd_path_to_string(HdPath{h->purpose, e->account & ~AI_USED,
+                                                          e->change, e->index}));
+    std::memcpy(e->program, program, QTC_WITNESS_PROGRAM_BYTES);
+    e->change = path.change;
+    e->index = path.index;
+    e->account = path.account | AI_USED;
+    h->count = h->count + 1;
+}
+
+bool AddressIndex::lookup(const uint8_t program[QTC_WITNESS_PROGRAM_BYTES], HdPath& path) const {
+    bool found;
+    lookup_many(program, 1, &path, &found);
+    return found;
+}
+
+size_t AddressIndex::lookup_many(const uint8_t* programs, size_t n, HdPath* paths, bool* found) const {
+    const Header* h = hdr();
+    ProgramEntry* table = reinterpret_cast<ProgramEntry*>(file_.data() + h->table_offset);
+    uint64_t cap = h->table_capacity;
+    size_t hits = 0;
+
+    for (size_t i = 0; i < n && i < AI_PREFETCH_AHEAD; ++i)
+        AI_PREFETCH(&table[program_bucket(programs + i * QTC_WITNESS_PROGRAM_BYTES, cap)]);
+    for (size_t i = 0; i < n; ++i) {
+        if (i + AI_PREFETCH_AHEAD < n) {
+            const uint8_t* next = programs + (i + AI_PREFETCH_AHEAD) * QTC_WITNESS_PROGRAM_BYTES;
+            AI_PREFETCH(&table[program_bucket(next, cap)]);
+        }
+        const ProgramEntry* e = table_probe(table, cap, programs + i * QTC_WITNESS_PROGRAM_BYTES);
+        found[i] = (e->account & AI_USED) != 0;
+        if (found[i]) {
+            paths[i] = HdPath{h->purpose, e->account & ~AI_USED, e->change, e->index};
+            hits++;
+        }
+    }
+    return hits;
+}
+
+uint64_t AddressIndex::count() const { return hdr()->count; }
+uint32_t AddressIndex::purpose() const { return hdr()->purpose; }
@@ -0,0 +1,56 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include "keystore.h"
+#include "mapped_file.h"
+#include "bech32.h"
+
+// On-disk hash index from witness program to derivation path, used to
+// attribute incoming outputs to the HD index that produced the address.
+//
+// Layout: a header page, then an open-addressing table of 32-byte entries
+// (20-byte program, account, change, index). Programs are SHA3-256 output,
+// so their first 8 bytes pick the bucket directly and a lookup is a single
+// probe sequence in the mapping, usually one cache line. One index covers
+// one purpose. Appends fill entries in place; at 3/4 load a doubled table is
+// appended at the end of the file and the header switched to it.
+
+// First 20 bytes of SHA3-256(pk), as generateAddress() in qti3_hd.js
+void witness_program(uint8_t program[QTC_WITNESS_PROGRAM_BYTES], const uint8_t* pk, size_t pk_len);
+
+// Programs of n public keys. The hashes run side by side in the 4- or 8-lane
+// Keccak backend of q4_lib/fips202 when the CPU has AVX2 or AVX-512.
+void witness_programs_many(uint8_t* programs, const uint8_t* const* pks, const size_t* pk_len, size_t n);
+
+class AddressIndex {
+public:
+    // Creates an empty index sized for expected programs; fails if file exists
+    static AddressIndex create(const std::string& file, uint32_t purpose, uint64_t expected = 1024);
+    AddressIndex(const std::string& file, bool writable);
+    AddressIndex(AddressIndex&&) = default;
+    AddressIndex(const AddressIndex&) = delete;
+    AddressIndex& operator=(const AddressIndex&) = delete;
+    ~AddressIndex();
+
+    // Throws if the program is already indexed or the purpose differs
+    void add(const uint8_t program[QTC_WITNESS_PROGRAM_BYTES], const HdPath& path);
+    bool lookup(const uint8_t program[QTC_WITNESS_PROGRAM_BYTES], HdPath& path) const;
+    // Looks up n contiguous programs, prefetching ahead; found[i] tells
+    // whether paths[i] was filled. Returns the number of hits.
+    size_t lookup_many(const uint8_t* programs, size_t n, HdPath* paths, bool* found) const;
+
+    uint64_t count() const;
+    uint32_t purpose() const;
+    void sync() { file_.sync(); }
+
+private:
+    explicit AddressIndex(MappedFile&& file) : file_(std::move(file)) {}
+    void grow_table();
+
+    struct Header;
+    Header* hdr() const { return reinterpret_cast<Header*>(file_.data()); }
+
+    MappedFile file_;
+};
@@ -0,0 +1,293 @@
+#include "addr_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#define POOL_STATE_MAGIC "qtc-address-pool"
+#define POOL_STATE_VERSION 1
+#define POOL_MAX_INDEX 0x7fffffffu
+
+AddressPool::Ring::Ring(size_t size) {
+    size_t n = 2;
+    while (n < size) n *= 2;
+    cells.reset(new Cell[n]);
+    for (size_t i = 0; i < n; ++i) cells[i].seq.store(i, std::memory_order_relaxed);
+    mask = n - 1;
+}
+
+// Claims the next slot; false if the ring is full. Called with the account
+// lock held, which serialises producers.
+bool AddressPool::Ring::claim(size_t& pos) {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (cells[h & mask].seq.load(std::memory_order_acquire) != h) return false;
+    head.store(h + 1, std::memory_order_release);
+    pos = h;
+    return true;
+}
+
+// Publishes a claimed slot to pop(); called with the account lock held
+void AddressPool::Ring::fill(size_t pos, const DerivedAddress& v) {
+    Cell& c = cells[pos & mask];
+    c.value = v;
+    c.seq.store(pos + 1, std::memory_order_release);
+}
+
+bool AddressPool::Ring::pop(DerivedAddress& v) {
+    size_t pos = tail.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& c = cells[pos & mask];
+        size_t seq = c.seq.load(std::memory_order_acquire);
+        intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (dif == 0) {
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                v = c.value;
+                c.seq.store(pos + mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (dif < 0) {
+            return false;
+        } else {
+            pos = tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Copy of the oldest filled entry. Called with the account lock held, so no
+// producer rewrites a cell while it is copied; a concurrent pop() only reads
+// it. Retried if the entry was taken meanwhile.
+bool AddressPool::Ring::front(DerivedAddress& v) const {
+    for (;;) {
+        size_t pos = tail.load(std::memory_order_acquire);
+        const Cell& c = cells[pos & mask];
+        if (c.seq.load(std::memory_order_acquire) == pos + 1) {
+            v = c.value;
+            if (tail.load(std::memory_order_acquire) == pos) return true;
+        } else if (tail.load(std::memory_order_acquire) == pos) {
+            return false;
+        }
+    }
+}
+
+size_t AddressPool::Ring::size() const {
+    size_t h = head.load(std::memory_order_acquire);
+    size_t t = tail.load(std::memory_order_acquire);
+    return h > t ? h - t : 0;
+}
+
+AddressPool::AddressPool(const AddressPoolConfig& cfg) : cfg_(cfg) {
+    if (cfg_.master_entropy.empty()) throw std::runtime_error("address pool needs the master entropy");
+    if (cfg_.reserve_block == 0) cfg_.reserve_block = 1;
+    for (uint32_t id : cfg_.accounts) {
+        if (id > POOL_MAX_INDEX) throw std::runtime_error("HD path component out of range");
+        auto it = std::find_if(accounts_.begin(), accounts_.end(),
+                               [&](const std::unique_ptr<Account>& a) { return a->id == id; });
+        if (it == accounts_.end()) accounts_.emplace_back(new Account(id, cfg_.ring_size));
+    }
+    load_state();
+
+    unsigned n = cfg_.workers ? cfg_.workers : std::thread::hardware_concurrency();
+    if (n == 0) n = 1;
+    for (unsigned i = 0; i < n; ++i) threads_.emplace_back(&AddressPool::worker, this);
+}
+
+AddressPool::~AddressPool() {
+    stop_ = true;
+    wake();
+    for (auto& t : threads_) t.join();
+    // Addresses left in the rings are dropped, so only the indexes taken stay
+    // reserved; issued starts at the loaded reservation and never falls below it
+    std::lock_guard<std::mutex> guard(state_lock_);
+    for (auto& a : accounts_) {
+        if (a->served) a->reserved = a->issued.load();
+    }
+    try { save_state(nullptr, 0); } catch (...) {}
+}
+
+AddressPool::Account& AddressPool::find(uint32_t account) {
+    for (auto& a : accounts_) {
+        if (a->id == account && a->served) return *a;
+    }
+    throw std::runtime_error("address pool does not serve account " + std::to_string(account));
+}
+
+bool AddressPool::take(uint32_t account, DerivedAddress& out) {
+    Account& a = find(account);
+    if (!a.ring.pop(out)) {
+        if (failed_) throw std::runtime_error(error_);
+        return false;
+    }
+    uint32_t next = out.path.index + 1, issued = a.issued.load();
+    while (issued < next && !a.issued.compare_exchange_weak(issued, next)) {}
+    if (a.ring.size() < cfg_.low_watermark && !a.refilling.exchange(true)) wake();
+    return true;
+}
+
+bool AddressPool::peek(uint32_t account, DerivedAddress& out) {
+    Account& a = find(account);
+    std::lock_guard<std::mutex> guard(a.lock);
+    return a.ring.front(out);
+}
+
+size_t AddressPool::available(uint32_t account) {
+    Account& a = find(account);
+    std::lock_guard<std::mutex> guard(a.lock);
+    return a.ring.size() - a.inflight;
+}
+
+void AddressPool::mark_used(uint32_t account, uint32_t index) {
+    Account& a = find(account);
+    int64_t used = a.last_used.load();
+    while (used < (int64_t)index && !a.last_used.compare_exchange_weak(used, (int64_t)index)) {}
+    if (cfg_.gap_limit) wake();
+}
+
+void AddressPool::wake() {
+    std::lock_guard<std::mutex> guard(wake_lock_);
+    wake_cv_.notify_all();
+}
+
+// Next index to derive, unless that would pass the gap limit. Called with
+// the account lock held; the caller advances next once it has a ring slot.
+bool AddressPool::claim(Account& a, uint32_t& index) {
+    if (a.next > POOL_MAX_INDEX) return false;
+    if (cfg_.gap_limit && (int64_t)a.next > a.last_used.load() + (int64_t)cfg_.gap_limit) return false;
+    index = a.next;
+    return true;
+}
+
+// Persists a reservation covering index before its address is handed out.
+// With a gap limit the reservation ends at the window, where claim() stops.
+void AddressPool::reserve(Account& a, uint32_t index) {
+    std::lock_guard<std::mutex> guard(state_lock_);
+    uint64_t r = a.reserved.load();
+    if (index < r) return;
+    while (index >= r) r += cfg_.reserve_block;
+    if (cfg_.gap_limit) r = std::min<uint64_t>(r, (uint64_t)(a.last_used.load() + 1) + cfg_.gap_limit);
+    uint32_t reserved = (uint32_t)std::min<uint64_t>(r, POOL_MAX_INDEX + 1ULL);
+    save_state(&a, reserved);
+    a.reserved.store(reserved);
+}
+
+void AddressPool::load_state() {
+    if (cfg_.state_file.empty()) return;
+    std::ifstream in(cfg_.state_file);
+    if (!in) return;
+
+    std::string magic;
+    int version = 0;
+    uint32_t purpose = 0, change = 0;
+    if (!(in >> magic >> version >> purpose >> change) || magic != POOL_STATE_MAGIC ||
+        version != POOL_STATE_VERSION)
+        throw std::runtime_error("not an address pool state file: " + cfg_.state_file);
+    if (purpose != cfg_.purpose || change != cfg_.change)
+        throw std::runtime_error("address pool state is for another purpose or change");
+
+    uint32_t id, reserved;
+    int64_t last_used;
+    while (in >> id >> reserved >> last_used) {
+        if (id > POOL_MAX_INDEX) throw std::runtime_error("corrupt address pool state");
+        Account* a = nullptr;
+        for (auto& p : accounts_) {
+            if (p->id == id) a = p.get();
+        }
+        // Accounts not served this run still keep their reservations
+        if (!a) {
+            accounts_.emplace_back(new Account(id, 2));
+            a = accounts_.back().get();
+            a->served = false;
+            a->refilling = false;
+        }
+        a->reserved = reserved;
+        a->issued = reserved;
+        a->next = reserved;
+        a->last_used = last_used;
+    }
+}
+
+// Writes every account, with changed at reserved, to a temporary file that
+// is synced and renamed over the old state. Called with state_lock_ held.
+void AddressPool::save_state(const Account* changed, uint32_t reserved) {
+    if (cfg_.state_file.empty()) return;
+    std::ostringstream out;
+    out << POOL_STATE_MAGIC << " " << POOL_STATE_VERSION << " " << cfg_.purpose << " " << cfg_.change << "\n";
+    for (auto& a : accounts_) {
+        uint32_t r = a.get() == changed ? reserved : a->reserved.load();
+        out << a->id << " " << r << " " << a->last_used.load() << "\n";
+    }
+    std::string data = out.str();
+    std::string tmp = cfg_.state_file + ".tmp";
+
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) throw std::runtime_error("cannot write " + tmp);
+    bool ok = std::fwrite(data.data(), 1, data.size(), f) == data.size() && std::fflush(f) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(f)) == 0;
+    ok = (std::fclose(f) == 0) && ok;
+    ok = ok && MoveFileExA(tmp.c_str(), cfg_.state_file.c_str(),
+                           MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+    ok = ok && fsync(fileno(f)) == 0;
+    ok = (std::fclose(f) == 0) && ok;
+    ok = ok && std::rename(tmp.c_str(), cfg_.state_file.c_str()) == 0;
+#endif
+    if (!ok) throw std::runtime_error("cannot write " + cfg_.state_file);
+}
+
+void AddressPool::worker() {
+    while (!stop_) {
+        bool worked = false;
+        for (auto& p : accounts_) {
+            Account& a = *p;
+            if (stop_) break;
+            if (!a.served || !a.refilling.load()) continue;
+            // Index and ring slot are claimed together, so the ring stays in index order
+            uint32_t index;
+            size_t pos;
+            {
+                std::lock_guard<std::mutex> guard(a.lock);
+                if (!claim(a, index)) continue;
+                if (!a.ring.claim(pos)) {
+                    a.refilling = false;
+                    continue;
+                }
+                a.next++;
+                a.inflight++;
+            }
+            DerivedAddress d;
+            try {
+                if (index >= a.reserved.load()) reserve(a, index);
+                hd_derive_address(d, cfg_.master_entropy,
+                                  HdPath{cfg_.purpose, a.id, cfg_.change, index}, cfg_.mode);
+            } catch (const std::exception& e) {
+                // The claimed slot stays empty; take() reports the failure
+                std::lock_guard<std::mutex> guard(state_lock_);
+                if (!failed_) {
+                    error_ = e.what();
+                    failed_ = true;
+                }
+                stop_ = true;
+                break;
+            }
+            {
+                std::lock_guard<std::mutex> guard(a.lock);
+                a.ring.fill(pos, d);
+                a.inflight--;
+            }
+            worked = true;
+        }
+        if (!worked && !stop_) {
+            std::unique_lock<std::mutex> lk(wake_lock_);
+            wake_cv_.wait_for(lk, std::chrono::milliseconds(100));
+        }
+    }
+}
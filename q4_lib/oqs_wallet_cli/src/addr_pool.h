@@ -0,0 +1,107 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "hd_derive.h"
+
+// Pool of pre-derived deposit addresses m/purpose'/account'/change/index.
+//
+// Each account has a bounded ring of addresses, handed out in index order.
+// take() pops the ring without locking, so handing out an address never
+// waits on keygen. Worker threads refill a ring once it drops below the low
+// watermark. Indexes are reserved in blocks, and the state file is written
+// before a block is used, so a restarted pool never hands out an index
+// twice; a clean shutdown gives back the reservations no address was taken
+// from. With a gap limit, no index past last used + gap_limit is derived or
+// reserved, so a wallet scanning with that gap limit finds every deposit and
+// a restarted pool resumes inside the window.
+
+struct AddressPoolConfig {
+    std::vector<uint8_t> master_entropy;
+    std::vector<uint32_t> accounts{0};
+    uint32_t purpose = 44;
+    uint32_t change = 0;
+    size_t ring_size = 256;          // rounded up to a power of two
+    size_t low_watermark = 64;
+    unsigned workers = 0;            // 0: one per hardware thread
+    uint32_t gap_limit = 0;          // 0: unlimited
+    uint32_t reserve_block = 256;
+    RngMode mode = RngMode::NistKat;
+    std::string state_file;          // empty: nothing is persisted
+};
+
+class AddressPool {
+public:
+    explicit AddressPool(const AddressPoolConfig& cfg);
+    ~AddressPool();
+    AddressPool(const AddressPool&) = delete;
+    AddressPool& operator=(const AddressPool&) = delete;
+
+    // Both return false if the ring is empty; throw for unknown accounts
+    bool take(uint32_t account, DerivedAddress& out);
+    bool peek(uint32_t account, DerivedAddress& out);
+    // Records a deposit to index, moving the gap-limit window forward
+    void mark_used(uint32_t account, uint32_t index);
+    size_t available(uint32_t account);
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        DerivedAddress value;
+    };
+
+    // Bounded queue (Vyukov) whose producers claim slots in index order and
+    // fill them once derived, both under the account lock. pop() needs no
+    // lock and stops at the first slot that is still being derived.
+    struct Ring {
+        explicit Ring(size_t size);
+        bool claim(size_t& pos);
+        void fill(size_t pos, const DerivedAddress& v);
+        bool pop(DerivedAddress& v);
+        bool front(DerivedAddress& v) const;
+        size_t size() const;                   // claimed slots, filled or not
+
+        std::unique_ptr<Cell[]> cells;
+        size_t mask;
+        alignas(64) std::atomic<size_t> head{0};
+        alignas(64) std::atomic<size_t> tail{0};
+    };
+
+    struct Account {
+        Account(uint32_t id, size_t ring_size) : id(id), ring(ring_size) {}
+        uint32_t id;
+        bool served = true;                    // false: only kept to persist its state
+        Ring ring;
+        std::mutex lock;                       // guards next, inflight and ring producers
+        uint32_t next = 0;                     // next index to derive
+        size_t inflight = 0;                   // claimed ring slots still being derived
+        std::atomic<uint32_t> reserved{0};     // persisted; indexes below it may be handed out
+        std::atomic<uint32_t> issued{0};       // one past the highest index taken
+        std::atomic<int64_t> last_used{-1};
+        std::atomic<bool> refilling{true};
+    };
+
+    Account& find(uint32_t account);
+    bool claim(Account& a, uint32_t& index);
+    void reserve(Account& a, uint32_t index);
+    void load_state();
+    void save_state(const Account* changed, uint32_t reserved);
+    void worker();
+    void wake();
+
+    AddressPoolConfig cfg_;
+    std::vector<std::unique_ptr<Account>> accounts_;
+    std::vector<std::thread> threads_;
+    std::mutex state_lock_;
+    std::mutex wake_lock_;
+    std::condition_variable wake_cv_;
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> failed_{false};
+    std::string error_;              // first worker failure, set before failed_
+};
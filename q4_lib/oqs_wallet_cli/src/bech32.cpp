@@ -0,0 +1,235 @@
+#include "bech32.h"
+#include <cstring>
+#include <stdexcept>
+
+#define BECH32_MAX_LENGTH 90
+#define BECH32_CHECKSUM_WORDS 6
+
+static const char charset[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+
+// Reverse of charset over lower-case ASCII, -1 for characters outside it
+static const int8_t charset_rev[128] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    15, -1, 10, 17, 21, 20, 26, 30,  7,  5, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 29, -1, 24, 13, 25,  9,  8, 23, -1, 18, 22, 31, 27, 19, -1,
+     1,  0,  3, 16, 11, 28, 12, 14,  6,  4,  2, -1, -1, -1, -1, -1
+};
+
+// XOR of the generator constants selected by the five bits shifted out
+static const uint32_t polymod_table[32] = {
+    0x00000000, 0x3b6a57b2, 0x26508e6d, 0x1d3ad9df,
+    0x1ea119fa, 0x25cb4e48, 0x38f19797, 0x039bc025,
+    0x3d4233dd, 0x0628646f, 0x1b12bdb0, 0x2078ea02,
+    0x23e32a27, 0x18897d95, 0x05b3a44a, 0x3ed9f3f8,
+    0x2a1462b3, 0x117e3501, 0x0c44ecde, 0x372ebb6c,
+    0x34b57b49, 0x0fdf2cfb, 0x12e5f524, 0x298fa296,
+    0x1756516e, 0x2c3c06dc, 0x3106df03, 0x0a6c88b1,
+    0x09f74894, 0x329d1f26, 0x2fa7c6f9, 0x14cd914b,
+};
+
+static inline uint32_t polymod_step(uint32_t chk, uint8_t v) {
+    return ((chk & 0x1ffffff) << 5) ^ v ^ polymod_table[chk >> 25];
+}
+
+static uint32_t polymod_hrp(const char* hrp, size_t len) {
+    uint32_t chk = 1;
+    for (size_t i = 0; i < len; ++i) chk = polymod_step(chk, (uint8_t)hrp[i] >> 5);
+    chk = polymod_step(chk, 0);
+    for (size_t i = 0; i < len; ++i) chk = polymod_step(chk, (uint8_t)hrp[i] & 31);
+    return chk;
+}
+
+static void append_checksum(std::string& out, uint32_t chk, Bech32Variant variant) {
+    for (int i = 0; i < BECH32_CHECKSUM_WORDS; ++i) chk = polymod_step(chk, 0);
+    chk ^= (uint32_t)variant;
+    for (int i = 0; i < BECH32_CHECKSUM_WORDS; ++i) out.push_back(charset[(chk >> (5 * (5 - i))) & 31]);
+}
+
+std::string bech32_encode(const std::string& hrp, const std::vector<uint8_t>& data, Bech32Variant variant) {
+    uint32_t chk = polymod_hrp(hrp.data(), hrp.size());
+    for (uint8_t v : data) {
+        if (v >> 5) throw std::runtime_error("bech32 data word out of range");
+        chk = polymod_step(chk, v);
+    }
+
+    std::string out;
+    out.reserve(hrp.size() + 1 + data.size() + BECH32_CHECKSUM_WORDS);
+    out += hrp;
+    out.push_back('1');
+    for (uint8_t v : data) out.push_back(charset[v]);
+    append_checksum(out, chk, variant);
+    return out;
+}
+
+// Parses s without allocating: hrp (lower-cased) and words are written to the
+// caller's buffers and residue is the final checksum state. Returns false
+// for malformed strings; the checksum itself is left to the caller.
+static bool decode_raw(const std::string& s, char* hrp, size_t& hrp_len,
+                       uint8_t* words, size_t& nwords, uint32_t& residue) {
+    size_t len = s.size();
+    if (len < 8 || len > BECH32_MAX_LENGTH) return false;
+
+    bool lower = false, upper = false;
+    size_t sep = len;
+    for (size_t i = 0; i < len; ++i) {
+        unsigned char c = (unsigned char)s[i];
+        if (c < 33 || c > 126) return false;
+        if (c >= 'a' && c <= 'z') lower = true;
+        if (c >= 'A' && c <= 'Z') upper = true;
+        if (c == '1') sep = i;
+    }
+    if (lower && upper) return false;
+    if (sep == len || sep == 0 || sep + 1 + BECH32_CHECKSUM_WORDS > len) return false;
+
+    for (size_t i = 0; i < sep; ++i) {
+        char c = s[i];
+        hrp[i] = (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+    }
+    hrp_len = sep;
+
+    uint32_t chk = polymod_hrp(hrp, hrp_len);
+    nwords = 0;
+    for (size_t i = sep + 1; i < len; ++i) {
+        unsigned char c = (unsigned char)s[i];
+        if (c >= 'A' && c <= 'Z') c = (unsigned char)(c + ('a' - 'A'));
+        int8_t v = charset_rev[c];
+        if (v < 0) return false;
+        words[nwords++] = (uint8_t)v;
+        chk = polymod_step(chk, (uint8_t)v);
+    }
+    nwords -= BECH32_CHECKSUM_WORDS;
+    residue = chk;
+    return true;
+}
+
+static bool residue_variant(uint32_t residue, Bech32Variant& variant) {
+    if (residue == (uint32_t)Bech32Variant::Bech32) variant = Bech32Variant::Bech32;
+    else if (residue == (uint32_t)Bech32Variant::Bech32m) variant = Bech32Variant::Bech32m;
+    else return false;
+    return true;
+}
+
+bool bech32_decode(const std::string& s, std::string& hrp, std::vector<uint8_t>& data, Bech32Variant& variant) {
+    char hrp_buf[BECH32_MAX_LENGTH];
+    uint8_t words[BECH32_MAX_LENGTH];
+    size_t hrp_len, nwords;
+    uint32_t residue;
+    if (!decode_raw(s, hrp_buf, hrp_len, words, nwords, residue) || !residue_variant(residue, variant))
+        return false;
+    hrp.assign(hrp_buf, hrp_len);
+    data.assign(words, words + nwords);
+    return true;
+}
+
+// Regroups 8-bit bytes into 5-bit words with zero padding, as bech32.toWords()
+static std::vector<uint8_t> to_words(const uint8_t* in, size_t len) {
+    std::vector<uint8_t> out;
+    out.reserve((len * 8 + 4) / 5 + 1);
+    uint32_t acc = 0;
+    int bits = 0;
+    for (size_t i = 0; i < len; ++i) {
+        acc = (acc << 8) | in[i];
+        bits += 8;
+        while (bits >= 5) {
+            bits -= 5;
+            out.push_back((acc >> bits) & 31);
+        }
+    }
+    if (bits) out.push_back((acc << (5 - bits)) & 31);
+    return out;
+}
+
+std::string qtc_address(const uint8_t* program, size_t len) {
+    if (len == QTC_WITNESS_PROGRAM_BYTES) {
+        std::vector<std::string> out;
+        qtc_address_encode_many(out, program, 1);
+        return out[0];
+    }
+    std::vector<uint8_t> data(1, QTC_WITNESS_VERSION);
+    std::vector<uint8_t> words = to_words(program, len);
+    data.insert(data.end(), words.begin(), words.end());
+    return bech32_encode(QTC_ADDRESS_HRP, data, Bech32Variant::Bech32);
+}
+
+// Checksum state after "qtc" and the witness version, shared by every address
+static uint32_t qtc_prefix_state() {
+    static const uint32_t chk =
+        polymod_step(polymod_hrp(QTC_ADDRESS_HRP, sizeof(QTC_ADDRESS_HRP) - 1), QTC_WITNESS_VERSION);
+    return chk;
+}
+
+void qtc_address_encode_many(std::vector<std::string>& out, const uint8_t* programs, size_t n) {
+    uint32_t prefix = qtc_prefix_state();
+    out.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+        const uint8_t* p = programs + k * QTC_WITNESS_PROGRAM_BYTES;
+        std::string& s = out[k];
+        s.clear();
+        s.reserve(QTC_ADDRESS_CHARS);
+        s += QTC_ADDRESS_HRP "1";
+        s.push_back(charset[QTC_WITNESS_VERSION]);
+
+        // 20 bytes are exactly 32 words, taken 5 bytes (8 words) at a time
+        uint32_t chk = prefix;
+        for (int i = 0; i < QTC_WITNESS_PROGRAM_BYTES; i += 5) {
+            uint64_t acc = ((uint64_t)p[i] << 32) | ((uint64_t)p[i + 1] << 24) | ((uint64_t)p[i + 2] << 16) |
+                           ((uint64_t)p[i + 3] << 8) | p[i + 4];
+            for (int j = 35; j >= 0; j -= 5) {
+                uint8_t v = (acc >> j) & 31;
+                chk = polymod_step(chk, v);
+                s.push_back(charset[v]);
+            }
+        }
+        append_checksum(s, chk, Bech32Variant::Bech32);
+    }
+}
+
+const char* address_status_string(AddressStatus s) {
+    switch (s) {
+    case AddressStatus::Ok: return "ok";
+    case AddressStatus::BadEncoding: return "not a valid bech32 string";
+    case AddressStatus::WrongHrp: return "not a qtc address";
+    case AddressStatus::WrongVariant: return "bech32m checksum, expected bech32";
+    case AddressStatus::WrongWitnessVersion: return "unsupported witness version";
+    case AddressStatus::BadProgram: return "invalid witness program";
+    }
+    return "unknown";
+}
+
+AddressStatus qtc_address_decode(uint8_t program[QTC_WITNESS_PROGRAM_BYTES], const std::string& address) {
+    char hrp[BECH32_MAX_LENGTH];
+    uint8_t words[BECH32_MAX_LENGTH];
+    size_t hrp_len, nwords;
+    uint32_t residue;
+    Bech32Variant variant;
+    if (!decode_raw(address, hrp, hrp_len, words, nwords, residue) || !residue_variant(residue, variant))
+        return AddressStatus::BadEncoding;
+    if (hrp_len != sizeof(QTC_ADDRESS_HRP) - 1 || std::memcmp(hrp, QTC_ADDRESS_HRP, hrp_len) != 0)
+        return AddressStatus::WrongHrp;
+    if (nwords == 0 || words[0] != QTC_WITNESS_VERSION) return AddressStatus::WrongWitnessVersion;
+    if (variant != Bech32Variant::Bech32) return AddressStatus::WrongVariant;
+    if (nwords - 1 != (QTC_WITNESS_PROGRAM_BYTES * 8 + 4) / 5) return AddressStatus::BadProgram;
+
+    // 32 words are exactly 20 bytes, so there is no padding to check
+    for (int i = 0; i < QTC_WITNESS_PROGRAM_BYTES; i += 5) {
+        const uint8_t* w = words + 1 + (i / 5) * 8;
+        uint64_t acc = 0;
+        for (int j = 0; j < 8; ++j) acc = (acc << 5) | w[j];
+        for (int j = 0; j < 5; ++j) program[i + j] = (uint8_t)(acc >> (32 - 8 * j));
+    }
+    return AddressStatus::Ok;
+}
+
+size_t qtc_address_validate_many(uint8_t* programs, AddressStatus* status,
+                                  const std::string* addresses, size_t n) {
+    size_t valid = 0;
+    for (size_t i = 0; i < n; ++i) {
+        status[i] = qtc_address_decode(programs + i * QTC_WITNESS_PROGRAM_BYTES, addresses[i]);
+        if (status[i] == AddressStatus::Ok) valid++;
+    }
+    return valid;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Checksum constant of the two bech32 variants (BIP-173, BIP-350)
+enum class Bech32Variant : uint32_t {
+    Bech32 = 1,
+    Bech32m = 0x2bc830a3
+};
+
+// Encodes 5-bit data words under hrp
+std::string bech32_encode(const std::string& hrp, const std::vector<uint8_t>& data, Bech32Variant variant);
+
+// Splits s into a lower-case hrp and 5-bit data words and checks the
+// checksum. Returns false for anything that is not valid bech32 or bech32m.
+bool bech32_decode(const std::string& s, std::string& hrp, std::vector<uint8_t>& data, Bech32Variant& variant);
+
+// QTC address of a witness program: witness version 2 under "qtc". Like
+// bech32.encode() in qti3_hd.js this uses the original bech32 checksum.
+#define QTC_ADDRESS_HRP "qtc"
+#define QTC_WITNESS_VERSION 2
+#define QTC_WITNESS_PROGRAM_BYTES 20
+#define QTC_ADDRESS_CHARS 43          // "qtc1", version, 32 program words, 6 checksum
+std::string qtc_address(const uint8_t* program, size_t len);
+
+// Addresses of n consecutive 20-byte programs
+void qtc_address_encode_many(std::vector<std::string>& out, const uint8_t* programs, size_t n);
+
+enum class AddressStatus {
+    Ok,
+    BadEncoding,          // not bech32: length, case, separator, charset or checksum
+    WrongHrp,
+    WrongVariant,         // bech32m checksum; QTC addresses use bech32
+    WrongWitnessVersion,
+    BadProgram            // program is not 20 bytes
+};
+
+const char* address_status_string(AddressStatus s);
+
+// Checks a QTC address and extracts its witness program
+AddressStatus qtc_address_decode(uint8_t program[QTC_WITNESS_PROGRAM_BYTES], const std::string& address);
+
+// Checks n addresses, writing n programs and statuses; returns the number valid
+size_t qtc_address_validate_many(uint8_t* programs, AddressStatus* status,
+                                  const std::string* addresses, size_t n);
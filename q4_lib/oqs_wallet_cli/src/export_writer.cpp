@@ -0,0 +1,204 @@
+#include "export_writer.h"
+#include "json_emit.h"
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#define EXPORT_JSON_RECORD_PREFIX "    {"
+#define EXPORT_JSONL_RECORD_PREFIX "{"
+
+ExportFormat export_format_from_string(const std::string& name) {
+    if (name == "json") return ExportFormat::Json;
+    if (name == "jsonl") return ExportFormat::Jsonl;
+    throw std::runtime_error("unknown export format " + name + " (json, jsonl)");
+}
+
+// The master object on a single line; JSON strings cannot hold raw newlines
+static std::string one_line(const std::string& json) {
+    std::string s;
+    s.reserve(json.size());
+    for (char c : json) s.push_back(c == '\n' || c == '\r' ? ' ' : c);
+    size_t b = s.find_first_not_of(" \t"), e = s.find_last_not_of(" \t");
+    if (b == std::string::npos || s[b] != '{' || s[e] != '}')
+        throw std::runtime_error("master must be a JSON object");
+    return s.substr(b, e - b + 1);
+}
+
+static const std::vector<std::string> wallet_fields = {
+    json_pair("wallet_type", "QTC-PQHD-HD"),
+    json_pair("version", "QTC-PQHD-2.0"),
+    json_pair("algorithm", "Kyber1024-KEM + Dilithium3-DSA (Deterministic PQ-HD HD)"),
+    json_pair("quantum_safe", "true", false),
+    json_pair("witness_version", "2", false)
+};
+
+static std::string params_json(const ExportParams& p) {
+    return json_obj({
+        json_pair("account", std::to_string(p.account), false),
+        json_pair("change", std::to_string(p.change), false),
+        json_pair("rng_mode", rng_mode_string(p.mode)),
+        json_pair("watch_only", p.watch_only ? "true" : "false", false),
+        json_pair("pct", p.pct ? "true" : "false", false)
+    });
+}
+
+ExportWriter::ExportWriter(const std::string& file, ExportFormat format, const std::string& master_json,
+                           const ExportParams& params, size_t buffer_bytes)
+    : file_(file), partial_(file + ".partial"), format_(format),
+      arena_(buffer_bytes ? buffer_bytes : 1, 1), buf_((char*)arena_.acquire()), buf_size_(arena_.slot_size()) {
+    std::string master = one_line(master_json);
+    std::string header;
+    if (format_ == ExportFormat::Json) {
+        header = "{\n";
+        for (const auto& f : wallet_fields) header += "  " + f + ",\n";
+        header += "  " + json_pair("export", params_json(params), false) + ",\n";
+        header += "  \"master\": " + master + ",\n  \"addresses\": [\n";
+    } else {
+        std::vector<std::string> fields(wallet_fields);
+        fields.push_back(json_pair("export", params_json(params), false));
+        fields.push_back("\"master\": " + master);
+        header = json_obj(fields) + "\n";
+    }
+    resume(header);
+}
+
+ExportWriter::~ExportWriter() {
+    if (f_) {
+        try { flush(); } catch (...) {}
+        std::fclose(f_);
+    }
+    arena_.release((uint8_t*)buf_);
+}
+
+// Opens .partial, keeping the complete records of an earlier run with the
+// same header and cutting off whatever followed them
+void ExportWriter::resume(const std::string& header) {
+    FILE* in = std::fopen(partial_.c_str(), "rb");
+    if (!in) {
+        f_ = std::fopen(partial_.c_str(), "wb");
+        if (!f_) throw std::runtime_error("cannot write " + partial_);
+        std::setvbuf(f_, nullptr, _IONBF, 0);
+        put(header.data(), header.size());
+        return;
+    }
+
+    std::string head(header.size(), '\0');
+    bool same = std::fread(&head[0], 1, head.size(), in) == head.size() && head == header;
+    if (!same) {
+        std::fclose(in);
+        throw std::runtime_error(partial_ + " belongs to another export (format, master, account, change, "
+                                 "rng mode or key options differ); remove it to start over");
+    }
+
+    // A complete record is a line that starts with the record prefix and ends
+    // in "," (Json, the separator before the next record) or "}" (Jsonl)
+    const char* prefix = format_ == ExportFormat::Json ? EXPORT_JSON_RECORD_PREFIX : EXPORT_JSONL_RECORD_PREFIX;
+    size_t prefix_len = std::strlen(prefix);
+    char end = format_ == ExportFormat::Json ? ',' : '}';
+    uint64_t cut = header.size(), offset = header.size(), line_len = 0;
+    bool prefix_ok = true, done = false;
+    char prev = 0;
+    while (!done) {
+        size_t n = std::fread(buf_, 1, buf_size_, in);
+        if (n == 0) break;
+        for (size_t i = 0; i < n && !done; ++i, ++offset) {
+            char c = buf_[i];
+            if (c != '\n') {
+                if (line_len < prefix_len && c != prefix[line_len]) prefix_ok = false;
+                line_len++;
+                prev = c;
+                continue;
+            }
+            if (!prefix_ok || line_len <= prefix_len || prev != end) {
+                done = true;
+                break;
+            }
+            records_++;
+            cut = offset + 1;
+            line_len = 0;
+            prefix_ok = true;
+        }
+    }
+    std::fclose(in);
+
+    std::filesystem::resize_file(partial_, cut);
+    f_ = std::fopen(partial_.c_str(), "ab");
+    if (!f_) throw std::runtime_error("cannot write " + partial_);
+    std::setvbuf(f_, nullptr, _IONBF, 0);
+    resumed_ = true;
+    trailing_separator_ = format_ == ExportFormat::Json && records_ > 0;
+}
+
+void ExportWriter::write_record(const std::string& record) {
+    write_record(record.data(), record.size());
+}
+
+void ExportWriter::write_record(const char* record, size_t len) {
+    if (!f_) throw std::runtime_error("export already finished");
+    if (format_ == ExportFormat::Json) {
+        if (pending_separator_) put(",\n", 2);
+        put("    ", 4);
+        put(record, len);
+        pending_separator_ = true;
+        trailing_separator_ = false;
+    } else {
+        put(record, len);
+        put("\n", 1);
+    }
+    records_++;
+}
+
+void ExportWriter::finish() {
+    if (!f_) throw std::runtime_error("export already finished");
+    if (format_ == ExportFormat::Json) {
+        // A rerun that had nothing left to add still has the ",\n" after the
+        // last resumed record; the array must end without it
+        if (trailing_separator_) {
+            flush();
+            std::filesystem::resize_file(partial_, std::filesystem::file_size(partial_) - 2);
+            trailing_separator_ = false;
+            pending_separator_ = true;
+        }
+        std::string trailer = pending_separator_ ? "\n" : "";
+        trailer += "  ],\n  " + json_pair("total_addresses", std::to_string(records_), false) + ",\n  " +
+                   json_pair("derivation_method", "SHA3-512 hierarchical derivation") + ",\n  " +
+                   json_pair("description", "QTC PQ-HD Hierarchical Deterministic Wallet for External Integration") +
+                   "\n}\n";
+        put(trailer.data(), trailer.size());
+    }
+    flush();
+
+#ifdef _WIN32
+    bool ok = _commit(_fileno(f_)) == 0;
+#else
+    bool ok = fsync(fileno(f_)) == 0;
+#endif
+    ok = (std::fclose(f_) == 0) && ok;
+    f_ = nullptr;
+    if (!ok) throw std::runtime_error("cannot write " + partial_);
+    std::filesystem::rename(partial_, file_);
+}
+
+void ExportWriter::put(const char* data, size_t len) {
+    if (used_ + len > buf_size_) flush();
+    if (len > buf_size_) {
+        if (std::fwrite(data, 1, len, f_) != len) throw std::runtime_error("cannot write " + partial_);
+        return;
+    }
+    std::memcpy(buf_ + used_, data, len);
+    used_ += len;
+}
+
+// Hands the buffer to the OS, so records survive if the process is killed
+void ExportWriter::flush() {
+    if (used_ && std::fwrite(buf_, 1, used_, f_) != used_)
+        throw std::runtime_error("cannot write " + partial_);
+    used_ = 0;
+    if (std::fflush(f_) != 0) throw std::runtime_error("cannot write " + partial_);
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include "secure_arena.h"
+#include "rng_deterministic.h"
+
+// Streaming wallet export. Records are appended to <file>.partial through a
+// bounded buffer as they are derived, so memory stays constant however many
+// addresses are exported. finish() writes the trailer, syncs the file and
+// renames it to <file>.
+//
+// Every complete record ends in a newline. Opening an export whose .partial
+// file exists with the same header resumes it: the file is cut after the
+// last newline and next_index() tells the caller where to continue. The
+// header holds the derivation parameters, so a .partial written with another
+// account, change, RNG mode or key options is never resumed.
+//
+// Records carry secret keys, so the buffer is a locked SecureArena slot and
+// the FILE is unbuffered: stdio keeps no copy of its own.
+
+enum class ExportFormat {
+    Json,    // the exportWallet() schema of qti3_hd.js, one address per line
+    Jsonl    // a header line with the wallet fields, then one line per address
+};
+
+ExportFormat export_format_from_string(const std::string& name);
+
+// How the records were derived; written to the header as the "export" object
+struct ExportParams {
+    uint32_t account = 0;
+    uint32_t change = 0;
+    RngMode mode = RngMode::NistKat;
+    bool watch_only = false;           // records carry no secret keys
+    bool pct = false;                  // keys passed a pairwise consistency test
+};
+
+class ExportWriter {
+public:
+    // master_json is the "master" object, embedded as given on one line
+    ExportWriter(const std::string& file, ExportFormat format, const std::string& master_json,
+                 const ExportParams& params, size_t buffer_bytes = 1 << 20);
+    ~ExportWriter();
+    ExportWriter(const ExportWriter&) = delete;
+    ExportWriter& operator=(const ExportWriter&) = delete;
+
+    // Records already in the file; the next record has this index
+    uint64_t next_index() const { return records_; }
+    bool resumed() const { return resumed_; }
+    bool buffer_locked() const { return arena_.locked(); }
+
+    // Appends one address object, a single-line JSON object
+    void write_record(const std::string& record);
+    void write_record(const char* record, size_t len);
+    void finish();
+
+private:
+    void put(const char* data, size_t len);
+    void flush();
+    void resume(const std::string& header);
+
+    std::string file_, partial_;
+    ExportFormat format_;
+    FILE* f_ = nullptr;
+    SecureArena arena_;
+    char* buf_;
+    size_t buf_size_;
+    size_t used_ = 0;
+    uint64_t records_ = 0;
+    bool resumed_ = false;
+    bool pending_separator_ = false;   // Json: a record is open without its ",\n"
+    bool trailing_separator_ = false;  // Json: resumed file ends in ",\n", no record written since
+};
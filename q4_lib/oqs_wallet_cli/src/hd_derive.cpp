@@ -0,0 +1,68 @@
+#include "hd_derive.h"
+#include "bech32.h"
+#include <cstring>
+#include <string>
+#include <stdexcept>
+#include <oqs/rand.h>
+#include <oqs/common.h>
+extern "C" {
+#include "../../fips202/fips202.h"
+}
+
+// Dilithium3 reference code, linked for its public-key-only keygen and the
+// keygen with consistency test. Its other entry points draw from
+// randombytes(), served by liboqs here.
+extern "C" int pqcrystals_dilithium3_ref_keypair_pk(uint8_t* pk, const uint8_t* seed);
+extern "C" int pqcrystals_dilithium3_ref_keypair_pct(uint8_t* pk, uint8_t* sk, const uint8_t* seed);
+extern "C" void randombytes(uint8_t* out, size_t outlen) {
+    OQS_randombytes(out, outlen);
+}
+
+void hd_child_entropy(uint8_t out[64], const std::vector<uint8_t>& master_entropy, const HdPath& path) {
+    std::string p = hd_path_to_string(path);
+    std::vector<uint8_t> data(master_entropy);
+    data.insert(data.end(), p.begin(), p.end());
+    data.push_back((uint8_t)(path.index >> 24));
+    data.push_back((uint8_t)(path.index >> 16));
+    data.push_back((uint8_t)(path.index >> 8));
+    data.push_back((uint8_t)path.index);
+    sha3_512(out, data.data(), data.size());
+    OQS_MEM_cleanse(data.data(), data.size());
+}
+
+void mldsa65_public_key_from_seed(uint8_t pk[QTC_MLDSA65_PUBLICKEYBYTES],
+                                  const std::vector<uint8_t>& seed, RngMode mode) {
+    uint8_t zeta[32];
+    deterministic_prefix(zeta, sizeof(zeta), seed, "dilithium_keygen", mode);
+    pqcrystals_dilithium3_ref_keypair_pk(pk, zeta);
+    OQS_MEM_cleanse(zeta, sizeof(zeta));
+}
+
+bool mldsa65_keypair_from_seed_pct(uint8_t pk[QTC_MLDSA65_PUBLICKEYBYTES], uint8_t sk[QTC_MLDSA65_SECRETKEYBYTES],
+                                   const std::vector<uint8_t>& seed, RngMode mode) {
+    uint8_t zeta[32];
+    deterministic_prefix(zeta, sizeof(zeta), seed, "dilithium_keygen", mode);
+    int r = pqcrystals_dilithium3_ref_keypair_pct(pk, sk, zeta);
+    OQS_MEM_cleanse(zeta, sizeof(zeta));
+    return r == 0;
+}
+
+void hd_derive_address(DerivedAddress& out, const std::vector<uint8_t>& master_entropy,
+                       const HdPath& path, RngMode mode) {
+    uint8_t entropy[64];
+    uint8_t pk[QTC_MLDSA65_PUBLICKEYBYTES];
+
+    // QTCHDNode.generateKeyPair() seeds keygen with the first 32 bytes
+    hd_child_entropy(entropy, master_entropy, path);
+    std::vector<uint8_t> seed(entropy, entropy + 32);
+    OQS_MEM_cleanse(entropy, sizeof(entropy));
+    mldsa65_public_key_from_seed(pk, seed, mode);
+    OQS_MEM_cleanse(seed.data(), seed.size());
+
+    out.path = path;
+    witness_program(out.program, pk, sizeof(pk));
+    std::string address = qtc_address(out.program, sizeof(out.program));
+    if (address.size() >= sizeof(out.address)) throw std::runtime_error("address too long");
+    std::memset(out.address, 0, sizeof(out.address));
+    std::memcpy(out.address, address.data(), address.size());
+}
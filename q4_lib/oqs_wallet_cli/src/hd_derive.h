@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "rng_deterministic.h"
+#include "keystore.h"
+#include "addr_index.h"
+
+// Native counterpart of QTCHDNode.deriveChild() and generateAddress() in
+// qti3_hd.js, computing public keys only
+
+#define QTC_MLDSA65_PUBLICKEYBYTES 1952
+#define QTC_MLDSA65_SECRETKEYBYTES 4032
+#define QTC_ADDRESS_MAX_BYTES 64
+
+struct DerivedAddress {
+    HdPath path;
+    uint8_t program[QTC_WITNESS_PROGRAM_BYTES];
+    char address[QTC_ADDRESS_MAX_BYTES];
+};
+
+// SHA3-512(master_entropy || "m/purpose'/account'/change/index" || index as big-endian u32)
+void hd_child_entropy(uint8_t out[64], const std::vector<uint8_t>& master_entropy, const HdPath& path);
+
+// Public key gen_dilithium_from_seed returns for seed; the secret key is never formed
+void mldsa65_public_key_from_seed(uint8_t pk[QTC_MLDSA65_PUBLICKEYBYTES],
+                                  const std::vector<uint8_t>& seed, RngMode mode);
+
+// Key pair gen_dilithium_from_seed returns for seed, generated together with a
+// sign/verify pairwise consistency test on the keygen state. Returns false,
+// with pk and sk zeroed, if the test fails. Safe to call from several threads.
+bool mldsa65_keypair_from_seed_pct(uint8_t pk[QTC_MLDSA65_PUBLICKEYBYTES], uint8_t sk[QTC_MLDSA65_SECRETKEYBYTES],
+                                   const std::vector<uint8_t>& seed, RngMode mode);
+
+// Address of the child at path; safe to call from several threads
+void hd_derive_address(DerivedAddress& out, const std::vector<uint8_t>& master_entropy,
+                       const HdPath& path, RngMode mode);
@@ -1,21 +1,62 @@
 #include "json_emit.h"
 #include <vector>
 #include <string>
+#include <stdexcept>
 
 static const char b64_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-std::string b64_encode(const uint8_t* data, size_t len) {
-    std::string out;
-    out.reserve(((len + 2) / 3) * 4);
+size_t b64_encode_to(char* out, const uint8_t* data, size_t len) {
+    char* o = out;
     for (size_t i = 0; i < len; i += 3) {
         uint32_t v = data[i] << 16;
         if (i + 1 < len) v |= data[i+1] << 8;
         if (i + 2 < len) v |= data[i+2];
-        out.push_back(b64_table[(v >> 18) & 0x3F]);
-        out.push_back(b64_table[(v >> 12) & 0x3F]);
-        out.push_back(i + 1 < len ? b64_table[(v >> 6) & 0x3F] : '=');
-        out.push_back(i + 2 < len ? b64_table[v & 0x3F] : '=');
+        *o++ = b64_table[(v >> 18) & 0x3F];
+        *o++ = b64_table[(v >> 12) & 0x3F];
+        *o++ = i + 1 < len ? b64_table[(v >> 6) & 0x3F] : '=';
+        *o++ = i + 2 < len ? b64_table[v & 0x3F] : '=';
+    }
+    return (size_t)(o - out);
+}
+
+std::string b64_encode(const uint8_t* data, size_t len) {
+    std::string out(b64_encoded_len(len), '\0');
+    b64_encode_to(&out[0], data, len);
+    return out;
+}
+
+size_t b64_decode_to(uint8_t* out, size_t cap, const char* in, size_t len) {
+    auto val = [](char c)->int {
+        if (c>='A'&&c<='Z') return c-'A';
+        if (c>='a'&&c<='z') return c-'a'+26;
+        if (c>='0'&&c<='9') return c-'0'+52;
+        if (c=='+') return 62;
+        if (c=='/') return 63;
+        return -1;
+    };
+    size_t n = len;
+    while (n > 0 && in[n-1] == '=') --n;
+    if (n%4 == 1 || len%4) throw std::runtime_error("invalid base64");
+    if (n*3/4 > cap) throw std::runtime_error("base64 value too long");
+    size_t o = 0;
+    uint32_t acc = 0;
+    int bits = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int v = val(in[i]);
+        if (v < 0) throw std::runtime_error("invalid base64");
+        acc = (acc << 6) | (uint32_t)v;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out[o++] = (uint8_t)(acc >> bits);
+        }
     }
+    return o;
+}
+
+std::vector<uint8_t> b64_decode(const std::string& in) {
+    std::vector<uint8_t> out(in.size()/4*3);
+    out.resize(b64_decode_to(out.data(), out.size(), in.data(), in.size()));
     return out;
 }
 
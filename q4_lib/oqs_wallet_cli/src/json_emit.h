@@ -4,5 +4,12 @@
 #include <cstdint>
 
 std::string b64_encode(const uint8_t* data, size_t len);
+// Encodes into out, which must hold b64_encoded_len(len) bytes; returns that length
+size_t b64_encode_to(char* out, const uint8_t* data, size_t len);
+inline size_t b64_encoded_len(size_t len) { return ((len + 2) / 3) * 4; }
+std::vector<uint8_t> b64_decode(const std::string& in);
+// Decodes len characters into out, which holds cap bytes; returns the decoded
+// length. Throws for invalid base64 or if out is too small.
+size_t b64_decode_to(uint8_t* out, size_t cap, const char* in, size_t len);
 std::string json_pair(const std::string& k, const std::string& v, bool quote=true);
 std::string json_obj(const std::vector<std::string>& pairs);
\ No newline at end of file
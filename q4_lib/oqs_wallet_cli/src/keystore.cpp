@@ -0,0 +1,220 @@
+#include "keystore.h"
+#include <cstring>
+#include <stdexcept>
+#include <regex>
+
+#define KS_MAGIC "QTCKSTR"
+#define KS_VERSION 1
+#define KS_PAGE 4096u
+#define KS_SLOT_HEADER 128u
+
+struct Keystore::Header {
+    char magic[8];
+    le32 version;
+    le32 page_bytes;
+    le32 pk_bytes;
+    le32 sk_bytes;
+    le32 slot_bytes;
+    le32 reserved;
+    le64 index_offset;
+    le64 index_capacity;   // entries, power of two
+    le64 count;
+    le64 end;              // first free byte, page aligned
+};
+
+struct DiskPath {
+    le32 purpose, account, change, index;
+
+    DiskPath& operator=(const HdPath& p) {
+        purpose = p.purpose;
+        account = p.account;
+        change = p.change;
+        index = p.index;
+        return *this;
+    }
+    operator HdPath() const { return HdPath{purpose, account, change, index}; }
+};
+
+// slot == 0 marks an empty entry (offset 0 is the header)
+struct IndexEntry {
+    DiskPath path;
+    le64 slot;
+};
+
+struct SlotHeader {
+    DiskPath path;
+    le32 pk_len;
+    le32 sk_len;
+    uint8_t reserved[KS_SLOT_HEADER - 24 - QTC_KEYSTORE_ADDRESS_BYTES];
+    char address[QTC_KEYSTORE_ADDRESS_BYTES];
+};
+
+static_assert(sizeof(IndexEntry) == 24, "index entry layout");
+static_assert(sizeof(SlotHeader) == KS_SLOT_HEADER, "slot header layout");
+
+static uint64_t page_round(uint64_t n) {
+    return (n + KS_PAGE - 1) & ~(uint64_t)(KS_PAGE - 1);
+}
+
+static bool path_eq(const HdPath& a, const HdPath& b) {
+    return a.purpose == b.purpose && a.account == b.account &&
+           a.change == b.change && a.index == b.index;
+}
+
+static uint64_t path_hash(const HdPath& p) {
+    uint64_t h = ((uint64_t)p.purpose << 32 | p.account) * 0x9e3779b97f4a7c15ULL;
+    h ^= ((uint64_t)p.change << 32 | p.index) + 0x7f4a7c159e3779b9ULL + (h << 6) + (h >> 2);
+    h ^= h >> 31;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 29;
+    return h;
+}
+
+// Returns the entry holding path, or the empty entry where it would go.
+// A table without either is corrupt: put() never fills it beyond 3/4.
+static IndexEntry* index_probe(IndexEntry* index, uint64_t capacity, const HdPath& path) {
+    uint64_t mask = capacity - 1;
+    uint64_t i = path_hash(path) & mask;
+    for (uint64_t n = 0; n < capacity; ++n, i = (i + 1) & mask) {
+        if (index[i].slot == 0 || path_eq(index[i].path, path)) return &index[i];
+    }
+    throw std::runtime_error("corrupt keystore index: no free entry");
+}
+
+HdPath hd_path_from_string(const std::string& s) {
+    static const std::regex re("^m/(\\d+)'/(\\d+)'/(\\d+)/(\\d+)$");
+    std::smatch m;
+    if (!std::regex_match(s, m, re)) throw std::runtime_error("invalid HD path format");
+    auto num = [](const std::string& v)->uint32_t {
+        unsigned long long n = std::stoull(v);
+        if (n > 0x7fffffffULL) throw std::runtime_error("HD path component out of range");
+        return (uint32_t)n;
+    };
+    return HdPath{num(m[1]), num(m[2]), num(m[3]), num(m[4])};
+}
+
+std::string hd_path_to_string(const HdPath& p) {
+    return "m/" + std::to_string(p.purpose) + "'/" + std::to_string(p.account) + "'/" +
+           std::to_string(p.change) + "/" + std::to_string(p.index);
+}
+
+Keystore Keystore::create(const std::string& file, uint32_t pk_bytes, uint32_t sk_bytes,
+                          uint64_t expected) {
+    uint64_t capacity = 16;
+    while (capacity * 3 < expected * 4) capacity *= 2;
+    uint64_t slot_bytes = page_round(KS_SLOT_HEADER + (uint64_t)pk_bytes + sk_bytes);
+    uint64_t index_bytes = page_round(capacity * sizeof(IndexEntry));
+    if (slot_bytes > 0xffffffffULL) throw std::runtime_error("keystore key sizes too large");
+
+    Keystore ks(MappedFile(file, true, true, KS_PAGE + index_bytes));
+
+    Header* h = ks.hdr();
+    std::memcpy(h->magic, KS_MAGIC, sizeof(h->magic));
+    h->version = KS_VERSION;
+    h->page_bytes = KS_PAGE;
+    h->pk_bytes = pk_bytes;
+    h->sk_bytes = sk_bytes;
+    h->slot_bytes = (uint32_t)slot_bytes;
+    h->index_offset = KS_PAGE;
+    h->index_capacity = capacity;
+    h->count = 0;
+    h->end = KS_PAGE + index_bytes;
+    return ks;
+}
+
+Keystore::Keystore(const std::string& file, bool writable) : file_(file, writable, false) {
+    uint64_t size = file_.size();
+    if (size < KS_PAGE) throw std::runtime_error("not a keystore: " + file);
+    const Header* h = hdr();
+    if (std::memcmp(h->magic, KS_MAGIC, sizeof(h->magic)) != 0 || h->version != KS_VERSION ||
+        h->page_bytes != KS_PAGE)
+        throw std::runtime_error("not a keystore: " + file);
+    uint64_t cap = h->index_capacity;
+    if (cap == 0 || (cap & (cap - 1)) || h->index_offset % KS_PAGE ||
+        h->index_offset + cap * sizeof(IndexEntry) > h->end || h->end > size ||
+        h->slot_bytes < KS_SLOT_HEADER + (uint64_t)h->pk_bytes + h->sk_bytes)
+        throw std::runtime_error("corrupt keystore: " + file);
+}
+
+// Drops the preallocated tail so the file ends at the last record
+Keystore::~Keystore() {
+    if (file_.data()) file_.close(hdr()->end);
+}
+
+void Keystore::grow_index() {
+    uint64_t capacity = hdr()->index_capacity * 2;
+    uint64_t bytes = page_round(capacity * sizeof(IndexEntry));
+    uint64_t offset = hdr()->end;
+    file_.grow(offset + bytes);
+
+    Header* h = hdr();
+    IndexEntry* old_index = reinterpret_cast<IndexEntry*>(file_.data() + h->index_offset);
+    IndexEntry* index = reinterpret_cast<IndexEntry*>(file_.data() + offset);
+    std::memset(index, 0, bytes);
+    for (uint64_t i = 0; i < h->index_capacity; ++i) {
+        if (old_index[i].slot) *index_probe(index, capacity, old_index[i].path) = old_index[i];
+    }
+    h->end = offset + bytes;
+    h->index_capacity = capacity;
+    h->index_offset = offset;
+}
+
+void Keystore::put(const HdPath& path, const std::string& address,
+                   const uint8_t* pk, size_t pk_len, const uint8_t* sk, size_t sk_len) {
+    if (!file_.writable()) throw std::runtime_error("keystore opened read-only");
+    if (pk_len > hdr()->pk_bytes || sk_len > hdr()->sk_bytes)
+        throw std::runtime_error("key larger than keystore slot");
+    if (address.size() >= QTC_KEYSTORE_ADDRESS_BYTES)
+        throw std::runtime_error("address too long for keystore slot");
+
+    if ((hdr()->count + 1) * 4 > hdr()->index_capacity * 3) grow_index();
+    file_.grow(hdr()->end + hdr()->slot_bytes);
+
+    Header* h = hdr();
+    IndexEntry* e = index_probe(reinterpret_cast<IndexEntry*>(file_.data() + h->index_offset),
+                                h->index_capacity, path);
+    if (e->slot) throw std::runtime_error("keystore already holds " + hd_path_to_string(path));
+
+    uint64_t off = h->end;
+    uint8_t* slot = file_.data() + off;
+    std::memset(slot, 0, h->slot_bytes);
+    SlotHeader* s = reinterpret_cast<SlotHeader*>(slot);
+    s->path = path;
+    s->pk_len = (uint32_t)pk_len;
+    s->sk_len = (uint32_t)sk_len;
+    std::memcpy(s->address, address.data(), address.size());
+    std::memcpy(slot + KS_SLOT_HEADER, pk, pk_len);
+    std::memcpy(slot + KS_SLOT_HEADER + h->pk_bytes, sk, sk_len);
+
+    // Slot first, then its index entry, then the counters; get() ignores slots past end
+    e->path = path;
+    e->slot = off;
+    h->end = off + h->slot_bytes;
+    h->count = h->count + 1;
+}
+
+bool Keystore::get(const HdPath& path, Record& rec) const {
+    const Header* h = hdr();
+    const IndexEntry* e = index_probe(reinterpret_cast<IndexEntry*>(file_.data() + h->index_offset),
+                                      h->index_capacity, path);
+    if (!e->slot || e->slot + h->slot_bytes > h->end) return false;
+
+    const uint8_t* slot = file_.data() + e->slot;
+    const SlotHeader* s = reinterpret_cast<const SlotHeader*>(slot);
+    if (!path_eq(s->path, path) || s->pk_len > h->pk_bytes || s->sk_len > h->sk_bytes ||
+        s->address[QTC_KEYSTORE_ADDRESS_BYTES - 1] != 0)
+        throw std::runtime_error("corrupt keystore slot for " + hd_path_to_string(path));
+
+    rec.path = s->path;
+    rec.address = s->address;
+    rec.pk = slot + KS_SLOT_HEADER;
+    rec.pk_len = s->pk_len;
+    rec.sk = slot + KS_SLOT_HEADER + h->pk_bytes;
+    rec.sk_len = s->sk_len;
+    return true;
+}
+
+uint64_t Keystore::count() const { return hdr()->count; }
+uint32_t Keystore::pk_bytes() const { return hdr()->pk_bytes; }
+uint32_t Keystore::sk_bytes() const { return hdr()->sk_bytes; }
+uint32_t Keystore::slot_bytes() const { return hdr()->slot_bytes; }
@@ -0,0 +1,71 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include "mapped_file.h"
+
+// Memory-mapped binary keystore for HD wallets.
+//
+// Layout (all integers little-endian, every region page aligned):
+//   page 0        header (magic, version, key sizes, index location, counters)
+//   index         open-addressing hash table of (derivation path -> slot offset)
+//   slots         one fixed-size, page-aligned record per derived key
+//
+// Lookups hash the path and probe the mapped index, so opening a store costs
+// one mmap and finding a key touches one index line and one slot. Appends
+// write a new slot past the end and fill one index entry; when the index
+// reaches 3/4 load a table twice the size is appended at the end of the file
+// and the header is pointed at it. Existing slots are never moved or rewritten.
+
+struct HdPath {
+    uint32_t purpose, account, change, index;
+};
+
+// Parses and formats m/purpose'/account'/change/index, as QTCHDPath does
+HdPath hd_path_from_string(const std::string& s);
+std::string hd_path_to_string(const HdPath& p);
+
+#define QTC_KEYSTORE_ADDRESS_BYTES 96
+
+class Keystore {
+public:
+    struct Record {
+        HdPath path;
+        const char* address;
+        const uint8_t* pk;
+        size_t pk_len;
+        const uint8_t* sk;
+        size_t sk_len;
+    };
+
+    // Creates an empty store sized for expected records; fails if file exists
+    static Keystore create(const std::string& file, uint32_t pk_bytes, uint32_t sk_bytes,
+                           uint64_t expected = 1024);
+    Keystore(const std::string& file, bool writable);
+    Keystore(Keystore&&) = default;
+    Keystore(const Keystore&) = delete;
+    Keystore& operator=(const Keystore&) = delete;
+    ~Keystore();
+
+    // Appends a record; throws if the path is already present
+    void put(const HdPath& path, const std::string& address,
+             const uint8_t* pk, size_t pk_len, const uint8_t* sk, size_t sk_len);
+    // Pointers in rec stay valid until the next put()
+    bool get(const HdPath& path, Record& rec) const;
+
+    uint64_t count() const;
+    uint32_t pk_bytes() const;
+    uint32_t sk_bytes() const;
+    uint32_t slot_bytes() const;
+    void sync() { file_.sync(); }
+
+private:
+    explicit Keystore(MappedFile&& file) : file_(std::move(file)) {}
+    void grow_index();
+
+    struct Header;
+    Header* hdr() const { return reinterpret_cast<Header*>(file_.data()); }
+
+    MappedFile file_;
+};
@@ -3,7 +3,16 @@
 #include <string>
 #include <stdexcept>
 #include <cstring>
+#include <cctype>
 #include <cstdlib>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 #include <oqs/kem.h>
 #include <oqs/sig.h>
@@ -11,6 +20,14 @@
 
 #include "rng_deterministic.h"
 #include "json_emit.h"
+#include "keystore.h"
+#include "addr_index.h"
+#include "bech32.h"
+#include "hd_derive.h"
+#include "addr_pool.h"
+#include "export_writer.h"
+#include "wallet_audit.h"
+#include "secure_arena.h"
 
 // Hex decode
 static std::vector<uint8_t> hex2bin(const std::string& hex) {
@@ -31,6 +48,16 @@ static std::vector<uint8_t> hex2bin(const std::string& hex) {
     return out;
 }
 
+static std::string bin2hex(const uint8_t* data, size_t len) {
+    static const char digits[] = "0123456789abcdef";
+    std::string out(len * 2, '0');
+    for (size_t i = 0; i < len; ++i) {
+        out[2*i] = digits[data[i] >> 4];
+        out[2*i+1] = digits[data[i] & 15];
+    }
+    return out;
+}
+
 // Try preferred ML-* names, fallback to legacy names
 static OQS_KEM* kem_new_any() {
     OQS_KEM* kem = OQS_KEM_new("ML-KEM-1024");
@@ -46,37 +73,104 @@ static OQS_SIG* sig_new_any() {
     return sig;
 }
 
+// Public-key-only derivation runs the ML-DSA reference code; it matches
+// sig_new_any() keys only when liboqs provides ML-DSA-65, not legacy Dilithium3
+static bool sig_is_mldsa65() {
+    OQS_SIG* sig = sig_new_any();
+    if (!sig) return false;
+    bool mldsa = std::string(sig->method_name) == "ML-DSA-65";
+    OQS_SIG_free(sig);
+    return mldsa;
+}
+
+// RNG used by the *_from_seed commands; kat keeps existing wallets stable
+static RngMode g_rng_mode = RngMode::NistKat;
+
 // Set deterministic RNG for a given domain; restore to system after op
 struct RngScope {
     std::string domain;
     RngScope(const std::vector<uint8_t>& seed, const std::string& dom) : domain(dom) {
-        auto s48 = shake256_expand_seed_48(seed, dom);
-        init_nist_kat_drbg_48(s48);
+        if (g_rng_mode == RngMode::Shake256V1) {
+            init_shake256_drbg_v1(seed, dom);
+        } else {
+            auto s48 = shake256_expand_seed_48(seed, dom);
+            init_nist_kat_drbg_48(s48);
+        }
     }
     ~RngScope() {
         OQS_randombytes_switch_algorithm(OQS_RAND_alg_system);
+        shake256_drbg_clear();
+    }
+};
+
+// A JSON object built in a secret slot, so encoded keys never pass through
+// heap strings; fields are joined as json_obj() joins them
+class SecretJson {
+public:
+    explicit SecretJson(const SecretSlot& slot) : slot_(slot) { put("{", 1); }
+    SecretJson& field(const std::string& pair) {
+        if (len_ > 1) put(", ", 2);
+        put(pair.data(), pair.size());
+        return *this;
+    }
+    SecretJson& b64(const std::string& key, const uint8_t* data, size_t len) {
+        field(json_pair(key, "", false));
+        put("\"", 1);
+        room(b64_encoded_len(len));
+        len_ += b64_encode_to(text() + len_, data, len);
+        put("\"", 1);
+        return *this;
+    }
+    const char* close() { put("}", 1); return text(); }
+    size_t size() const { return len_; }
+
+private:
+    char* text() const { return (char*)slot_.data(); }
+    void room(size_t n) const {
+        if (len_ + n > slot_.size()) throw std::runtime_error("secret JSON does not fit its slot");
     }
+    void put(const char* s, size_t n) {
+        room(n);
+        std::memcpy(text() + len_, s, n);
+        len_ += n;
+    }
+
+    const SecretSlot& slot_;
+    size_t len_ = 0;
 };
 
+// Slot size for a SecretJson holding raw_bytes of keys, base64-encoded
+static size_t secret_json_bytes(size_t raw_bytes) { return b64_encoded_len(raw_bytes) + 512; }
+
+// Unlocked secret memory still works; say so once
+static void warn_if_unlocked(bool locked) {
+    static bool warned = false;
+    if (locked || warned) return;
+    warned = true;
+    std::cerr << "warning: cannot lock secret memory (see ulimit -l); keys may be swapped out\n";
+}
+
 static int cmd_gen_kyber_from_seed(const std::string& seed_hex) {
     auto seed = hex2bin(seed_hex);
     RngScope scope(seed, "kyber_keygen");
     OQS_KEM* kem = kem_new_any();
     if (!kem) { std::cerr << "error: ML-KEM-1024 unavailable\n"; return 2; }
 
-    std::vector<uint8_t> pk(kem->length_public_key), sk(kem->length_secret_key);
+    SecureArena keys(kem->length_secret_key, 1);
+    SecureArena text(secret_json_bytes(kem->length_public_key + kem->length_secret_key), 1);
+    warn_if_unlocked(keys.locked() && text.locked());
+    std::vector<uint8_t> pk(kem->length_public_key);
+    SecretSlot sk(keys), buf(text);
     if (OQS_KEM_keypair(kem, pk.data(), sk.data()) != OQS_SUCCESS) {
         OQS_KEM_free(kem);
         std::cerr << "error: KEM keypair failed\n"; return 3;
     }
-    std::string pk_b64 = b64_encode(pk.data(), pk.size());
-    std::string sk_b64 = b64_encode(sk.data(), sk.size());
     OQS_KEM_free(kem);
 
-    std::cout << json_obj({
-        json_pair("kyber_public_b64", pk_b64),
-        json_pair("kyber_private_b64", sk_b64)
-    }) << "\n";
+    SecretJson json(buf);
+    json.b64("kyber_public_b64", pk.data(), pk.size()).b64("kyber_private_b64", sk.data(), sk.size());
+    const char* line = json.close();
+    std::cout.write(line, json.size()) << "\n";
     return 0;
 }
 
@@ -86,18 +180,38 @@ static int cmd_gen_dilithium_from_seed(const std::string& seed_hex) {
     OQS_SIG* sig = sig_new_any();
     if (!sig) { std::cerr << "error: ML-DSA-65 unavailable\n"; return 2; }
 
-    std::vector<uint8_t> pk(sig->length_public_key), sk(sig->length_secret_key);
+    SecureArena keys(sig->length_secret_key, 1);
+    SecureArena text(secret_json_bytes(sig->length_public_key + sig->length_secret_key), 1);
+    warn_if_unlocked(keys.locked() && text.locked());
+    std::vector<uint8_t> pk(sig->length_public_key);
+    SecretSlot sk(keys), buf(text);
     if (OQS_SIG_keypair(sig, pk.data(), sk.data()) != OQS_SUCCESS) {
         OQS_SIG_free(sig);
         std::cerr << "error: SIG keypair failed\n"; return 3;
     }
-    std::string pk_b64 = b64_encode(pk.data(), pk.size());
-    std::string sk_b64 = b64_encode(sk.data(), sk.size());
     OQS_SIG_free(sig);
 
+    SecretJson json(buf);
+    json.b64("dilithium_public_b64", pk.data(), pk.size()).b64("dilithium_private_b64", sk.data(), sk.size());
+    const char* line = json.close();
+    std::cout.write(line, json.size()) << "\n";
+    return 0;
+}
+
+// Public key and address of gen_dilithium_from_seed without materializing sk
+static int cmd_derive_address_only(const std::string& seed_hex) {
+    auto seed = hex2bin(seed_hex);
+    if (!sig_is_mldsa65()) { std::cerr << "error: liboqs lacks ML-DSA-65\n"; return 2; }
+
+    std::vector<uint8_t> pk(QTC_MLDSA65_PUBLICKEYBYTES);
+    mldsa65_public_key_from_seed(pk.data(), seed, g_rng_mode);
+    uint8_t program[QTC_WITNESS_PROGRAM_BYTES];
+    witness_program(program, pk.data(), pk.size());
+
     std::cout << json_obj({
-        json_pair("dilithium_public_b64", pk_b64),
-        json_pair("dilithium_private_b64", sk_b64)
+        json_pair("dilithium_public_b64", b64_encode(pk.data(), pk.size())),
+        json_pair("witness_program_hex", bin2hex(program, sizeof(program))),
+        json_pair("address", qtc_address(program, sizeof(program)))
     }) << "\n";
     return 0;
 }
@@ -108,44 +222,604 @@ static int cmd_kem_self_from_seed(const std::string& seed_hex) {
     OQS_KEM* kem = kem_new_any();
     if (!kem) { std::cerr << "error: ML-KEM-1024 unavailable\n"; return 2; }
 
-    std::vector<uint8_t> pk(kem->length_public_key), sk(kem->length_secret_key);
+    // Slots for sk and both shared secrets
+    SecureArena keys(std::max(kem->length_secret_key, kem->length_shared_secret), 3);
+    SecureArena text(secret_json_bytes(kem->length_public_key + kem->length_secret_key + kem->length_shared_secret), 1);
+    warn_if_unlocked(keys.locked() && text.locked());
+    std::vector<uint8_t> pk(kem->length_public_key);
+    SecretSlot sk(keys), ss(keys), ss2(keys), buf(text);
     if (OQS_KEM_keypair(kem, pk.data(), sk.data()) != OQS_SUCCESS) {
         OQS_KEM_free(kem);
         std::cerr << "error: KEM keypair failed\n"; return 3;
     }
-    std::vector<uint8_t> ct(kem->length_ciphertext), ss(kem->length_shared_secret);
+    std::vector<uint8_t> ct(kem->length_ciphertext);
     if (OQS_KEM_encaps(kem, ct.data(), ss.data(), pk.data()) != OQS_SUCCESS) {
         OQS_KEM_free(kem);
         std::cerr << "error: KEM encaps failed\n"; return 4;
     }
 
-    std::string pk_b64 = b64_encode(pk.data(), pk.size());
-    std::string sk_b64 = b64_encode(sk.data(), sk.size());
-    std::string ss_b64 = b64_encode(ss.data(), ss.size());
+    // Pairwise consistency: the new secret key must decapsulate to the same secret
+    size_t sk_len = kem->length_secret_key, ss_len = kem->length_shared_secret;
+    if (OQS_KEM_decaps(kem, ss2.data(), ct.data(), sk.data()) != OQS_SUCCESS ||
+        std::memcmp(ss2.data(), ss.data(), ss_len) != 0) {
+        OQS_KEM_free(kem);
+        std::cerr << "error: KEM decaps does not match encaps\n"; return 5;
+    }
     OQS_KEM_free(kem);
 
+    SecretJson json(buf);
+    json.b64("kyber_public_b64", pk.data(), pk.size())
+        .b64("kyber_private_b64", sk.data(), sk_len)
+        .b64("shared_b64", ss.data(), ss_len);
+    const char* line = json.close();
+    std::cout.write(line, json.size()) << "\n";
+    return 0;
+}
+
+// Time seeding and output of both deterministic RNGs through OQS_randombytes
+static int cmd_bench_rng() {
+    using clock = std::chrono::steady_clock;
+    const int ninit = 10000;
+    const size_t nbytes = 1 << 24;
+    std::vector<uint8_t> seed(32, 0x5a), buf(nbytes);
+    std::vector<std::string> pairs;
+
+    for (RngMode mode : {RngMode::NistKat, RngMode::Shake256V1}) {
+        g_rng_mode = mode;
+        const std::string name = (mode == RngMode::NistKat) ? "kat" : "shake256_v1";
+
+        auto t0 = clock::now();
+        for (int i = 0; i < ninit; ++i) {
+            seed[0] = (uint8_t)i;
+            RngScope scope(seed, "bench_rng");
+        }
+        auto t1 = clock::now();
+        {
+            RngScope scope(seed, "bench_rng");
+            t1 = clock::now();
+            OQS_randombytes(buf.data(), buf.size());
+        }
+        auto t2 = clock::now();
+
+        double init_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / ninit;
+        double byte_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / nbytes;
+        pairs.push_back(json_pair(name + "_init_ns", std::to_string(init_ns), false));
+        pairs.push_back(json_pair(name + "_ns_per_byte", std::to_string(byte_ns), false));
+    }
+
+    std::cout << json_obj(pairs) << "\n";
+    return 0;
+}
+
+// Public keys collected from stdin and hashed to witness programs in one call
+#define PK_BATCH 256
+
+class PublicKeyBatch {
+public:
+    void add(std::vector<uint8_t> pk) { keys_.push_back(std::move(pk)); }
+    size_t size() const { return keys_.size(); }
+    void clear() { keys_.clear(); }
+    void hash() {
+        std::vector<const uint8_t*> in(keys_.size());
+        std::vector<size_t> len(keys_.size());
+        for (size_t i = 0; i < keys_.size(); ++i) {
+            in[i] = keys_[i].data();
+            len[i] = keys_[i].size();
+        }
+        programs_.resize(keys_.size() * QTC_WITNESS_PROGRAM_BYTES);
+        witness_programs_many(programs_.data(), in.data(), len.data(), keys_.size());
+    }
+    const uint8_t* program(size_t i) const { return &programs_[i * QTC_WITNESS_PROGRAM_BYTES]; }
+
+private:
+    std::vector<std::vector<uint8_t>> keys_;
+    std::vector<uint8_t> programs_;
+};
+
+// Append "path address pk_b64 sk_b64" lines from stdin; creates the store on first use
+static int cmd_keystore_put(const std::string& file) {
+    if (!std::ifstream(file)) {
+        OQS_SIG* sig = sig_new_any();
+        if (!sig) { std::cerr << "error: ML-DSA-65 unavailable\n"; return 2; }
+        Keystore::create(file, (uint32_t)sig->length_public_key, (uint32_t)sig->length_secret_key);
+        OQS_SIG_free(sig);
+    }
+    Keystore ks(file, true);
+
+    // Each line is read into a slot of text and the secret key decoded into
+    // a slot of keys, so neither passes through the heap
+    SecureArena keys(ks.sk_bytes(), 1);
+    SecureArena text(secret_json_bytes(ks.pk_bytes() + ks.sk_bytes()), 1);
+    warn_if_unlocked(keys.locked() && text.locked());
+    SecretSlot sk(keys), line(text);
+    char* buf = (char*)line.data();
+    std::vector<uint8_t> pk(ks.pk_bytes());
+    uint64_t stored = 0;
+    while (std::cin.getline(buf, (std::streamsize)line.size())) {
+        const char* p = buf;
+        const char* end = buf + std::strlen(buf);
+        std::pair<const char*, size_t> tok[4];
+        size_t ntok = 0;
+        while (ntok < 4) {
+            while (p < end && std::isspace((unsigned char)*p)) ++p;
+            if (p == end) break;
+            const char* b = p;
+            while (p < end && !std::isspace((unsigned char)*p)) ++p;
+            tok[ntok++] = {b, (size_t)(p - b)};
+        }
+        if (ntok == 0) continue;
+        if (ntok < 4) throw std::runtime_error("keystore_put expects: path address pk_b64 sk_b64");
+        size_t pk_len = b64_decode_to(pk.data(), pk.size(), tok[2].first, tok[2].second);
+        size_t sk_len = b64_decode_to(sk.data(), sk.size(), tok[3].first, tok[3].second);
+        ks.put(hd_path_from_string(std::string(tok[0].first, tok[0].second)),
+               std::string(tok[1].first, tok[1].second), pk.data(), pk_len, sk.data(), sk_len);
+        OQS_MEM_cleanse(sk.data(), sk_len);
+        OQS_MEM_cleanse(buf, (size_t)(end - buf));
+        ++stored;
+    }
+    if (!std::cin.eof()) throw std::runtime_error("keystore_put line too long");
+    ks.sync();
+
     std::cout << json_obj({
-        json_pair("kyber_public_b64", pk_b64),
-        json_pair("kyber_private_b64", sk_b64),
-        json_pair("shared_b64", ss_b64)
+        json_pair("stored", std::to_string(stored), false),
+        json_pair("total", std::to_string(ks.count()), false)
     }) << "\n";
     return 0;
 }
 
+static int cmd_keystore_get(const std::string& file, const std::string& path) {
+    Keystore ks(file, false);
+    Keystore::Record rec;
+    if (!ks.get(hd_path_from_string(path), rec)) {
+        std::cerr << "error: " << path << " not in keystore\n"; return 5;
+    }
+
+    SecureArena text(secret_json_bytes(rec.pk_len + rec.sk_len) + std::strlen(rec.address), 1);
+    warn_if_unlocked(text.locked());
+    SecretSlot buf(text);
+    SecretJson json(buf);
+    json.field(json_pair("path", hd_path_to_string(rec.path)))
+        .field(json_pair("address", rec.address))
+        .b64("dilithium_public_b64", rec.pk, rec.pk_len)
+        .b64("dilithium_private_b64", rec.sk, rec.sk_len);
+    const char* line = json.close();
+    std::cout.write(line, json.size()) << "\n";
+    return 0;
+}
+
+// Index "path pk_b64" lines from stdin by witness program; the first line
+// creates a missing index for its purpose
+static int cmd_addrindex_add(const std::string& file) {
+    std::unique_ptr<AddressIndex> ai;
+    if (std::ifstream(file)) ai.reset(new AddressIndex(file, true));
+
+    std::string line;
+    uint64_t indexed = 0;
+    PublicKeyBatch batch;
+    std::vector<HdPath> paths;
+    auto flush = [&]() {
+        batch.hash();
+        for (size_t i = 0; i < paths.size(); ++i) ai->add(batch.program(i), paths[i]);
+        indexed += paths.size();
+        batch.clear();
+        paths.clear();
+    };
+    while (std::getline(std::cin, line)) {
+        std::istringstream in(line);
+        std::string path, pk_b64;
+        if (!(in >> path)) continue;
+        if (!(in >> pk_b64)) throw std::runtime_error("addrindex_add expects: path pk_b64");
+        HdPath p = hd_path_from_string(path);
+        if (!ai) ai.reset(new AddressIndex(AddressIndex::create(file, p.purpose)));
+        batch.add(b64_decode(pk_b64));
+        paths.push_back(p);
+        if (paths.size() == PK_BATCH) flush();
+    }
+    if (!paths.empty()) flush();
+    if (ai) ai->sync();
+
+    std::cout << json_obj({
+        json_pair("indexed", std::to_string(indexed), false),
+        json_pair("total", std::to_string(ai ? ai->count() : 0), false)
+    }) << "\n";
+    return 0;
+}
+
+// Witness programs and addresses of base64 public keys from stdin, one JSON
+// line each; keys are hashed PK_BATCH at a time
+static int cmd_address_from_pubkeys() {
+    std::string line;
+    PublicKeyBatch batch;
+    std::vector<std::string> addresses;
+    auto flush = [&]() {
+        batch.hash();
+        qtc_address_encode_many(addresses, batch.program(0), batch.size());
+        for (size_t i = 0; i < batch.size(); ++i) {
+            std::cout << json_obj({
+                json_pair("witness_program_hex", bin2hex(batch.program(i), QTC_WITNESS_PROGRAM_BYTES)),
+                json_pair("address", addresses[i])
+            }) << "\n";
+        }
+        batch.clear();
+    };
+    while (std::getline(std::cin, line)) {
+        std::istringstream in(line);
+        std::string pk_b64;
+        if (!(in >> pk_b64)) continue;
+        batch.add(b64_decode(pk_b64));
+        if (batch.size() == PK_BATCH) flush();
+    }
+    if (batch.size()) flush();
+    return 0;
+}
+
+// Resolve hex witness programs from stdin; prints one JSON line per program
+static int cmd_addrindex_lookup(const std::string& file) {
+    AddressIndex ai(file, false);
+    std::string line;
+    std::vector<uint8_t> programs;
+    while (std::getline(std::cin, line)) {
+        std::istringstream in(line);
+        std::string hex;
+        if (!(in >> hex)) continue;
+        auto program = hex2bin(hex);
+        if (program.size() != QTC_WITNESS_PROGRAM_BYTES)
+            throw std::runtime_error("witness program must be 20 bytes");
+        programs.insert(programs.end(), program.begin(), program.end());
+    }
+
+    size_t n = programs.size() / QTC_WITNESS_PROGRAM_BYTES;
+    std::vector<HdPath> paths(n);
+    std::unique_ptr<bool[]> found(new bool[n]);
+    ai.lookup_many(programs.data(), n, paths.data(), found.get());
+    for (size_t i = 0; i < n; ++i) {
+        std::string hex = bin2hex(&programs[i * QTC_WITNESS_PROGRAM_BYTES], QTC_WITNESS_PROGRAM_BYTES);
+        std::cout << json_obj({
+            json_pair("program", hex),
+            found[i] ? json_pair("path", hd_path_to_string(paths[i])) : json_pair("path", "null", false)
+        }) << "\n";
+    }
+    return 0;
+}
+
+// Encode hex witness programs from stdin; prints one address per line
+static int cmd_address_encode() {
+    std::string line;
+    std::vector<uint8_t> programs;
+    while (std::getline(std::cin, line)) {
+        std::istringstream in(line);
+        std::string hex;
+        if (!(in >> hex)) continue;
+        auto program = hex2bin(hex);
+        if (program.size() != QTC_WITNESS_PROGRAM_BYTES)
+            throw std::runtime_error("witness program must be 20 bytes");
+        programs.insert(programs.end(), program.begin(), program.end());
+    }
+
+    std::vector<std::string> addresses;
+    qtc_address_encode_many(addresses, programs.data(), programs.size() / QTC_WITNESS_PROGRAM_BYTES);
+    for (const auto& a : addresses) std::cout << a << "\n";
+    return 0;
+}
+
+// Check addresses from stdin, e.g. a withdrawal batch; prints one JSON line
+// per address and exits with 3 if any of them is invalid
+static int cmd_address_validate() {
+    std::string line;
+    std::vector<std::string> addresses;
+    while (std::getline(std::cin, line)) {
+        std::istringstream in(line);
+        std::string a;
+        if (in >> a) addresses.push_back(a);
+    }
+
+    size_t n = addresses.size();
+    std::vector<uint8_t> programs(n * QTC_WITNESS_PROGRAM_BYTES);
+    std::vector<AddressStatus> status(n);
+    size_t valid = qtc_address_validate_many(programs.data(), status.data(), addresses.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+        bool ok = status[i] == AddressStatus::Ok;
+        std::cout << json_obj({
+            json_pair("address", addresses[i]),
+            json_pair("valid", ok ? "true" : "false", false),
+            ok ? json_pair("witness_program_hex", bin2hex(&programs[i * QTC_WITNESS_PROGRAM_BYTES],
+                                                        QTC_WITNESS_PROGRAM_BYTES))
+               : json_pair("error", address_status_string(status[i]))
+        }) << "\n";
+    }
+    return valid == n ? 0 : 3;
+}
+
+// Keys generated and tested per round of export_wallet --pct
+#define PCT_BATCH 256
+
+// Stream count addresses of m/44'/account'/change/i into out_file, in the
+// layout of exportWallet() in qti3_hd.js or as JSON Lines; a rerun after an
+// interruption continues from the last complete record
+static int cmd_export_wallet(int argc, char** argv) {
+    std::vector<uint8_t> master_entropy = b64_decode(argv[2]);
+    std::string out_file = argv[3];
+    uint64_t count = std::stoull(argv[4]);
+    uint32_t account = 0, change = 0;
+    ExportFormat format = ExportFormat::Json;
+    bool watch_only = false, pct = false;
+    unsigned workers = 0;
+    std::string master_json;
+    for (int i = 5; i < argc; ++i) {
+        std::string opt = argv[i];
+        if (opt == "--watch-only") { watch_only = true; continue; }
+        if (opt == "--pct") { pct = true; continue; }
+        if (i + 1 >= argc) throw std::runtime_error("export_wallet option without value");
+        std::string val = argv[++i];
+        if (opt == "--account") account = (uint32_t)std::stoul(val);
+        else if (opt == "--change") change = (uint32_t)std::stoul(val);
+        else if (opt == "--format") format = export_format_from_string(val);
+        else if (opt == "--mode") g_rng_mode = rng_mode_from_string(val);
+        else if (opt == "--workers") workers = (unsigned)std::stoul(val);
+        else if (opt == "--master") {
+            std::ifstream f(val, std::ios::binary);
+            std::istream& in = (val == "-") ? std::cin : f;
+            if (val != "-" && !f) throw std::runtime_error("cannot read " + val);
+            master_json.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        else throw std::runtime_error("unknown export_wallet option " + opt);
+    }
+    if (count > 0x80000000ULL) throw std::runtime_error("HD path component out of range");
+    if (pct && watch_only) throw std::runtime_error("--pct tests secret keys; it cannot be combined with --watch-only");
+    if (master_json.empty())
+        master_json = json_obj({json_pair("master_entropy_b64", b64_encode(master_entropy.data(), master_entropy.size()))});
+    if ((watch_only || pct) && !sig_is_mldsa65()) { std::cerr << "error: liboqs lacks ML-DSA-65\n"; return 2; }
+
+    OQS_SIG* sig = (watch_only || pct) ? nullptr : sig_new_any();
+    if (!watch_only && !pct && !sig) { std::cerr << "error: ML-DSA-65 unavailable\n"; return 2; }
+    std::unique_ptr<OQS_SIG, void (*)(OQS_SIG*)> sig_guard(sig, OQS_SIG_free);
+    size_t pk_len = sig ? sig->length_public_key : QTC_MLDSA65_PUBLICKEYBYTES;
+    size_t sk_len = watch_only ? 0 : sig ? sig->length_secret_key : QTC_MLDSA65_SECRETKEYBYTES;
+
+    // Secret keys are generated into slots of keys and records are built in
+    // the slot of text; both are mapped once for the whole export
+    SecureArena keys(watch_only ? 1 : sk_len, pct ? PCT_BATCH : 1);
+    SecureArena text(secret_json_bytes(pk_len + sk_len), 1);
+    ExportParams params;
+    params.account = account;
+    params.change = change;
+    params.mode = g_rng_mode;
+    params.watch_only = watch_only;
+    params.pct = pct;
+    ExportWriter out(out_file, format, master_json, params);
+    warn_if_unlocked(keys.locked() && text.locked() && out.buffer_locked());
+    SecretSlot record(text);
+    uint64_t first = out.next_index();
+    uint8_t program[QTC_WITNESS_PROGRAM_BYTES];
+    auto write = [&](uint64_t i, const uint8_t* pk, const uint8_t* sk) {
+        HdPath path{44, account, change, (uint32_t)i};
+        witness_program(program, pk, pk_len);
+        SecretJson json(record);
+        json.field(json_pair("index", std::to_string(i), false))
+            .field(json_pair("path", hd_path_to_string(path)))
+            .field(json_pair("address", qtc_address(program, sizeof(program))))
+            .b64("dilithium_public_b64", pk, pk_len);
+        if (sk) json.b64("dilithium_private_b64", sk, sk_len);
+        const char* line = json.close();
+        out.write_record(line, json.size());
+    };
+    // QTCHDNode.generateKeyPair() seeds keygen with the first 32 bytes
+    auto child_seed = [&](uint64_t i) {
+        uint8_t entropy[64];
+        hd_child_entropy(entropy, master_entropy, HdPath{44, account, change, (uint32_t)i});
+        std::vector<uint8_t> seed(entropy, entropy + 32);
+        OQS_MEM_cleanse(entropy, sizeof(entropy));
+        return seed;
+    };
+
+    if (pct) {
+        // Each worker generates a key and runs its consistency test on the
+        // keygen state while the others generate theirs; the batch is then
+        // written in order
+        std::vector<uint8_t> pks(PCT_BATCH * pk_len);
+        std::vector<char> ok(PCT_BATCH);
+        if (workers == 0) workers = std::thread::hardware_concurrency();
+        if (workers == 0) workers = 1;
+        for (uint64_t base = first; base < count; base += PCT_BATCH) {
+            size_t n = (size_t)std::min<uint64_t>(PCT_BATCH, count - base);
+            std::vector<SecretSlot> sks;
+            sks.reserve(n);
+            for (size_t k = 0; k < n; ++k) sks.emplace_back(keys);
+            std::atomic<size_t> next{0};
+            std::exception_ptr error;
+            std::mutex error_lock;
+            auto work = [&]() {
+                for (size_t k; (k = next++) < n;) {
+                    try {
+                        std::vector<uint8_t> seed = child_seed(base + k);
+                        ok[k] = mldsa65_keypair_from_seed_pct(&pks[k * pk_len], sks[k].data(), seed, g_rng_mode);
+                        OQS_MEM_cleanse(seed.data(), seed.size());
+                    } catch (...) {
+                        std::lock_guard<std::mutex> g(error_lock);
+                        if (!error) error = std::current_exception();
+                    }
+                }
+            };
+            std::vector<std::thread> threads;
+            for (unsigned t = 1; t < workers && t < n; ++t) threads.emplace_back(work);
+            work();
+            for (auto& t : threads) t.join();
+            if (error) std::rethrow_exception(error);
+
+            for (size_t k = 0; k < n; ++k) {
+                if (!ok[k]) {
+                    std::cerr << "error: pairwise consistency test failed at index " << base + k << "\n";
+                    return 3;
+                }
+                write(base + k, &pks[k * pk_len], sks[k].data());
+            }
+        }
+    } else {
+        std::vector<uint8_t> pk(pk_len);
+        SecretSlot sk(keys);
+        for (uint64_t i = first; i < count; ++i) {
+            std::vector<uint8_t> seed = child_seed(i);
+            if (watch_only) {
+                mldsa65_public_key_from_seed(pk.data(), seed, g_rng_mode);
+            } else {
+                RngScope scope(seed, "dilithium_keygen");
+                if (OQS_SIG_keypair(sig, pk.data(), sk.data()) != OQS_SUCCESS) {
+                    std::cerr << "error: SIG keypair failed\n"; return 3;
+                }
+            }
+            OQS_MEM_cleanse(seed.data(), seed.size());
+            write(i, pk.data(), watch_only ? nullptr : sk.data());
+            if (!watch_only) OQS_MEM_cleanse(sk.data(), sk_len);
+        }
+    }
+    out.finish();
+
+    std::vector<std::string> summary = {
+        json_pair("file", out_file),
+        json_pair("resumed_at", std::to_string(first), false),
+        json_pair("total_addresses", std::to_string(out.next_index()), false)
+    };
+    if (pct) summary.push_back(json_pair("pct_passed", std::to_string(count > first ? count - first : 0), false));
+    std::cout << json_obj(summary) << "\n";
+    return 0;
+}
+
+// Re-derive every address of a wallet export and report the records that
+// differ; exits with 3 if any does
+static int cmd_audit(int argc, char** argv) {
+    AuditOptions opt;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        std::string o = argv[i], val = argv[i + 1];
+        if (o == "--mode") opt.mode = rng_mode_from_string(val);
+        else if (o == "--workers") opt.workers = (unsigned)std::stoul(val);
+        else if (o == "--master-entropy") opt.master_entropy = b64_decode(val);
+        else throw std::runtime_error("unknown audit option " + o);
+    }
+    if ((argc - 3) % 2) throw std::runtime_error("audit option without value");
+    if (!sig_is_mldsa65()) { std::cerr << "error: liboqs lacks ML-DSA-65\n"; return 2; }
+
+    auto t0 = std::chrono::steady_clock::now();
+    AuditSummary sum = audit_wallet(argv[2], opt, [](const AuditIssue& issue) {
+        std::cout << json_obj({
+            json_pair("record", std::to_string(issue.record), false),
+            json_pair("path", issue.path),
+            json_pair("error", issue.error)
+        }) << std::endl;
+    });
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::cout << json_obj({
+        json_pair("checked", std::to_string(sum.checked), false),
+        json_pair("mismatches", std::to_string(sum.mismatches), false),
+        json_pair("seconds", std::to_string(secs), false)
+    }) << "\n";
+    return sum.mismatches ? 3 : 0;
+}
+
+static std::string pool_address_json(const DerivedAddress& d) {
+    return json_obj({
+        json_pair("path", hd_path_to_string(d.path)),
+        json_pair("address", d.address),
+        json_pair("witness_program_hex", bin2hex(d.program, sizeof(d.program)))
+    });
+}
+
+// Serve pre-derived deposit addresses; reads "take <account>", "peek <account>",
+// "used <account> <index>" and "available <account>" lines from stdin and
+// answers each with one JSON line
+static int cmd_pool_serve(int argc, char** argv) {
+    AddressPoolConfig cfg;
+    cfg.master_entropy = b64_decode(argv[2]);
+    cfg.state_file = argv[3];
+    for (int i = 4; i + 1 < argc; i += 2) {
+        std::string opt = argv[i], val = argv[i + 1];
+        if (opt == "--accounts") {
+            cfg.accounts.clear();
+            std::istringstream in(val);
+            std::string id;
+            while (std::getline(in, id, ',')) cfg.accounts.push_back((uint32_t)std::stoul(id));
+        }
+        else if (opt == "--change") cfg.change = (uint32_t)std::stoul(val);
+        else if (opt == "--gap") cfg.gap_limit = (uint32_t)std::stoul(val);
+        else if (opt == "--ring") cfg.ring_size = std::stoul(val);
+        else if (opt == "--low") cfg.low_watermark = std::stoul(val);
+        else if (opt == "--workers") cfg.workers = (unsigned)std::stoul(val);
+        else if (opt == "--mode") cfg.mode = rng_mode_from_string(val);
+        else throw std::runtime_error("unknown pool_serve option " + opt);
+    }
+    if ((argc - 4) % 2) throw std::runtime_error("pool_serve option without value");
+    if (!sig_is_mldsa65()) { std::cerr << "error: liboqs lacks ML-DSA-65\n"; return 2; }
+
+    AddressPool pool(cfg);
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        std::istringstream in(line);
+        std::string op;
+        uint32_t account = 0, index = 0;
+        if (!(in >> op)) continue;
+        if (!(in >> account)) throw std::runtime_error("pool_serve expects: " + op + " <account>");
+
+        DerivedAddress d;
+        if (op == "take" || op == "peek") {
+            bool ok = (op == "take") ? pool.take(account, d) : pool.peek(account, d);
+            std::cout << (ok ? pool_address_json(d) : json_obj({json_pair("error", "pool empty")}));
+        } else if (op == "used") {
+            if (!(in >> index)) throw std::runtime_error("pool_serve expects: used <account> <index>");
+            pool.mark_used(account, index);
+            std::cout << json_obj({json_pair("ok", "true", false)});
+        } else if (op == "available") {
+            std::cout << json_obj({json_pair("available", std::to_string(pool.available(account)), false)});
+        } else {
+            throw std::runtime_error("unknown pool_serve request " + op);
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
+
 int main(int argc, char** argv) {
     try {
-        if (argc != 3) {
+        if (argc == 2 && std::string(argv[1]) == "bench_rng") return cmd_bench_rng();
+        if (argc == 3 && std::string(argv[1]) == "keystore_put") return cmd_keystore_put(argv[2]);
+        if (argc == 4 && std::string(argv[1]) == "keystore_get") return cmd_keystore_get(argv[2], argv[3]);
+        if (argc == 3 && std::string(argv[1]) == "addrindex_add") return cmd_addrindex_add(argv[2]);
+        if (argc == 3 && std::string(argv[1]) == "addrindex_lookup") return cmd_addrindex_lookup(argv[2]);
+        if (argc == 2 && std::string(argv[1]) == "address_encode") return cmd_address_encode();
+        if (argc == 2 && std::string(argv[1]) == "address_validate") return cmd_address_validate();
+        if (argc == 2 && std::string(argv[1]) == "address_from_pubkeys") return cmd_address_from_pubkeys();
+        if (argc >= 3 && std::string(argv[1]) == "audit") return cmd_audit(argc, argv);
+        if (argc >= 5 && std::string(argv[1]) == "export_wallet") return cmd_export_wallet(argc, argv);
+        if (argc >= 4 && std::string(argv[1]) == "pool_serve") return cmd_pool_serve(argc, argv);
+        if (argc != 3 && argc != 4) {
             std::cerr << "usage:\n"
-                      << "  oqs_wallet_cli gen_kyber_from_seed <seed_hex>\n"
-                      << "  oqs_wallet_cli gen_dilithium_from_seed <seed_hex>\n"
-                      << "  oqs_wallet_cli kem_self_from_seed <seed_hex>\n";
+                      << "  oqs_wallet_cli gen_kyber_from_seed <seed_hex> [kat|shake256-v1]\n"
+                      << "  oqs_wallet_cli gen_dilithium_from_seed <seed_hex> [kat|shake256-v1]\n"
+                      << "  oqs_wallet_cli kem_self_from_seed <seed_hex> [kat|shake256-v1]\n"
+                      << "  oqs_wallet_cli derive_address_only <seed_hex> [kat|shake256-v1]\n"
+                      << "  oqs_wallet_cli bench_rng\n"
+                      << "  oqs_wallet_cli keystore_put <store>   (stdin: path address pk_b64 sk_b64)\n"
+                      << "  oqs_wallet_cli keystore_get <store> <path>\n"
+                      << "  oqs_wallet_cli addrindex_add <index>      (stdin: path pk_b64)\n"
+                      << "  oqs_wallet_cli addrindex_lookup <index>   (stdin: program_hex)\n"
+                      << "  oqs_wallet_cli address_encode     (stdin: program_hex)\n"
+                      << "  oqs_wallet_cli address_validate   (stdin: address)\n"
+                      << "  oqs_wallet_cli address_from_pubkeys   (stdin: pk_b64)\n"
+                      << "  oqs_wallet_cli export_wallet <master_entropy_b64> <out_file> <count> [--account N]\n"
+                      << "      [--change N] [--format json|jsonl] [--watch-only | --pct [--workers N]] [--master file|-]\n"
+                      << "      [--mode kat|shake256-v1]\n"
+                      << "  oqs_wallet_cli audit <wallet.json|wallet.jsonl> [--mode kat|shake256-v1] [--workers N]\n"
+                      << "      [--master-entropy b64]\n"
+                      << "  oqs_wallet_cli pool_serve <master_entropy_b64> <state_file> [--accounts 0,1]\n"
+                      << "      [--change N] [--gap N] [--ring N] [--low N] [--workers N] [--mode kat|shake256-v1]\n";
             return 1;
         }
         std::string cmd = argv[1];
         std::string seed_hex = argv[2];
+        if (argc == 4) g_rng_mode = rng_mode_from_string(argv[3]);
         if (cmd == "gen_kyber_from_seed") return cmd_gen_kyber_from_seed(seed_hex);
         if (cmd == "gen_dilithium_from_seed") return cmd_gen_dilithium_from_seed(seed_hex);
         if (cmd == "kem_self_from_seed") return cmd_kem_self_from_seed(seed_hex);
+        if (cmd == "derive_address_only") return cmd_derive_address_only(seed_hex);
         std::cerr << "unknown command\n";
         return 1;
     } catch (const std::exception& e) {
@@ -0,0 +1,158 @@
+#include "mapped_file.h"
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define MAP_PAGE 4096u
+
+#ifdef _WIN32
+
+static intptr_t file_open(const std::string& file, bool writable, bool create) {
+    HANDLE h = CreateFileA(file.c_str(), GENERIC_READ | (writable ? GENERIC_WRITE : 0),
+                           FILE_SHARE_READ, nullptr, create ? CREATE_NEW : OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (h == INVALID_HANDLE_VALUE) throw std::runtime_error("cannot open keystore " + file);
+    return (intptr_t)h;
+}
+
+static uint64_t file_size(intptr_t fd) {
+    LARGE_INTEGER n;
+    if (!GetFileSizeEx((HANDLE)fd, &n)) throw std::runtime_error("keystore stat failed");
+    return (uint64_t)n.QuadPart;
+}
+
+static void file_resize(intptr_t fd, uint64_t size) {
+    LARGE_INTEGER n;
+    n.QuadPart = (LONGLONG)size;
+    if (!SetFilePointerEx((HANDLE)fd, n, nullptr, FILE_BEGIN) || !SetEndOfFile((HANDLE)fd))
+        throw std::runtime_error("keystore resize failed");
+}
+
+static void file_close(intptr_t fd) {
+    CloseHandle((HANDLE)fd);
+}
+
+void MappedFile::map(uint64_t size) {
+    HANDLE m = CreateFileMappingA((HANDLE)fd_, nullptr, writable_ ? PAGE_READWRITE : PAGE_READONLY,
+                                  (DWORD)(size >> 32), (DWORD)size, nullptr);
+    if (!m) throw std::runtime_error("keystore mmap failed");
+    void* p = MapViewOfFile(m, writable_ ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, (SIZE_T)size);
+    if (!p) {
+        CloseHandle(m);
+        throw std::runtime_error("keystore mmap failed");
+    }
+    mapping_ = (intptr_t)m;
+    base_ = (uint8_t*)p;
+    size_ = size;
+}
+
+void MappedFile::unmap() {
+    if (base_) UnmapViewOfFile(base_);
+    if (mapping_) CloseHandle((HANDLE)mapping_);
+    base_ = nullptr;
+    mapping_ = 0;
+    size_ = 0;
+}
+
+void MappedFile::sync() {
+    if (!writable_ || !base_) return;
+    if (!FlushViewOfFile(base_, (SIZE_T)size_) || !FlushFileBuffers((HANDLE)fd_))
+        throw std::runtime_error("keystore sync failed");
+}
+
+#else
+
+static intptr_t file_open(const std::string& file, bool writable, bool create) {
+    int flags = writable ? O_RDWR : O_RDONLY;
+    if (create) flags |= O_CREAT | O_EXCL;
+    int fd = ::open(file.c_str(), flags | O_CLOEXEC, 0600);
+    if (fd < 0) throw std::runtime_error("cannot open keystore " + file);
+    return fd;
+}
+
+static uint64_t file_size(intptr_t fd) {
+    struct stat st;
+    if (fstat((int)fd, &st) != 0) throw std::runtime_error("keystore stat failed");
+    return (uint64_t)st.st_size;
+}
+
+static void file_resize(intptr_t fd, uint64_t size) {
+    if (ftruncate((int)fd, (off_t)size) != 0) throw std::runtime_error("keystore resize failed");
+}
+
+static void file_close(intptr_t fd) {
+    ::close((int)fd);
+}
+
+void MappedFile::map(uint64_t size) {
+    void* p = mmap(nullptr, size, PROT_READ | (writable_ ? PROT_WRITE : 0), MAP_SHARED, (int)fd_, 0);
+    if (p == MAP_FAILED) throw std::runtime_error("keystore mmap failed");
+    base_ = (uint8_t*)p;
+    size_ = size;
+}
+
+void MappedFile::unmap() {
+    if (base_) munmap(base_, size_);
+    base_ = nullptr;
+    size_ = 0;
+}
+
+void MappedFile::sync() {
+    if (!writable_ || !base_) return;
+    if (msync(base_, size_, MS_SYNC) != 0) throw std::runtime_error("keystore sync failed");
+}
+
+#endif
+
+MappedFile::MappedFile(const std::string& file, bool writable, bool create, uint64_t size)
+    : writable_(writable) {
+    fd_ = file_open(file, writable, create);
+    try {
+        if (create) file_resize(fd_, size);
+        else size = file_size(fd_);
+        if (size) map(size);
+    } catch (...) {
+        unmap();
+        file_close(fd_);
+        throw;
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& o) noexcept
+    : fd_(o.fd_), mapping_(o.mapping_), base_(o.base_), size_(o.size_), writable_(o.writable_) {
+    o.fd_ = -1;
+    o.mapping_ = 0;
+    o.base_ = nullptr;
+    o.size_ = 0;
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+void MappedFile::close(uint64_t final_size) {
+    if (fd_ == -1) return;
+    unmap();
+    if (writable_ && final_size) {
+        try { file_resize(fd_, final_size); } catch (...) {}
+    }
+    file_close(fd_);
+    fd_ = -1;
+}
+
+void MappedFile::grow(uint64_t min_size) {
+    if (min_size <= size_) return;
+    uint64_t size = std::max(min_size, size_ + size_ / 2);
+    size = (size + MAP_PAGE - 1) & ~(uint64_t)(MAP_PAGE - 1);
+    unmap();
+    file_resize(fd_, size);
+    map(size);
+}
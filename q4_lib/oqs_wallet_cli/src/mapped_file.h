@@ -0,0 +1,60 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+// Unsigned integer stored little-endian, independent of the host byte order;
+// the on-disk layouts of the keystore and the address index are built from it
+template <typename T>
+class LeUint {
+public:
+    operator T() const {
+        T v = 0;
+        for (size_t i = sizeof(T); i-- > 0;) v = (T)(v << 8 | b_[i]);
+        return v;
+    }
+    LeUint& operator=(T v) {
+        for (size_t i = 0; i < sizeof(T); ++i, v = (T)(v >> 8)) b_[i] = (uint8_t)v;
+        return *this;
+    }
+
+private:
+    uint8_t b_[sizeof(T)];
+};
+
+typedef LeUint<uint32_t> le32;
+typedef LeUint<uint64_t> le64;
+
+// A whole file mapped read-only or read-write (mmap, or MapViewOfFile on
+// Windows). Backs the keystore and the address index.
+class MappedFile {
+public:
+    MappedFile() = default;
+    // create fails if the file exists; a new file starts with size bytes of zeros
+    MappedFile(const std::string& file, bool writable, bool create, uint64_t size = 0);
+    MappedFile(MappedFile&& o) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    uint8_t* data() const { return base_; }
+    uint64_t size() const { return size_; }
+    bool writable() const { return writable_; }
+
+    // Extends the file to at least min_size, by at least half its size so
+    // appends remap rarely; pointers into the old mapping are invalidated
+    void grow(uint64_t min_size);
+    void sync();
+    // Unmaps, cuts a writable file to final_size if non-zero, and closes it
+    void close(uint64_t final_size = 0);
+
+private:
+    void map(uint64_t size);
+    void unmap();
+
+    intptr_t fd_ = -1;
+    intptr_t mapping_ = 0;
+    uint8_t* base_ = nullptr;
+    uint64_t size_ = 0;
+    bool writable_ = false;
+};
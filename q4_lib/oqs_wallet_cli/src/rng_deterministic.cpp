@@ -3,23 +3,28 @@
 #include <string>
 #include <cstring>
 #include <stdexcept>
-#include <oqs/sha3.h>
+#include <mutex>
 #include <oqs/rand.h>
+#include <oqs/common.h>
+extern "C" {
+#include "../../fips202/fips202.h"
+}
 
 // Expand arbitrary seed + domain into 48 bytes using cSHAKE256
 std::vector<uint8_t> shake256_expand_seed_48(const std::vector<uint8_t>& seed, const std::string& domain) {
     // SHAKE256 fallback for cSHAKE256: absorb domain prefix and domain manually
-    OQS_SHA3_shake256_inc_ctx ctx;
-    OQS_SHA3_shake256_inc_init(&ctx);
+    // Uses the shared FIPS-202 library, which picks the fastest Keccak backend
+    keccak_state ctx;
+    shake256_init(&ctx);
     
     std::string prefix = "oqs_wallet_cli"; 
-    OQS_SHA3_shake256_inc_absorb(&ctx, (const uint8_t*)prefix.data(), prefix.size());
-    OQS_SHA3_shake256_inc_absorb(&ctx, (const uint8_t*)domain.data(), domain.size());
+    shake256_absorb(&ctx, (const uint8_t*)prefix.data(), prefix.size());
+    shake256_absorb(&ctx, (const uint8_t*)domain.data(), domain.size());
     
-    OQS_SHA3_shake256_inc_absorb(&ctx, seed.data(), seed.size());
-    OQS_SHA3_shake256_inc_finalize(&ctx);
+    shake256_absorb(&ctx, seed.data(), seed.size());
+    shake256_finalize(&ctx);
     std::vector<uint8_t> out(48);
-    OQS_SHA3_shake256_inc_squeeze(out.data(), out.size(), &ctx);
+    shake256_squeeze(out.data(), out.size(), &ctx);
     return out;
 }
 
@@ -32,4 +37,86 @@ void init_nist_kat_drbg_48(const std::vector<uint8_t>& seed48) {
     if (OQS_randombytes_switch_algorithm(OQS_RAND_alg_nist_kat) != OQS_SUCCESS) {
         throw std::runtime_error("Failed to switch RNG to NIST-KAT");
     }
-}
\ No newline at end of file
+}
+
+RngMode rng_mode_from_string(const std::string& name) {
+    if (name == "kat") return RngMode::NistKat;
+    if (name == "shake256-v1") return RngMode::Shake256V1;
+    throw std::runtime_error("unknown rng mode (expected kat or shake256-v1)");
+}
+
+const char* rng_mode_string(RngMode mode) {
+    return mode == RngMode::Shake256V1 ? "shake256-v1" : "kat";
+}
+
+// SHAKE256 DRBG state; output is squeezed a rate block at a time so that
+// small requests are served from buf and large ones bypass it
+static struct {
+    keccak_state ctx;
+    uint8_t buf[SHAKE256_RATE];
+    size_t pos;
+} drbg;
+
+// Seed the SHAKE256 DRBG with tag || len(domain) || domain || seed and
+// install it as the liboqs randombytes source
+static void shake256_v1_seed(keccak_state* ctx, const std::vector<uint8_t>& seed, const std::string& domain) {
+    if (domain.size() > 255) throw std::runtime_error("domain too long");
+    const std::string tag = QTC_SHAKE256_DRBG_TAG_V1;
+    uint8_t dlen = (uint8_t)domain.size();
+
+    shake256_init(ctx);
+    shake256_absorb(ctx, (const uint8_t*)tag.data(), tag.size());
+    shake256_absorb(ctx, &dlen, 1);
+    shake256_absorb(ctx, (const uint8_t*)domain.data(), domain.size());
+    shake256_absorb(ctx, seed.data(), seed.size());
+    shake256_finalize(ctx);
+}
+
+void init_shake256_drbg_v1(const std::vector<uint8_t>& seed, const std::string& domain) {
+    shake256_v1_seed(&drbg.ctx, seed, domain);
+    drbg.pos = SHAKE256_RATE;
+
+    OQS_randombytes_custom_algorithm(shake256_drbg_randombytes);
+}
+
+void shake256_drbg_randombytes(uint8_t* out, size_t outlen) {
+    size_t n = SHAKE256_RATE - drbg.pos;
+    if (n > outlen) n = outlen;
+    std::memcpy(out, drbg.buf + drbg.pos, n);
+    drbg.pos += n;
+    out += n;
+    outlen -= n;
+
+    n = outlen / SHAKE256_RATE;
+    shake256_squeezeblocks(out, n, &drbg.ctx);
+    out += n * SHAKE256_RATE;
+    outlen -= n * SHAKE256_RATE;
+
+    if (outlen) {
+        shake256_squeezeblocks(drbg.buf, 1, &drbg.ctx);
+        std::memcpy(out, drbg.buf, outlen);
+        drbg.pos = outlen;
+    }
+}
+
+void shake256_drbg_clear() {
+    OQS_MEM_cleanse(&drbg, sizeof(drbg));
+}
+
+// The liboqs DRBG is process-wide, so kat prefixes are drawn one at a time
+static std::mutex nist_kat_lock;
+
+void deterministic_prefix(uint8_t* out, size_t outlen, const std::vector<uint8_t>& seed,
+                          const std::string& domain, RngMode mode) {
+    if (mode == RngMode::Shake256V1) {
+        keccak_state ctx;
+        shake256_v1_seed(&ctx, seed, domain);
+        shake256_squeeze(out, outlen, &ctx);
+        OQS_MEM_cleanse(&ctx, sizeof(ctx));
+        return;
+    }
+    std::lock_guard<std::mutex> guard(nist_kat_lock);
+    init_nist_kat_drbg_48(shake256_expand_seed_48(seed, domain));
+    OQS_randombytes(out, outlen);
+    OQS_randombytes_switch_algorithm(OQS_RAND_alg_system);
+}
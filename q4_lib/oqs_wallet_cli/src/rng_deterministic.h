@@ -3,5 +3,26 @@
 #include <string>
 #include <cstdint>
 
+// Deterministic RNG used while deriving keys from a wallet seed
+enum class RngMode {
+    NistKat,     // liboqs NIST-KAT AES-256-CTR DRBG; reproduces existing wallets
+    Shake256V1   // SHAKE256 XOF keyed with the "v1" derivation tag
+};
+
+// Versioned derivation tag of RngMode::Shake256V1; never change, add a new mode
+#define QTC_SHAKE256_DRBG_TAG_V1 "QTC-Wallet/shake256-drbg/v1"
+
+RngMode rng_mode_from_string(const std::string& name);
+// Name rng_mode_from_string() accepts for mode
+const char* rng_mode_string(RngMode mode);
+
 std::vector<uint8_t> shake256_expand_seed_48(const std::vector<uint8_t>& seed, const std::string& domain);
-void init_nist_kat_drbg_48(const std::vector<uint8_t>& seed48);
\ No newline at end of file
+void init_nist_kat_drbg_48(const std::vector<uint8_t>& seed48);
+void init_shake256_drbg_v1(const std::vector<uint8_t>& seed, const std::string& domain);
+void shake256_drbg_randombytes(uint8_t* out, size_t outlen);
+void shake256_drbg_clear();
+
+// First outlen bytes a keygen would draw inside RngScope(seed, domain) under
+// mode; thread-safe, and leaves the liboqs randombytes source on system
+void deterministic_prefix(uint8_t* out, size_t outlen, const std::vector<uint8_t>& seed,
+                          const std::string& domain, RngMode mode);
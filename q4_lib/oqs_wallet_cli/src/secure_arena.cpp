@@ -0,0 +1,124 @@
+#include "secure_arena.h"
+#include <stdexcept>
+#include <oqs/common.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Slots start on this boundary; the gap to the guard page is below it
+#define ARENA_SLOT_ALIGN 16u
+
+#ifdef _WIN32
+
+static size_t page_size() {
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return si.dwPageSize;
+}
+
+static uint8_t* reserve(size_t len) {
+    void* p = VirtualAlloc(nullptr, len, MEM_RESERVE | MEM_COMMIT, PAGE_NOACCESS);
+    if (!p) throw std::runtime_error("cannot allocate secret memory");
+    return (uint8_t*)p;
+}
+
+static void open_pages(uint8_t* p, size_t len) {
+    DWORD old;
+    if (!VirtualProtect(p, len, PAGE_READWRITE, &old)) throw std::runtime_error("cannot allocate secret memory");
+}
+
+static bool lock_pages(uint8_t* p, size_t len) { return VirtualLock(p, len) != 0; }
+static void unlock_pages(uint8_t* p, size_t len) { VirtualUnlock(p, len); }
+static void exclude_from_dumps(uint8_t*, size_t) {}
+static void unmap(uint8_t* p, size_t) { VirtualFree(p, 0, MEM_RELEASE); }
+
+#else
+
+static size_t page_size() {
+    long n = sysconf(_SC_PAGESIZE);
+    return n > 0 ? (size_t)n : 4096;
+}
+
+static uint8_t* reserve(size_t len) {
+    void* p = mmap(nullptr, len, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) throw std::runtime_error("cannot allocate secret memory");
+    return (uint8_t*)p;
+}
+
+static void open_pages(uint8_t* p, size_t len) {
+    if (mprotect(p, len, PROT_READ | PROT_WRITE) != 0) throw std::runtime_error("cannot allocate secret memory");
+}
+
+static bool lock_pages(uint8_t* p, size_t len) { return mlock(p, len) == 0; }
+static void unlock_pages(uint8_t* p, size_t len) { munlock(p, len); }
+
+static void exclude_from_dumps(uint8_t* p, size_t len) {
+#ifdef MADV_DONTDUMP
+    madvise(p, len, MADV_DONTDUMP);
+#else
+    (void)p; (void)len;
+#endif
+}
+
+static void unmap(uint8_t* p, size_t len) { munmap(p, len); }
+
+#endif
+
+// Layout: guard page, then per slot its pages and a guard page
+SecureArena::SecureArena(size_t slot_size, size_t count) : slot_size_(slot_size), count_(count) {
+    if (slot_size == 0 || count == 0) throw std::runtime_error("empty secret arena");
+    page_ = page_size();
+    size_t span = (slot_size + ARENA_SLOT_ALIGN - 1) / ARENA_SLOT_ALIGN * ARENA_SLOT_ALIGN;
+    slot_pages_ = (span + page_ - 1) / page_;
+    stride_ = (slot_pages_ + 1) * page_;
+    total_ = page_ + count * stride_;
+    base_ = reserve(total_);
+
+    try {
+        for (size_t i = 0; i < count; ++i) {
+            uint8_t* pages = base_ + page_ + i * stride_;
+            open_pages(pages, slot_pages_ * page_);
+            if (locked_) locked_ = lock_pages(pages, slot_pages_ * page_);
+        }
+    } catch (...) {
+        unmap(base_, total_);
+        throw;
+    }
+    exclude_from_dumps(base_, total_);
+
+    free_.reserve(count);
+    for (size_t i = count; i-- > 0;) free_.push_back(slot(i));
+}
+
+SecureArena::~SecureArena() {
+    for (size_t i = 0; i < count_; ++i) {
+        uint8_t* pages = base_ + page_ + i * stride_;
+        OQS_MEM_cleanse(pages, slot_pages_ * page_);
+        if (locked_) unlock_pages(pages, slot_pages_ * page_);
+    }
+    unmap(base_, total_);
+}
+
+// The slot ends at the guard page, aligned down to ARENA_SLOT_ALIGN
+uint8_t* SecureArena::slot(size_t i) const {
+    size_t end = page_ + i * stride_ + slot_pages_ * page_;
+    return base_ + (end - slot_size_) / ARENA_SLOT_ALIGN * ARENA_SLOT_ALIGN;
+}
+
+uint8_t* SecureArena::acquire() {
+    std::lock_guard<std::mutex> g(lock_);
+    if (free_.empty()) throw std::runtime_error("secret arena exhausted");
+    uint8_t* p = free_.back();
+    free_.pop_back();
+    return p;
+}
+
+void SecureArena::release(uint8_t* p) {
+    OQS_MEM_cleanse(p, slot_size_);
+    std::lock_guard<std::mutex> g(lock_);
+    free_.push_back(p);
+}
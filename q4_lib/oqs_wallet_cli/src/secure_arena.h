@@ -0,0 +1,58 @@
+#pragma once
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Memory for secret keys and their encodings. One mapping holds count slots
+// of slot_size bytes. Each slot has its own pages and is followed by an
+// inaccessible guard page. The slot ends where its pages end, so an overrun
+// faults at once. The constructor locks the slot pages in RAM (mlock,
+// VirtualLock) and keeps them out of core dumps where the OS allows it.
+// acquire() and release() make no system calls. release() zeroes the slot.
+// Slots never move, so keygen can write into them directly.
+
+class SecureArena {
+public:
+    SecureArena(size_t slot_size, size_t count);
+    ~SecureArena();
+    SecureArena(const SecureArena&) = delete;
+    SecureArena& operator=(const SecureArena&) = delete;
+
+    // Throws once all slots are in use; thread-safe
+    uint8_t* acquire();
+    void release(uint8_t* slot);
+
+    size_t slot_size() const { return slot_size_; }
+    size_t capacity() const { return count_; }
+    // False if the OS refused to lock the pages (RLIMIT_MEMLOCK, quotas). The
+    // arena still works, but its pages may be swapped out.
+    bool locked() const { return locked_; }
+
+private:
+    uint8_t* slot(size_t i) const;
+
+    size_t slot_size_, count_;
+    size_t page_ = 0, slot_pages_ = 0, stride_ = 0, total_ = 0;
+    uint8_t* base_ = nullptr;
+    bool locked_ = true;
+    std::mutex lock_;
+    std::vector<uint8_t*> free_;
+};
+
+// A slot of an arena, held for the lifetime of the object
+class SecretSlot {
+public:
+    explicit SecretSlot(SecureArena& arena) : arena_(&arena), data_(arena.acquire()) {}
+    ~SecretSlot() { if (data_) arena_->release(data_); }
+    SecretSlot(SecretSlot&& o) noexcept : arena_(o.arena_), data_(o.data_) { o.data_ = nullptr; }
+    SecretSlot(const SecretSlot&) = delete;
+    SecretSlot& operator=(const SecretSlot&) = delete;
+
+    uint8_t* data() const { return data_; }
+    size_t size() const { return arena_->slot_size(); }
+
+private:
+    SecureArena* arena_;
+    uint8_t* data_;
+};
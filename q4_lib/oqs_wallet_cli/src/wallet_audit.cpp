@@ -0,0 +1,224 @@
+#include "wallet_audit.h"
+#include "mapped_file.h"
+#include "json_emit.h"
+#include "hd_derive.h"
+#include "bech32.h"
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <oqs/common.h>
+
+namespace {
+
+// Just enough JSON to walk a wallet export in place. Strings are returned as
+// views into the mapping; none of the fields read here contain escapes.
+struct Scanner {
+    const char* p;
+    const char* end;
+
+    [[noreturn]] void fail() const { throw std::runtime_error("malformed wallet JSON"); }
+    void ws() { while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) ++p; }
+    bool at_end() { ws(); return p == end; }
+    bool eat(char c) {
+        ws();
+        if (p < end && *p == c) { ++p; return true; }
+        return false;
+    }
+    void expect(char c) { if (!eat(c)) fail(); }
+
+    std::string_view string() {
+        expect('"');
+        const char* b = p;
+        while (p < end && *p != '"') p += (*p == '\\') ? 2 : 1;
+        if (p >= end) fail();
+        return std::string_view(b, (size_t)(p++ - b));
+    }
+
+    // A number or literal, as written
+    std::string_view scalar() {
+        ws();
+        const char* b = p;
+        while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\n' && *p != '\r') ++p;
+        if (p == b) fail();
+        return std::string_view(b, (size_t)(p - b));
+    }
+
+    void skip() {
+        ws();
+        if (p >= end) fail();
+        if (*p == '"') { string(); return; }
+        if (*p != '{' && *p != '[') { scalar(); return; }
+        char close = (*p == '{') ? '}' : ']';
+        bool object = (*p++ == '{');
+        if (eat(close)) return;
+        do {
+            if (object) { string(); expect(':'); }
+            skip();
+        } while (eat(','));
+        expect(close);
+    }
+
+    // Calls f(key) with p at the value; f must consume the value
+    template <typename F> void object(F f) {
+        expect('{');
+        if (eat('}')) return;
+        do {
+            std::string_view key = string();
+            expect(':');
+            f(key);
+        } while (eat(','));
+        expect('}');
+    }
+};
+
+struct Record {
+    std::string_view index, path, address, pk, sk;
+};
+
+class Auditor {
+public:
+    Auditor(const AuditOptions& opt, const std::function<void(const AuditIssue&)>& report)
+        : opt_(opt), report_(report), entropy_(opt.master_entropy) {
+        if (opt_.batch == 0) opt_.batch = 1;
+        batch_.reserve(opt_.batch);
+    }
+
+    void master(Scanner& s) {
+        s.object([&](std::string_view key) {
+            if (key == "master_entropy_b64" && opt_.master_entropy.empty())
+                entropy_ = b64_decode(std::string(s.string()));
+            else
+                s.skip();
+        });
+    }
+
+    void record(Scanner& s) {
+        Record r;
+        s.object([&](std::string_view key) {
+            if (key == "index") r.index = s.scalar();
+            else if (key == "path") r.path = s.string();
+            else if (key == "address") r.address = s.string();
+            else if (key == "dilithium_public_b64") r.pk = s.string();
+            else if (key == "dilithium_private_b64") r.sk = s.string();
+            else s.skip();
+        });
+        if (entropy_.empty()) throw std::runtime_error("master_entropy_b64 must come before the addresses");
+        batch_.push_back(r);
+        if (batch_.size() == opt_.batch) run();
+    }
+
+    AuditSummary finish() {
+        run();
+        return summary_;
+    }
+
+private:
+    std::string check(const Record& r) const;
+    void run();
+
+    AuditOptions opt_;
+    const std::function<void(const AuditIssue&)>& report_;
+    std::vector<uint8_t> entropy_;
+    std::vector<Record> batch_;
+    AuditSummary summary_;
+};
+
+std::string Auditor::check(const Record& r) const {
+    std::string err;
+    auto add = [&](const char* e) { err += err.empty() ? e : std::string("; ") + e; };
+
+    HdPath path = hd_path_from_string(std::string(r.path));
+    if (!r.index.empty() && r.index != std::to_string(path.index)) add("index does not match path");
+
+    uint8_t entropy[64], pk[QTC_MLDSA65_PUBLICKEYBYTES];
+    std::vector<uint8_t> derived;
+    hd_child_entropy(entropy, entropy_, path);
+    std::vector<uint8_t> seed(entropy, entropy + 32);
+    OQS_MEM_cleanse(entropy, sizeof(entropy));
+    if (r.sk.empty()) {
+        mldsa65_public_key_from_seed(pk, seed, opt_.mode);
+    } else {
+        // Only the full key pair covers s1, s2, t0 and K of the stored secret key
+        derived.resize(QTC_MLDSA65_SECRETKEYBYTES);
+        if (!mldsa65_keypair_from_seed_pct(pk, derived.data(), seed, opt_.mode))
+            add("key pair consistency test failed");
+    }
+    OQS_MEM_cleanse(seed.data(), seed.size());
+
+    std::vector<uint8_t> stored = b64_decode(std::string(r.pk));
+    if (stored.size() != sizeof(pk) || std::memcmp(stored.data(), pk, sizeof(pk)) != 0)
+        add("public key does not match derivation");
+
+    uint8_t program[QTC_WITNESS_PROGRAM_BYTES];
+    witness_program(program, stored.data(), stored.size());
+    if (qtc_address(program, sizeof(program)) != r.address) add("address does not match public key");
+
+    if (!r.sk.empty()) {
+        std::vector<uint8_t> sk = b64_decode(std::string(r.sk));
+        if (sk.size() != derived.size() || std::memcmp(sk.data(), derived.data(), derived.size()) != 0)
+            add("secret key does not match derivation");
+        OQS_MEM_cleanse(sk.data(), sk.size());
+        OQS_MEM_cleanse(derived.data(), derived.size());
+    }
+    return err;
+}
+
+void Auditor::run() {
+    size_t n = batch_.size();
+    if (n == 0) return;
+    std::vector<std::string> errors(n);
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        for (size_t i; (i = next++) < n;) {
+            try {
+                errors[i] = check(batch_[i]);
+            } catch (const std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+    };
+
+    unsigned workers = opt_.workers ? opt_.workers : std::thread::hardware_concurrency();
+    if (workers == 0) workers = 1;
+    if (workers > n) workers = (unsigned)n;
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < workers; ++t) threads.emplace_back(work);
+    work();
+    for (auto& t : threads) t.join();
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!errors[i].empty()) {
+            summary_.mismatches++;
+            report_(AuditIssue{summary_.checked + i, std::string(batch_[i].path), errors[i]});
+        }
+    }
+    summary_.checked += n;
+    batch_.clear();
+}
+
+} // namespace
+
+AuditSummary audit_wallet(const std::string& file, const AuditOptions& opt,
+                          const std::function<void(const AuditIssue&)>& report) {
+    MappedFile f(file, false, false);
+    const char* data = reinterpret_cast<const char*>(f.data());
+    Scanner s{data, data + f.size()};
+    Auditor a(opt, report);
+
+    // exportWallet() JSON, or the header line of a JSON Lines export
+    s.object([&](std::string_view key) {
+        if (key == "master") a.master(s);
+        else if (key == "addresses") {
+            s.expect('[');
+            if (s.eat(']')) return;
+            do a.record(s); while (s.eat(','));
+            s.expect(']');
+        }
+        else s.skip();
+    });
+    // JSON Lines: one address per line after the header
+    while (!s.at_end()) a.record(s);
+    return a.finish();
+}
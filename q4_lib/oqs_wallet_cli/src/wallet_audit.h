@@ -0,0 +1,40 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "rng_deterministic.h"
+
+// Re-derives every address of a wallet export and compares it with what is
+// stored. Reads the exportWallet() JSON of qti3_hd.js and both export_wallet
+// formats. The file is mapped and scanned in place. Records are checked in
+// batches, spread over worker threads. For each record:
+//   - the path is re-derived (child entropy, then public-key-only ML-DSA-65
+//     keygen, or the full key pair if the record has a secret key) and
+//     compared with dilithium_public_b64
+//   - the address of the stored key is compared with address
+//   - a dilithium_private_b64, if present, is compared with the secret key of
+//     the re-derived key pair, all of it
+//   - index, if present, must match the last path component
+
+struct AuditIssue {
+    uint64_t record;       // position in the addresses array
+    std::string path;
+    std::string error;
+};
+
+struct AuditOptions {
+    RngMode mode = RngMode::NistKat;
+    unsigned workers = 0;                 // 0: one per hardware thread
+    std::vector<uint8_t> master_entropy;  // empty: master_entropy_b64 of the file
+    size_t batch = 4096;
+};
+
+struct AuditSummary {
+    uint64_t checked = 0;
+    uint64_t mismatches = 0;
+};
+
+// Calls report for every failing record, in file order, from the calling thread
+AuditSummary audit_wallet(const std::string& file, const AuditOptions& opt,
+                          const std::function<void(const AuditIssue&)>& report);
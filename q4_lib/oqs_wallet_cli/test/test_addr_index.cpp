@@ -0,0 +1,254 @@
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "../src/addr_index.h"
+
+#define NPROGRAMS 300
+#define PK_BYTES 1952
+#define PURPOSE 44
+
+static const char* kFile = "test/addr_index.tmp";
+
+static HdPath path_of(uint32_t i) { return HdPath{PURPOSE, i % 3, i & 1, i}; }
+
+static void pk_of(uint8_t* out, uint32_t i) {
+    for (size_t j = 0; j < PK_BYTES; ++j) out[j] = (uint8_t)(j * 13 + i * 101);
+    for (size_t j = 0; j < 4; ++j) out[j] = (uint8_t)(i >> 8 * j);
+}
+
+static void program_of(uint8_t program[QTC_WITNESS_PROGRAM_BYTES], uint32_t i) {
+    std::vector<uint8_t> pk(PK_BYTES);
+    pk_of(pk.data(), i);
+    witness_program(program, pk.data(), pk.size());
+}
+
+static int check_programs(const AddressIndex& ai, uint32_t n) {
+    std::vector<uint8_t> programs((n + 1) * QTC_WITNESS_PROGRAM_BYTES);
+    std::vector<HdPath> paths(n + 1);
+    std::unique_ptr<bool[]> found(new bool[n + 1]);
+
+    if (ai.count() != n || ai.purpose() != PURPOSE) {
+        std::printf("addr_index: count %llu purpose %u\n", (unsigned long long)ai.count(), ai.purpose());
+        return 1;
+    }
+    // The last program was never added
+    for (uint32_t i = 0; i <= n; ++i) program_of(&programs[i * QTC_WITNESS_PROGRAM_BYTES], i);
+    if (ai.lookup_many(programs.data(), n + 1, paths.data(), found.get()) != n || found[n]) {
+        std::printf("addr_index: lookup_many hit count is wrong\n");
+        return 1;
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        HdPath p;
+        if (!found[i] || hd_path_to_string(paths[i]) != hd_path_to_string(path_of(i)) ||
+            !ai.lookup(&programs[i * QTC_WITNESS_PROGRAM_BYTES], p) ||
+            hd_path_to_string(p) != hd_path_to_string(path_of(i))) {
+            std::printf("addr_index: program %u does not round-trip\n", i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Add enough programs to grow the table a few times, then reopen read-only
+static int test_round_trip() {
+    uint8_t program[QTC_WITNESS_PROGRAM_BYTES];
+
+    std::remove(kFile);
+    {
+        AddressIndex ai = AddressIndex::create(kFile, PURPOSE, 4);
+        for (uint32_t i = 0; i < NPROGRAMS; ++i) {
+            program_of(program, i);
+            ai.add(program, path_of(i));
+        }
+        program_of(program, 7);
+        try {
+            ai.add(program, path_of(NPROGRAMS));
+            std::printf("addr_index: duplicate program accepted\n");
+            return 1;
+        } catch (const std::runtime_error&) {
+        }
+        program_of(program, NPROGRAMS);
+        try {
+            ai.add(program, HdPath{PURPOSE + 1, 0, 0, NPROGRAMS});
+            std::printf("addr_index: path of another purpose accepted\n");
+            return 1;
+        } catch (const std::runtime_error&) {
+        }
+        if (check_programs(ai, NPROGRAMS)) return 1;
+    }
+
+    AddressIndex ai(kFile, false);
+    if (check_programs(ai, NPROGRAMS)) return 1;
+    program_of(program, NPROGRAMS);
+    try {
+        ai.add(program, path_of(NPROGRAMS));
+        std::printf("addr_index: read-only index accepted an add\n");
+        return 1;
+    } catch (const std::runtime_error&) {
+    }
+
+    std::printf("addr_index round trip: ok\n");
+    return 0;
+}
+
+// Reopening writable keeps the entries and accepts more
+static int test_reopen() {
+    uint8_t program[QTC_WITNESS_PROGRAM_BYTES];
+
+    std::remove(kFile);
+    {
+        AddressIndex ai = AddressIndex::create(kFile, PURPOSE, 16);
+        for (uint32_t i = 0; i < 10; ++i) {
+            program_of(program, i);
+            ai.add(program, path_of(i));
+        }
+    }
+    {
+        AddressIndex ai(kFile, true);
+        if (check_programs(ai, 10)) return 1;
+        for (uint32_t i = 10; i < 50; ++i) {
+            program_of(program, i);
+            ai.add(program, path_of(i));
+        }
+    }
+    try {
+        AddressIndex::create(kFile, PURPOSE, 16);
+        std::printf("addr_index: create overwrote an existing index\n");
+        return 1;
+    } catch (const std::runtime_error&) {
+    }
+
+    AddressIndex ai(kFile, false);
+    if (check_programs(ai, 50)) return 1;
+
+    std::printf("addr_index reopen: ok\n");
+    return 0;
+}
+
+// The batched hash matches one program at a time, across lane counts
+static int test_programs_many() {
+    std::vector<uint8_t> pks(11 * PK_BYTES), programs(11 * QTC_WITNESS_PROGRAM_BYTES);
+    std::vector<const uint8_t*> ptrs(11);
+    std::vector<size_t> lens(11);
+    uint8_t program[QTC_WITNESS_PROGRAM_BYTES];
+
+    for (uint32_t i = 0; i < 11; ++i) {
+        pk_of(&pks[i * PK_BYTES], i);
+        ptrs[i] = &pks[i * PK_BYTES];
+        lens[i] = PK_BYTES - i;
+    }
+    witness_programs_many(programs.data(), ptrs.data(), lens.data(), 11);
+    for (uint32_t i = 0; i < 11; ++i) {
+        witness_program(program, ptrs[i], lens[i]);
+        if (std::memcmp(program, &programs[i * QTC_WITNESS_PROGRAM_BYTES], sizeof(program)) != 0) {
+            std::printf("addr_index: witness_programs_many differs at %u\n", i);
+            return 1;
+        }
+    }
+
+    std::printf("addr_index programs many: ok\n");
+    return 0;
+}
+
+static uint64_t load_le(const uint8_t* p, size_t n) {
+    uint64_t v = 0;
+    while (n--) v = v << 8 | p[n];
+    return v;
+}
+
+static void store_le(uint8_t* p, size_t n, uint64_t v) {
+    for (size_t i = 0; i < n; ++i, v >>= 8) p[i] = (uint8_t)v;
+}
+
+static bool read_file(std::vector<uint8_t>& buf) {
+    FILE* f = std::fopen(kFile, "rb");
+    if (!f) return false;
+    std::fseek(f, 0, SEEK_END);
+    buf.resize((size_t)std::ftell(f));
+    std::fseek(f, 0, SEEK_SET);
+    bool ok = std::fread(buf.data(), 1, buf.size(), f) == buf.size();
+    std::fclose(f);
+    return ok;
+}
+
+static bool write_file(const std::vector<uint8_t>& buf) {
+    FILE* f = std::fopen(kFile, "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+// The header, the entries and the bucket are little-endian whatever the
+// host; a full table is reported as corrupt instead of being probed forever
+static int test_disk_format() {
+    uint8_t program[QTC_WITNESS_PROGRAM_BYTES];
+    std::vector<uint8_t> buf;
+
+    std::remove(kFile);
+    {
+        AddressIndex ai = AddressIndex::create(kFile, PURPOSE, 4);
+        for (uint32_t i = 0; i < 3; ++i) {
+            program_of(program, i);
+            ai.add(program, path_of(i));
+        }
+    }
+    if (!read_file(buf) || buf.size() < 4096) {
+        std::printf("addr_index: cannot read back the file\n");
+        return 1;
+    }
+    uint64_t table = load_le(&buf[24], 8), capacity = load_le(&buf[32], 8);
+    if (load_le(&buf[8], 4) != 1 || load_le(&buf[12], 4) != 4096 || load_le(&buf[16], 4) != PURPOSE ||
+        load_le(&buf[40], 8) != 3 || load_le(&buf[48], 8) != buf.size() ||
+        table + capacity * 32 > buf.size()) {
+        std::printf("addr_index: header is not little-endian\n");
+        return 1;
+    }
+    // The first program added sits in its home bucket
+    program_of(program, 0);
+    const uint8_t* e = &buf[table + (load_le(program, 8) & (capacity - 1)) * 32];
+    if (std::memcmp(e, program, sizeof(program)) != 0 || load_le(e + 20, 4) != (path_of(0).account | 0x80000000u) ||
+        load_le(e + 24, 4) != path_of(0).change || load_le(e + 28, 4) != path_of(0).index) {
+        std::printf("addr_index: entry is not little-endian\n");
+        return 1;
+    }
+
+    // Occupy every entry with a program that is never looked up
+    for (uint64_t i = 0; i < capacity; ++i) {
+        uint8_t* f = &buf[table + i * 32];
+        std::memset(f, 0xee, QTC_WITNESS_PROGRAM_BYTES);
+        store_le(f, 8, i);
+        store_le(f + 20, 4, 0x80000000u);
+        store_le(f + 24, 4, 0);
+        store_le(f + 28, 4, (uint32_t)i);
+    }
+    if (!write_file(buf)) {
+        std::printf("addr_index: cannot write the file\n");
+        return 1;
+    }
+
+    AddressIndex ai(kFile, false);
+    HdPath p;
+    try {
+        ai.lookup(program, p);
+        std::printf("addr_index: full table not detected\n");
+        return 1;
+    } catch (const std::runtime_error&) {
+    }
+
+    std::printf("addr_index disk format: ok\n");
+    return 0;
+}
+
+int main() {
+    int r = 0;
+
+    r |= test_round_trip();
+    r |= test_reopen();
+    r |= test_programs_many();
+    r |= test_disk_format();
+    std::remove(kFile);
+    return r;
+}
@@ -0,0 +1,204 @@
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../src/bech32.h"
+
+#define NADDRESSES 64
+
+// BIP-173 and BIP-350 test vectors
+static const char* kValidBech32[] = {
+    "A12UEL5L",
+    "a12uel5l",
+    "an83characterlonghumanreadablepartthatcontainsthenumber1andtheexcludedcharactersbio1tt5tgs",
+    "abcdef1qpzry9x8gf2tvdw0s3jn54khce6mua7lmqqqxw",
+    "11qqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqc8247j",
+    "split1checkupstagehandshakeupstreamerranterredcaperred2y9e3w",
+};
+
+static const char* kValidBech32m[] = {
+    "A1LQFN3A",
+    "a1lqfn3a",
+    "abcdef1l7aum6echk45nj3s0wdvt2fg8x9yrzpqzd3ryx",
+    "split1checkupstagehandshakeupstreamerranterredcaperredlc445v",
+};
+
+static const char* kInvalid[] = {
+    "\x20" "1nwldj5",         // hrp character out of range
+    "pzry9x0s0muk",           // no separator
+    "1pzry9x0s0muk",          // empty hrp
+    "x1b4n0q5v",              // invalid data character
+    "li1dgmt3",               // checksum too short
+    "A1G7SGD8",               // checksum computed with upper-case hrp
+    "10a06t8",                // empty hrp
+    "A12uEL5L",               // mixed case
+    "a12uel5m",               // wrong checksum
+};
+
+static void program_of(uint8_t* program, uint32_t i) {
+    for (int j = 0; j < QTC_WITNESS_PROGRAM_BYTES; ++j) program[j] = (uint8_t)(j * 37 + i * 11 + (i >> 3));
+}
+
+// Witness version followed by the program regrouped into 5-bit words
+static std::vector<uint8_t> witness_words(uint8_t version, const uint8_t* program, size_t len) {
+    std::vector<uint8_t> data(1, version);
+    uint32_t acc = 0;
+    int bits = 0;
+    for (size_t i = 0; i < len; ++i) {
+        acc = (acc << 8) | program[i];
+        for (bits += 8; bits >= 5; bits -= 5) data.push_back((acc >> (bits - 5)) & 31);
+    }
+    if (bits) data.push_back((acc << (5 - bits)) & 31);
+    return data;
+}
+
+static int test_vectors() {
+    std::string hrp;
+    std::vector<uint8_t> data;
+    Bech32Variant variant;
+
+    for (const char* s : kValidBech32) {
+        if (!bech32_decode(s, hrp, data, variant) || variant != Bech32Variant::Bech32) {
+            std::printf("bech32: rejected valid bech32 %s\n", s);
+            return 1;
+        }
+    }
+    for (const char* s : kValidBech32m) {
+        if (!bech32_decode(s, hrp, data, variant) || variant != Bech32Variant::Bech32m) {
+            std::printf("bech32: rejected valid bech32m %s\n", s);
+            return 1;
+        }
+    }
+    for (const char* s : kInvalid) {
+        if (bech32_decode(s, hrp, data, variant)) {
+            std::printf("bech32: accepted invalid %s\n", s);
+            return 1;
+        }
+    }
+
+    std::printf("bech32 vectors: ok\n");
+    return 0;
+}
+
+// Encoding and decoding are inverse for both variants
+static int test_round_trip() {
+    std::string hrp, s;
+    std::vector<uint8_t> in, out;
+    Bech32Variant variant;
+
+    for (size_t len = 0; len < 60; ++len) {
+        in.resize(len);
+        for (size_t i = 0; i < len; ++i) in[i] = (uint8_t)((i * 7 + len) & 31);
+        for (Bech32Variant v : {Bech32Variant::Bech32, Bech32Variant::Bech32m}) {
+            s = bech32_encode("qtc", in, v);
+            if (!bech32_decode(s, hrp, out, variant) || hrp != "qtc" || out != in || variant != v) {
+                std::printf("bech32: %zu words do not round-trip\n", len);
+                return 1;
+            }
+        }
+    }
+
+    // Addresses, one at a time and in a batch
+    std::vector<uint8_t> programs(NADDRESSES * QTC_WITNESS_PROGRAM_BYTES), decoded(programs.size());
+    std::vector<std::string> addresses;
+    AddressStatus status[NADDRESSES];
+    for (uint32_t i = 0; i < NADDRESSES; ++i) program_of(&programs[i * QTC_WITNESS_PROGRAM_BYTES], i);
+    qtc_address_encode_many(addresses, programs.data(), NADDRESSES);
+    for (uint32_t i = 0; i < NADDRESSES; ++i) {
+        const uint8_t* p = &programs[i * QTC_WITNESS_PROGRAM_BYTES];
+        std::vector<uint8_t> words = witness_words(QTC_WITNESS_VERSION, p, QTC_WITNESS_PROGRAM_BYTES);
+        if (addresses[i] != qtc_address(p, QTC_WITNESS_PROGRAM_BYTES) ||
+            addresses[i] != bech32_encode(QTC_ADDRESS_HRP, words, Bech32Variant::Bech32) ||
+            addresses[i].size() != QTC_ADDRESS_CHARS) {
+            std::printf("bech32: address %u differs between encoders\n", i);
+            return 1;
+        }
+    }
+    if (qtc_address_validate_many(decoded.data(), status, addresses.data(), NADDRESSES) != NADDRESSES ||
+        decoded != programs) {
+        std::printf("bech32: addresses do not round-trip\n");
+        return 1;
+    }
+
+    std::printf("bech32 round trip: ok\n");
+    return 0;
+}
+
+// Every single-character change breaks the checksum
+static int test_invalid_checksum() {
+    uint8_t program[QTC_WITNESS_PROGRAM_BYTES];
+    static const char charset[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+
+    program_of(program, 1);
+    std::string address = qtc_address(program, sizeof(program));
+    for (size_t i = sizeof(QTC_ADDRESS_HRP); i < address.size(); ++i) {
+        std::string bad = address;
+        bad[i] = charset[(std::strchr(charset, bad[i]) - charset + 1) % 32];
+        if (qtc_address_decode(program, bad) != AddressStatus::BadEncoding) {
+            std::printf("bech32: changed character %zu not detected\n", i);
+            return 1;
+        }
+    }
+    std::string swapped = address;
+    std::swap(swapped[10], swapped[11]);
+    if (swapped != address && qtc_address_decode(program, swapped) != AddressStatus::BadEncoding) {
+        std::printf("bech32: swapped characters not detected\n");
+        return 1;
+    }
+
+    std::printf("bech32 invalid checksum: ok\n");
+    return 0;
+}
+
+// Well-formed bech32 that is not a QTC address
+static int test_wrong_address() {
+    uint8_t program[QTC_WITNESS_PROGRAM_BYTES], out[QTC_WITNESS_PROGRAM_BYTES];
+    std::vector<uint8_t> words;
+
+    program_of(program, 2);
+    words = witness_words(QTC_WITNESS_VERSION, program, sizeof(program));
+    struct {
+        std::string address;
+        AddressStatus status;
+    } cases[] = {
+        {bech32_encode("bc", words, Bech32Variant::Bech32), AddressStatus::WrongHrp},
+        {bech32_encode("qtct", words, Bech32Variant::Bech32), AddressStatus::WrongHrp},
+        {bech32_encode(QTC_ADDRESS_HRP, words, Bech32Variant::Bech32m), AddressStatus::WrongVariant},
+        {bech32_encode(QTC_ADDRESS_HRP, witness_words(1, program, sizeof(program)), Bech32Variant::Bech32),
+         AddressStatus::WrongWitnessVersion},
+        {bech32_encode(QTC_ADDRESS_HRP, witness_words(QTC_WITNESS_VERSION, program, 19), Bech32Variant::Bech32),
+         AddressStatus::BadProgram},
+        {qtc_address(program, 32), AddressStatus::BadProgram},
+    };
+    for (auto& c : cases) {
+        AddressStatus s = qtc_address_decode(out, c.address);
+        if (s != c.status) {
+            std::printf("bech32: %s is \"%s\", expected \"%s\"\n", c.address.c_str(),
+                        address_status_string(s), address_status_string(c.status));
+            return 1;
+        }
+    }
+
+    // An upper-case address is the same address
+    std::string upper = qtc_address(program, sizeof(program));
+    for (char& ch : upper) ch = (char)std::toupper((unsigned char)ch);
+    if (qtc_address_decode(out, upper) != AddressStatus::Ok || std::memcmp(out, program, sizeof(out)) != 0) {
+        std::printf("bech32: upper-case address rejected\n");
+        return 1;
+    }
+
+    std::printf("bech32 wrong address: ok\n");
+    return 0;
+}
+
+int main() {
+    int r = 0;
+
+    r |= test_vectors();
+    r |= test_round_trip();
+    r |= test_invalid_checksum();
+    r |= test_wrong_address();
+    return r;
+}
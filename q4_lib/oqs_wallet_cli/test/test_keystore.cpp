@@ -0,0 +1,169 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "../src/keystore.h"
+
+#define NRECORDS 200
+#define PK_BYTES 1952
+#define SK_BYTES 4032
+
+static const char* kFile = "test/keystore.tmp";
+
+static HdPath path_of(uint32_t i) { return HdPath{44, 0, i & 1, i}; }
+
+static void key_of(uint8_t* out, size_t len, uint32_t i, uint8_t tag) {
+    for (size_t j = 0; j < len; ++j) out[j] = (uint8_t)(j * 31 + i * 7 + tag);
+}
+
+static int check_records(const Keystore& ks, uint32_t n) {
+    std::vector<uint8_t> pk(PK_BYTES), sk(SK_BYTES);
+    Keystore::Record rec;
+
+    if (ks.count() != n) {
+        std::printf("keystore: count %llu, expected %u\n", (unsigned long long)ks.count(), n);
+        return 1;
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        key_of(pk.data(), pk.size(), i, 1);
+        key_of(sk.data(), sk.size(), i, 2);
+        if (!ks.get(path_of(i), rec) || rec.pk_len != PK_BYTES || rec.sk_len != SK_BYTES ||
+            std::memcmp(rec.pk, pk.data(), PK_BYTES) != 0 ||
+            std::memcmp(rec.sk, sk.data(), SK_BYTES) != 0 ||
+            std::string(rec.address) != "qtc1addr" + std::to_string(i) ||
+            hd_path_to_string(rec.path) != hd_path_to_string(path_of(i))) {
+            std::printf("keystore: record %u does not round-trip\n", i);
+            return 1;
+        }
+    }
+    if (ks.get(path_of(n), rec)) {
+        std::printf("keystore: found a path that was never stored\n");
+        return 1;
+    }
+    return 0;
+}
+
+// Store, grow the index past its initial capacity, then reopen read-only
+static int test_round_trip() {
+    std::vector<uint8_t> pk(PK_BYTES), sk(SK_BYTES);
+
+    std::remove(kFile);
+    {
+        Keystore ks = Keystore::create(kFile, PK_BYTES, SK_BYTES, 8);
+        for (uint32_t i = 0; i < NRECORDS; ++i) {
+            key_of(pk.data(), pk.size(), i, 1);
+            key_of(sk.data(), sk.size(), i, 2);
+            ks.put(path_of(i), "qtc1addr" + std::to_string(i), pk.data(), pk.size(), sk.data(), sk.size());
+        }
+        try {
+            ks.put(path_of(3), "dup", pk.data(), pk.size(), sk.data(), sk.size());
+            std::printf("keystore: duplicate path accepted\n");
+            return 1;
+        } catch (const std::runtime_error&) {
+        }
+        if (check_records(ks, NRECORDS)) return 1;
+    }
+
+    Keystore ks(kFile, false);
+    if (check_records(ks, NRECORDS)) return 1;
+    if (ks.pk_bytes() != PK_BYTES || ks.sk_bytes() != SK_BYTES) {
+        std::printf("keystore: key sizes lost on reopen\n");
+        return 1;
+    }
+    try {
+        ks.put(path_of(NRECORDS), "x", pk.data(), pk.size(), sk.data(), sk.size());
+        std::printf("keystore: read-only store accepted a put\n");
+        return 1;
+    } catch (const std::runtime_error&) {
+    }
+
+    std::printf("keystore round trip: ok\n");
+    return 0;
+}
+
+static uint64_t load_le(const uint8_t* p, size_t n) {
+    uint64_t v = 0;
+    while (n--) v = v << 8 | p[n];
+    return v;
+}
+
+static void store_le(uint8_t* p, size_t n, uint64_t v) {
+    for (size_t i = 0; i < n; ++i, v >>= 8) p[i] = (uint8_t)v;
+}
+
+static bool read_file(std::vector<uint8_t>& buf) {
+    FILE* f = std::fopen(kFile, "rb");
+    if (!f) return false;
+    std::fseek(f, 0, SEEK_END);
+    buf.resize((size_t)std::ftell(f));
+    std::fseek(f, 0, SEEK_SET);
+    bool ok = std::fread(buf.data(), 1, buf.size(), f) == buf.size();
+    std::fclose(f);
+    return ok;
+}
+
+static bool write_file(const std::vector<uint8_t>& buf) {
+    FILE* f = std::fopen(kFile, "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+// The header is little-endian whatever the host; a full index is reported
+// as corrupt instead of being probed forever
+static int test_disk_format() {
+    std::vector<uint8_t> pk(PK_BYTES), sk(SK_BYTES), buf;
+
+    std::remove(kFile);
+    {
+        Keystore ks = Keystore::create(kFile, PK_BYTES, SK_BYTES, 4);
+        for (uint32_t i = 0; i < 3; ++i)
+            ks.put(path_of(i), "a", pk.data(), pk.size(), sk.data(), sk.size());
+    }
+    if (!read_file(buf) || buf.size() < 4096) {
+        std::printf("keystore: cannot read back the file\n");
+        return 1;
+    }
+    if (load_le(&buf[8], 4) != 1 || load_le(&buf[12], 4) != 4096 || load_le(&buf[16], 4) != PK_BYTES ||
+        load_le(&buf[20], 4) != SK_BYTES || load_le(&buf[48], 8) != 3 || load_le(&buf[56], 8) != buf.size()) {
+        std::printf("keystore: header is not little-endian\n");
+        return 1;
+    }
+
+    // Occupy every index entry with a path that is never looked up
+    uint64_t index = load_le(&buf[32], 8), capacity = load_le(&buf[40], 8);
+    for (uint64_t i = 0; i < capacity; ++i) {
+        uint8_t* e = &buf[index + i * 24];
+        store_le(e, 4, 1000);
+        store_le(e + 4, 4, 1000);
+        store_le(e + 8, 4, 0);
+        store_le(e + 12, 4, (uint32_t)i);
+        store_le(e + 16, 8, 4096);
+    }
+    if (!write_file(buf)) {
+        std::printf("keystore: cannot write the file\n");
+        return 1;
+    }
+
+    Keystore ks(kFile, false);
+    Keystore::Record rec;
+    try {
+        ks.get(path_of(0), rec);
+        std::printf("keystore: full index not detected\n");
+        return 1;
+    } catch (const std::runtime_error&) {
+    }
+
+    std::printf("keystore disk format: ok\n");
+    return 0;
+}
+
+int main() {
+    int r = 0;
+
+    r |= test_round_trip();
+    r |= test_disk_format();
+    std::remove(kFile);
+    return r;
+}
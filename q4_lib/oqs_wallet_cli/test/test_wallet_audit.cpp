@@ -0,0 +1,82 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../src/wallet_audit.h"
+#include "../src/hd_derive.h"
+#include "../src/json_emit.h"
+
+#define NRECORDS 4
+#define PURPOSE 44
+
+static const char* kFile = "test/wallet_audit.tmp";
+
+// An exportWallet()-style wallet; damage, if below NRECORDS, flips one bit of
+// that record's secret key
+static bool write_wallet(const std::vector<uint8_t>& master, uint32_t damage, size_t offset) {
+    std::ofstream out(kFile, std::ios::binary | std::ios::trunc);
+    out << "{\"master\": {\"master_entropy_b64\": \"" << b64_encode(master.data(), master.size())
+        << "\"}, \"addresses\": [";
+    for (uint32_t i = 0; i < NRECORDS; ++i) {
+        HdPath path{PURPOSE, 0, 0, i};
+        uint8_t entropy[64], pk[QTC_MLDSA65_PUBLICKEYBYTES], sk[QTC_MLDSA65_SECRETKEYBYTES];
+        uint8_t program[QTC_WITNESS_PROGRAM_BYTES];
+        hd_child_entropy(entropy, master, path);
+        if (!mldsa65_keypair_from_seed_pct(pk, sk, std::vector<uint8_t>(entropy, entropy + 32), RngMode::NistKat))
+            return false;
+        if (i == damage) sk[offset] ^= 1;
+        witness_program(program, pk, sizeof(pk));
+        out << (i ? ", " : "") << "{\"index\": " << i << ", \"path\": \"" << hd_path_to_string(path)
+            << "\", \"address\": \"" << qtc_address(program, sizeof(program))
+            << "\", \"dilithium_public_b64\": \"" << b64_encode(pk, sizeof(pk))
+            << "\", \"dilithium_private_b64\": \"" << b64_encode(sk, sizeof(sk)) << "\"}";
+    }
+    out << "]}\n";
+    return (bool)out;
+}
+
+// A secret key that differs from the derivation anywhere is reported, not
+// only in rho and tr
+static int test_secret_key() {
+    std::vector<uint8_t> master(64, 0x3c);
+    AuditOptions opt;
+    opt.workers = 2;
+    std::vector<AuditIssue> issues;
+    auto report = [&](const AuditIssue& issue) { issues.push_back(issue); };
+
+    if (!write_wallet(master, NRECORDS, 0)) {
+        std::printf("wallet_audit: cannot write the wallet\n");
+        return 1;
+    }
+    AuditSummary sum = audit_wallet(kFile, opt, report);
+    if (sum.checked != NRECORDS || sum.mismatches != 0 || !issues.empty()) {
+        std::printf("wallet_audit: %llu mismatches in an intact wallet\n", (unsigned long long)sum.mismatches);
+        return 1;
+    }
+
+    // A byte of K, one of t0 and the last one; rho and tr stay as derived
+    for (size_t offset : {(size_t)40, (size_t)2250, (size_t)QTC_MLDSA65_SECRETKEYBYTES - 1}) {
+        issues.clear();
+        if (!write_wallet(master, 2, offset)) {
+            std::printf("wallet_audit: cannot write the wallet\n");
+            return 1;
+        }
+        sum = audit_wallet(kFile, opt, report);
+        if (sum.checked != NRECORDS || sum.mismatches != 1 || issues.size() != 1 || issues[0].record != 2) {
+            std::printf("wallet_audit: secret key byte %zu changed, %llu mismatches\n", offset,
+                        (unsigned long long)sum.mismatches);
+            return 1;
+        }
+    }
+
+    std::printf("wallet_audit secret key: ok\n");
+    return 0;
+}
+
+int main() {
+    int r = 0;
+
+    r |= test_secret_key();
+    std::remove(kFile);
+    return r;
+}
@@ -0,0 +1,213 @@
+#pragma once
+// Header-only C++17 front end over the namespaced pq-crystals backends.
+//
+// qtc::mlkem<K> (K = 2, 3, 4) wraps pqcrystals_kyber{512,768,1024}_<impl>_*
+// and qtc::mldsa<Mode> (Mode = 2, 3, 5) wraps pqcrystals_dilithium{2,3,5}_<impl>_*.
+// The parameter set is a template argument, so every call binds directly to
+// one backend symbol and all key, ciphertext and signature types are
+// std::arrays of constexpr size. Link the matching libpqcrystals_*.so (make
+// shared in the Kyber and Dilithium trees) plus a randombytes()
+// implementation.
+//
+// QTC_PQC_KYBER_IMPL and QTC_PQC_DILITHIUM_IMPL select the backend
+// (ref, the default, or avx2). QTC_PQC_KYBER_API and QTC_PQC_DILITHIUM_API
+// name the matching api.h, whose size macros the sizes below are checked
+// against; they default to the in-tree reference headers.
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#ifndef QTC_PQC_KYBER_IMPL
+#define QTC_PQC_KYBER_IMPL ref
+#endif
+#ifndef QTC_PQC_DILITHIUM_IMPL
+#define QTC_PQC_DILITHIUM_IMPL ref
+#endif
+
+#ifndef QTC_PQC_KYBER_API
+#define QTC_PQC_KYBER_API "../../Kyber C lang/Kyber C/ref/api.h"
+#endif
+#ifndef QTC_PQC_DILITHIUM_API
+#define QTC_PQC_DILITHIUM_API "../../Dilithium C lang/Dilithium C/ref/api.h"
+#endif
+
+// Both api.h use the include guard API_H
+extern "C" {
+#include QTC_PQC_KYBER_API
+#undef API_H
+#include QTC_PQC_DILITHIUM_API
+#undef API_H
+}
+
+#define QTC_PQC_CAT_(a, b, c, d) a##b##_##c##_##d
+#define QTC_PQC_CAT(a, b, c, d) QTC_PQC_CAT_(a, b, c, d)
+#define QTC_PQC_KYBER(bits, fn) QTC_PQC_CAT(pqcrystals_kyber, bits, QTC_PQC_KYBER_IMPL, fn)
+#define QTC_PQC_DILITHIUM(mode, fn) QTC_PQC_CAT(pqcrystals_dilithium, mode, QTC_PQC_DILITHIUM_IMPL, fn)
+
+#define QTC_PQC_DECLARE_KYBER(bits)                                                              \
+    int QTC_PQC_KYBER(bits, keypair_derand)(uint8_t* pk, uint8_t* sk, const uint8_t* coins);     \
+    int QTC_PQC_KYBER(bits, keypair)(uint8_t* pk, uint8_t* sk);                                  \
+    int QTC_PQC_KYBER(bits, enc_derand)(uint8_t* ct, uint8_t* ss, const uint8_t* pk,             \
+                                        const uint8_t* coins);                                   \
+    int QTC_PQC_KYBER(bits, enc)(uint8_t* ct, uint8_t* ss, const uint8_t* pk);                   \
+    int QTC_PQC_KYBER(bits, dec)(uint8_t* ss, const uint8_t* ct, const uint8_t* sk);
+
+#define QTC_PQC_DECLARE_DILITHIUM(mode)                                                          \
+    int QTC_PQC_DILITHIUM(mode, keypair)(uint8_t* pk, uint8_t* sk);                              \
+    int QTC_PQC_DILITHIUM(mode, signature)(uint8_t* sig, size_t* siglen, const uint8_t* m,       \
+                                           size_t mlen, const uint8_t* ctx, size_t ctxlen,       \
+                                           const uint8_t* sk);                                   \
+    int QTC_PQC_DILITHIUM(mode, verify)(const uint8_t* sig, size_t siglen, const uint8_t* m,     \
+                                        size_t mlen, const uint8_t* ctx, size_t ctxlen,          \
+                                        const uint8_t* pk);
+
+extern "C" {
+QTC_PQC_DECLARE_KYBER(512)
+QTC_PQC_DECLARE_KYBER(768)
+QTC_PQC_DECLARE_KYBER(1024)
+QTC_PQC_DECLARE_DILITHIUM(2)
+QTC_PQC_DECLARE_DILITHIUM(3)
+QTC_PQC_DECLARE_DILITHIUM(5)
+}
+
+namespace qtc {
+namespace detail {
+
+template <int K> struct mlkem_backend;
+template <int Mode> struct mldsa_backend;
+
+#define QTC_PQC_KYBER_BACKEND(k, bits, pkb, skb, ctb)                                            \
+    template <> struct mlkem_backend<k> {                                                        \
+        static constexpr std::string_view name = "ML-KEM-" #bits;                                \
+        static constexpr std::size_t public_key_bytes = pkb;                                     \
+        static constexpr std::size_t secret_key_bytes = skb;                                     \
+        static constexpr std::size_t ciphertext_bytes = ctb;                                     \
+        static_assert(pkb == QTC_PQC_KYBER(bits, PUBLICKEYBYTES) &&                              \
+                      skb == QTC_PQC_KYBER(bits, SECRETKEYBYTES) &&                              \
+                      ctb == QTC_PQC_KYBER(bits, CIPHERTEXTBYTES) &&                             \
+                      QTC_PQC_KYBER(bits, BYTES) == 32 &&                                        \
+                      QTC_PQC_KYBER(bits, KEYPAIRCOINBYTES) == 64 &&                             \
+                      QTC_PQC_KYBER(bits, ENCCOINBYTES) == 32,                                   \
+                      "ML-KEM-" #bits " sizes differ from the backend api.h");                   \
+        static int keypair_derand(uint8_t* pk, uint8_t* sk, const uint8_t* c)                    \
+            { return QTC_PQC_KYBER(bits, keypair_derand)(pk, sk, c); }                           \
+        static int keypair(uint8_t* pk, uint8_t* sk)                                             \
+            { return QTC_PQC_KYBER(bits, keypair)(pk, sk); }                                     \
+        static int enc_derand(uint8_t* ct, uint8_t* ss, const uint8_t* pk, const uint8_t* c)     \
+            { return QTC_PQC_KYBER(bits, enc_derand)(ct, ss, pk, c); }                           \
+        static int enc(uint8_t* ct, uint8_t* ss, const uint8_t* pk)                              \
+            { return QTC_PQC_KYBER(bits, enc)(ct, ss, pk); }                                     \
+        static int dec(uint8_t* ss, const uint8_t* ct, const uint8_t* sk)                        \
+            { return QTC_PQC_KYBER(bits, dec)(ss, ct, sk); }                                     \
+    };
+
+QTC_PQC_KYBER_BACKEND(2, 512, 800, 1632, 768)
+QTC_PQC_KYBER_BACKEND(3, 768, 1184, 2400, 1088)
+QTC_PQC_KYBER_BACKEND(4, 1024, 1568, 3168, 1568)
+
+#define QTC_PQC_DILITHIUM_BACKEND(mode, level, pkb, skb, sigb)                                   \
+    template <> struct mldsa_backend<mode> {                                                     \
+        static constexpr std::string_view name = "ML-DSA-" #level;                               \
+        static constexpr std::size_t public_key_bytes = pkb;                                     \
+        static constexpr std::size_t secret_key_bytes = skb;                                     \
+        static constexpr std::size_t signature_bytes = sigb;                                     \
+        static_assert(pkb == QTC_PQC_DILITHIUM(mode, PUBLICKEYBYTES) &&                          \
+                      skb == QTC_PQC_DILITHIUM(mode, SECRETKEYBYTES) &&                          \
+                      sigb == QTC_PQC_DILITHIUM(mode, BYTES),                                    \
+                      "ML-DSA-" #level " sizes differ from the backend api.h");                  \
+        static int keypair(uint8_t* pk, uint8_t* sk)                                             \
+            { return QTC_PQC_DILITHIUM(mode, keypair)(pk, sk); }                                 \
+        static int signature(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen,        \
+                             const uint8_t* ctx, size_t ctxlen, const uint8_t* sk)               \
+            { return QTC_PQC_DILITHIUM(mode, signature)(sig, siglen, m, mlen, ctx, ctxlen, sk); }\
+        static int verify(const uint8_t* sig, size_t siglen, const uint8_t* m, size_t mlen,      \
+                          const uint8_t* ctx, size_t ctxlen, const uint8_t* pk)                  \
+            { return QTC_PQC_DILITHIUM(mode, verify)(sig, siglen, m, mlen, ctx, ctxlen, pk); }   \
+    };
+
+QTC_PQC_DILITHIUM_BACKEND(2, 44, 1312, 2560, 2420)
+QTC_PQC_DILITHIUM_BACKEND(3, 65, 1952, 4032, 3309)
+QTC_PQC_DILITHIUM_BACKEND(5, 87, 2592, 4896, 4627)
+
+} // namespace detail
+
+// ML-KEM with module rank K; the backends cannot fail, so nothing returns status
+template <int K>
+struct mlkem {
+    using backend = detail::mlkem_backend<K>;
+
+    static constexpr std::string_view name = backend::name;
+    static constexpr std::size_t public_key_bytes = backend::public_key_bytes;
+    static constexpr std::size_t secret_key_bytes = backend::secret_key_bytes;
+    static constexpr std::size_t ciphertext_bytes = backend::ciphertext_bytes;
+    static constexpr std::size_t shared_secret_bytes = 32;
+    static constexpr std::size_t keypair_coin_bytes = 64;
+    static constexpr std::size_t enc_coin_bytes = 32;
+
+    using public_key = std::array<uint8_t, public_key_bytes>;
+    using secret_key = std::array<uint8_t, secret_key_bytes>;
+    using ciphertext = std::array<uint8_t, ciphertext_bytes>;
+    using shared_secret = std::array<uint8_t, shared_secret_bytes>;
+    using keypair_coins = std::array<uint8_t, keypair_coin_bytes>;
+    using enc_coins = std::array<uint8_t, enc_coin_bytes>;
+
+    static void keypair(public_key& pk, secret_key& sk) {
+        backend::keypair(pk.data(), sk.data());
+    }
+    static void keypair_derand(public_key& pk, secret_key& sk, const keypair_coins& coins) {
+        backend::keypair_derand(pk.data(), sk.data(), coins.data());
+    }
+    static void encaps(ciphertext& ct, shared_secret& ss, const public_key& pk) {
+        backend::enc(ct.data(), ss.data(), pk.data());
+    }
+    static void encaps_derand(ciphertext& ct, shared_secret& ss, const public_key& pk,
+                              const enc_coins& coins) {
+        backend::enc_derand(ct.data(), ss.data(), pk.data(), coins.data());
+    }
+    // Invalid ciphertexts yield a pseudorandom secret (implicit rejection)
+    static void decaps(shared_secret& ss, const ciphertext& ct, const secret_key& sk) {
+        backend::dec(ss.data(), ct.data(), sk.data());
+    }
+};
+
+// ML-DSA with Dilithium mode 2, 3 or 5
+template <int Mode>
+struct mldsa {
+    using backend = detail::mldsa_backend<Mode>;
+
+    static constexpr std::string_view name = backend::name;
+    static constexpr std::size_t public_key_bytes = backend::public_key_bytes;
+    static constexpr std::size_t secret_key_bytes = backend::secret_key_bytes;
+    static constexpr std::size_t signature_bytes = backend::signature_bytes;
+    static constexpr std::size_t max_context_bytes = 255;
+
+    using public_key = std::array<uint8_t, public_key_bytes>;
+    using secret_key = std::array<uint8_t, secret_key_bytes>;
+    using signature = std::array<uint8_t, signature_bytes>;
+
+    static void keypair(public_key& pk, secret_key& sk) {
+        backend::keypair(pk.data(), sk.data());
+    }
+    // Returns false only if the context is longer than max_context_bytes
+    [[nodiscard]] static bool sign(signature& sig, const uint8_t* m, std::size_t mlen,
+                                   const secret_key& sk,
+                                   const uint8_t* ctx = nullptr, std::size_t ctxlen = 0) {
+        std::size_t siglen;
+        return backend::signature(sig.data(), &siglen, m, mlen, ctx, ctxlen, sk.data()) == 0;
+    }
+    [[nodiscard]] static bool verify(const signature& sig, const uint8_t* m, std::size_t mlen,
+                                     const public_key& pk,
+                                     const uint8_t* ctx = nullptr, std::size_t ctxlen = 0) {
+        return backend::verify(sig.data(), sig.size(), m, mlen, ctx, ctxlen, pk.data()) == 0;
+    }
+};
+
+using mlkem512 = mlkem<2>;
+using mlkem768 = mlkem<3>;
+using mlkem1024 = mlkem<4>;
+using mldsa44 = mldsa<2>;
+using mldsa65 = mldsa<3>;
+using mldsa87 = mldsa<5>;
+
+} // namespace qtc
@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <cstring>
+#include "../qtc_pqc.hpp"
+
+extern "C" void randombytes(uint8_t* out, size_t outlen);
+
+#define NTESTS 100
+
+static_assert(qtc::mlkem1024::public_key_bytes == 1568, "ML-KEM-1024 public key size");
+static_assert(sizeof(qtc::mlkem768::ciphertext) == 1088, "ML-KEM-768 ciphertext size");
+static_assert(qtc::mldsa65::signature_bytes == 3309, "ML-DSA-65 signature size");
+static_assert(qtc::mldsa87::name == "ML-DSA-87", "ML-DSA-87 name");
+
+template <int K>
+static int test_mlkem() {
+    using kem = qtc::mlkem<K>;
+    typename kem::public_key pk, pk2;
+    typename kem::secret_key sk, sk2;
+    typename kem::ciphertext ct, ct2;
+    typename kem::shared_secret ss1, ss2;
+    typename kem::keypair_coins kc;
+    typename kem::enc_coins ec;
+
+    for (int i = 0; i < NTESTS; ++i) {
+        kem::keypair(pk, sk);
+        kem::encaps(ct, ss1, pk);
+        kem::decaps(ss2, ct, sk);
+        if (ss1 != ss2) {
+            std::printf("%s: shared secrets differ\n", kem::name.data());
+            return 1;
+        }
+
+        // Derandomized calls are reproducible
+        randombytes(kc.data(), kc.size());
+        randombytes(ec.data(), ec.size());
+        kem::keypair_derand(pk, sk, kc);
+        kem::keypair_derand(pk2, sk2, kc);
+        kem::encaps_derand(ct, ss1, pk, ec);
+        kem::encaps_derand(ct2, ss2, pk2, ec);
+        if (pk != pk2 || sk != sk2 || ct != ct2 || ss1 != ss2) {
+            std::printf("%s: derandomized API is not deterministic\n", kem::name.data());
+            return 1;
+        }
+
+        ct[i % ct.size()] ^= 1;
+        kem::decaps(ss2, ct, sk);
+        if (ss1 == ss2) {
+            std::printf("%s: modified ciphertext accepted\n", kem::name.data());
+            return 1;
+        }
+    }
+
+    std::printf("%s: ok\n", kem::name.data());
+    return 0;
+}
+
+template <int Mode>
+static int test_mldsa() {
+    using dsa = qtc::mldsa<Mode>;
+    typename dsa::public_key pk;
+    typename dsa::secret_key sk;
+    typename dsa::signature sig;
+    uint8_t m[59], ctx[256] = {0};
+
+    for (int i = 0; i < NTESTS; ++i) {
+        randombytes(m, sizeof(m));
+        dsa::keypair(pk, sk);
+        if (!dsa::sign(sig, m, sizeof(m), sk) || !dsa::verify(sig, m, sizeof(m), pk)) {
+            std::printf("%s: signature rejected\n", dsa::name.data());
+            return 1;
+        }
+        if (dsa::verify(sig, m, sizeof(m), pk, ctx, 1)) {
+            std::printf("%s: signature accepted under another context\n", dsa::name.data());
+            return 1;
+        }
+        if (!dsa::sign(sig, m, sizeof(m), sk, ctx, 255) || dsa::sign(sig, m, sizeof(m), sk, ctx, 256)) {
+            std::printf("%s: context length not checked\n", dsa::name.data());
+            return 1;
+        }
+        sig[i % sig.size()] ^= 1;
+        if (dsa::verify(sig, m, sizeof(m), pk, ctx, 255)) {
+            std::printf("%s: modified signature accepted\n", dsa::name.data());
+            return 1;
+        }
+    }
+
+    std::printf("%s: ok\n", dsa::name.data());
+    return 0;
+}
+
+int main() {
+    int r = 0;
+
+    r |= test_mlkem<2>();
+    r |= test_mlkem<3>();
+    r |= test_mlkem<4>();
+    r |= test_mldsa<2>();
+    r |= test_mldsa<3>();
+    r |= test_mldsa<5>();
+    return r;
+}
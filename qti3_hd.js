@@ -118,6 +118,17 @@ class QTCHDNode {
     return keyPair;
   }
 
+  // Watch-only: public key and address without materializing the secret key
+  deriveAddressOnly() {
+    const dilithiumSeed = this.masterEntropy.slice(0, 32);
+    const seed_hex = Buffer.from(dilithiumSeed).toString('hex');
+    const res = spawnSync(ensureCliBuilt(), ['derive_address_only', seed_hex], { encoding: 'utf8' });
+    if (res.status !== 0) throw new Error(res.stderr || 'oqs_wallet_cli failed');
+    const out = JSON.parse(res.stdout);
+    this.publicKey = Buffer.from(out.dilithium_public_b64, 'base64');
+    return out.address;
+  }
+
   // Generate address from Dilithium public key
   generateAddress() {
     if (!this.publicKey) {
@@ -213,7 +224,8 @@ class QTCPQHDWallet {
   }
 
   // Generate multiple addresses from master
-  async generateAddresses(count = 5, account = 0, change = 0) {
+  // watchOnly skips secret keys entirely; entries then carry no dilithium_private_b64
+  async generateAddresses(count = 5, account = 0, change = 0, watchOnly = false) {
     if (!this.masterNode) {
       throw new Error("Must generate master wallet first");
     }
@@ -226,10 +238,23 @@ class QTCPQHDWallet {
     for (let i = 0; i < count; i++) {
       // Derive child node
       const childNode = this.masterNode.deriveChild(i);
+      const path = childNode.path.toString();
+
+      if (watchOnly) {
+        const address = childNode.deriveAddressOnly();
+        addresses.push({
+          index: i,
+          path: path,
+          address: address,
+          dilithium_public_b64: Buffer.from(childNode.publicKey).toString("base64")
+        });
+        console.error(`[✓] Address ${i}: ${address} (${path})`);
+        continue;
+      }
+
       await childNode.generateKeyPair();
       
       const address = childNode.generateAddress();
-      const path = childNode.path.toString();
       
       addresses.push({
         index: i,
@@ -275,7 +300,12 @@ class QTCPQHDWallet {
 
 // --- CLI Interface
 async function main() {
-  const args = process.argv.slice(2);
+  const watchOnly = process.argv.includes("--watch-only");
+  // --stream / --stream-jsonl write addresses from oqs_wallet_cli as they are derived
+  const stream = process.argv.includes("--stream") ? "json" : process.argv.includes("--stream-jsonl") ? "jsonl" : null;
+  // --pct signs and verifies with every streamed key before it is written
+  const pct = process.argv.includes("--pct");
+  const args = process.argv.slice(2).filter(a => !["--watch-only", "--stream", "--stream-jsonl", "--pct"].includes(a));
   const count = parseInt(args[0]) || 5;
   const account = parseInt(args[1]) || 0;
   const change = parseInt(args[2]) || 0;
@@ -289,8 +319,22 @@ async function main() {
     // Generate master wallet
     const masterData = await wallet.generateMaster();
     
+    if (stream) {
+      const filename = stream === "jsonl" ? "qti3_pqhd_hd_wallet.jsonl" : "qti3_pqhd_hd_wallet.json";
+      const master = wallet.exportWallet([]).master;
+      const cliArgs = ["export_wallet", master.master_entropy_b64, filename, String(count), "--format", stream, "--master", "-"];
+      if (watchOnly) cliArgs.push("--watch-only");
+      if (pct) cliArgs.push("--pct");
+      const res = spawnSync(ensureCliBuilt(), cliArgs, { input: JSON.stringify(master), stdio: ["pipe", "inherit", "inherit"] });
+      if (res.status !== 0) throw new Error("oqs_wallet_cli export_wallet failed");
+      console.error(`\n[SUCCESS] PQ-HD HD wallet streamed to '${filename}'`);
+      return;
+    }
+
+    if (pct) throw new Error("--pct needs --stream or --stream-jsonl");
+
     // Generate addresses
-    const addresses = await wallet.generateAddresses(count, account, change);
+    const addresses = await wallet.generateAddresses(count, account, change, watchOnly);
     
     // Export complete wallet
     const walletData = wallet.exportWallet(addresses);